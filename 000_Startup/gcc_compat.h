@@ -0,0 +1,29 @@
+/***************************************************************
+ * FILE NAME : gcc_compat.h
+ *
+ * DESCRIPTION :
+ * Keil's compiler provides __enable_irq(), __disable_irq() and
+ * __WFI() as built-in intrinsics, so the demos call them without
+ * including anything. The GCC build force-includes this file
+ * (-include) to provide the same names.
+ ***************************************************************/
+
+#ifndef GCC_COMPAT_H
+#define GCC_COMPAT_H
+
+static inline void __enable_irq(void)
+{
+    __asm volatile("cpsie i" ::: "memory");
+}
+
+static inline void __disable_irq(void)
+{
+    __asm volatile("cpsid i" ::: "memory");
+}
+
+static inline void __WFI(void)
+{
+    __asm volatile("wfi");
+}
+
+#endif
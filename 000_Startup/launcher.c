@@ -0,0 +1,142 @@
+/***************************************************************
+ * FILE NAME : launcher.c
+ * MCU       : TM4C123GH6PM (Tiva C LaunchPad)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * main() of the combined firmware ("make combined"). Every demo
+ * is linked into one image with its main() renamed to
+ * demo_<id>_main() and its interrupt handlers renamed to
+ * demo_<id>_<name>_Handler() (see the Makefile).
+ *
+ * At reset the launcher prints a menu on UART0 (ICDI virtual
+ * COM port, 115200 8N1). Type the number of a demo and press
+ * Enter; the launcher then:
+ *
+ *   1. copies the flash vector table into SRAM,
+ *   2. replaces the entries for that demo's handlers,
+ *   3. points VTOR (0xE000ED08) at the SRAM copy,
+ *   4. calls the demo's main() (which never returns).
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "launcher.h"
+
+extern void (*const vector_table[])(void);
+
+/* VTOR needs the table aligned to the next power of two above its size */
+__attribute__((aligned(1024)))
+static void (*ram_vectors[VEC_COUNT])(void);
+
+void UART0Tx(char c);
+char UART0Rx(void);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(unsigned int n);
+void start_demo(const struct demo *d);
+
+int main(void)
+{
+    unsigned int i, choice, digits;
+    char c;
+
+    /* UART0 on PA0/PA1, 115200 8N1 (IBRD = 8, FBRD = 44 at 16 MHz) */
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x60;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    while (1)
+    {
+        UART0_SendString("\r\nTM4C123GH6PM demos\r\n");
+        for (i = 0; i < demo_count; i++)
+        {
+            UART0_SendString("  ");
+            UART0_SendNumber(i);
+            UART0_SendString(": ");
+            UART0_SendString(demo_list[i].id);
+            UART0_SendString("\r\n");
+        }
+        UART0_SendString("select> ");
+
+        // CR, LF or CR LF ends the number; an end of line without
+        // digits (the LF of a CR LF) is ignored
+        choice = 0;
+        digits = 0;
+        while (!(((c = UART0Rx()) == '\r' || c == '\n') && digits))
+        {
+            if (c >= '0' && c <= '9')
+            {
+                choice = choice * 10 + (c - '0');
+                digits++;
+                UART0Tx(c);
+            }
+        }
+        UART0_SendString("\r\n");
+
+        if (choice < demo_count)
+            start_demo(&demo_list[choice]);
+    }
+}
+
+void start_demo(const struct demo *d)
+{
+    unsigned int i;
+
+    for (i = 0; i < VEC_COUNT; i++)
+        ram_vectors[i] = vector_table[i];
+
+    for (i = 0; i < d->isr_count; i++)
+        ram_vectors[d->isr[i].vector] = d->isr[i].handler;
+
+    __disable_irq();
+    *((volatile uint32_t *)0xE000ED08) = (uint32_t)ram_vectors; // VTOR
+    __asm volatile("dsb\n isb");
+    __enable_irq();
+
+    d->main();
+}
+
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ;
+    UART0_DR_R = c;
+}
+
+char UART0Rx(void)
+{
+    while ((UART0_FR_R & 0x10) != 0)
+        ;
+    return UART0_DR_R;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+void UART0_SendNumber(unsigned int n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,43 @@
+/***************************************************************
+ * FILE NAME : launcher.h
+ *
+ * DESCRIPTION :
+ * Interface between the combined-firmware launcher (launcher.c)
+ * and the demo table that the Makefile generates (demos.c).
+ ***************************************************************/
+
+#ifndef LAUNCHER_H
+#define LAUNCHER_H
+
+#include <stdint.h>
+
+/* Vector table index of every handler, e.g. VEC_UART0_Handler = 21 */
+enum
+{
+    VEC_FIRST_ENTRY = 1, // Reset
+#define VECTOR(name) VEC_##name,
+#define RESERVED(name) VEC_##name,
+#include "vectors.def"
+#undef VECTOR
+#undef RESERVED
+    VEC_COUNT
+};
+
+struct demo_isr
+{
+    uint16_t vector;        // VEC_xxx index
+    void (*handler)(void);  // demo's own handler
+};
+
+struct demo
+{
+    const char *id;                // e.g. "011_02"
+    int (*main)(void);             // demo's main(), renamed
+    const struct demo_isr *isr;    // handlers to install
+    unsigned int isr_count;
+};
+
+extern const struct demo demo_list[];
+extern const unsigned int demo_count;
+
+#endif
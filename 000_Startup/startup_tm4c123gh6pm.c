@@ -0,0 +1,93 @@
+/***************************************************************
+ * FILE NAME : startup_tm4c123gh6pm.c
+ * MCU       : TM4C123GH6PM (Tiva C LaunchPad)
+ * TOOLCHAIN : arm-none-eabi-gcc
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Startup code used by the GCC build (see the top-level
+ * Makefile). Keil projects keep using the device pack's
+ * startup_TM4C123.s; this file provides the same things:
+ *
+ *   - The vector table (155 entries) in section .isr_vector.
+ *     Every handler is a weak alias of Default_Handler, so a
+ *     demo only has to define e.g. "void UART0_Handler(void)".
+ *   - Reset_Handler: copy .data (and any .ramfunc code, see
+ *     018_RAM_Functions_and_VTOR) from flash, clear .bss, enable
+ *     the FPU (the demos are built for hard-float), run C++
+ *     static constructors, then call main().
+ *
+ * The system clock is left at the 16 MHz PIOSC, which is what
+ * every delay loop and baud rate in the demos assumes.
+ ***************************************************************/
+
+#include <stdint.h>
+
+/* Symbols from tm4c123gh6pm.ld */
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss, _estack;
+
+int main(void);
+void __libc_init_array(void);
+
+void Reset_Handler(void);
+void Default_Handler(void);
+
+/* Weak handler declarations for every vector */
+#define VECTOR(name) void name(void) __attribute__((weak, alias("Default_Handler")));
+#define RESERVED(name)
+#include "vectors.def"
+#undef VECTOR
+#undef RESERVED
+
+/***********************************************************
+ * VECTOR TABLE (placed at address 0x00000000)
+ ***********************************************************/
+__attribute__((section(".isr_vector"), used))
+void (*const vector_table[])(void) = {
+    (void (*)(void))&_estack, // 0: initial stack pointer
+    Reset_Handler,            // 1: reset
+#define VECTOR(name) name,
+#define RESERVED(name) 0,
+#include "vectors.def"
+#undef VECTOR
+#undef RESERVED
+};
+
+/***********************************************************
+ * Reset_Handler()
+ ***********************************************************/
+void Reset_Handler(void)
+{
+    uint32_t *src = &_sidata;
+    uint32_t *dst;
+
+    // Copy initialised data and .ramfunc code from flash to SRAM
+    for (dst = &_sdata; dst < &_edata;)
+        *dst++ = *src++;
+
+    // Clear zero-initialised data
+    for (dst = &_sbss; dst < &_ebss;)
+        *dst++ = 0;
+
+    // CPACR: full access to CP10 and CP11 (FPU)
+    *((volatile uint32_t *)0xE000ED88) |= (0xF << 20);
+    __asm volatile("dsb\n isb");
+
+    __libc_init_array(); // C++ constructors (empty for C demos)
+
+    main();
+
+    while (1)
+        ;
+}
+
+/***********************************************************
+ * Default_Handler() – unexpected interrupt or fault.
+ * Stops here so the debugger shows which vector fired
+ * (read VECTACTIVE in NVIC_INT_CTRL, 0xE000ED04).
+ ***********************************************************/
+void Default_Handler(void)
+{
+    while (1)
+        ;
+}
@@ -0,0 +1,426 @@
+/***************************************************************
+ * PROJECT NAME : uDMA GPIO Pattern Generator
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - GPIO Port B on the AHB aperture, PB0-PB7 outputs
+ *      - Timer0A (pattern clock, one uDMA request per tick)
+ *      - uDMA channel 18 (Timer0A, peripheral scatter-gather)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 001 and 007_01 change pins from a loop: every write waits for
+ * the code around it, so edges jitter by whatever the CPU does
+ * in between. Here the CPU only describes the waveform; Timer0A
+ * paces the uDMA controller, which copies one byte per tick
+ * from a pattern table into a masked GPIO DATA address.
+ *
+ * Masked writes:
+ *   GPIO_PORTB_AHB_DATA_BITS_R[mask] only changes the pins set
+ *   in mask, so a segment on PB0-PB3 (stepper phases) leaves
+ *   PB4-PB7 alone and vice versa, without read-modify-write.
+ *
+ * Segments, chaining and looping (peripheral scatter-gather):
+ *   A pattern is a list of segments {data, len, mask}. Each one
+ *   becomes a uDMA task (a control structure image) in
+ *   pg_tasks[]. The primary structure copies one task at a time
+ *   into the alternate structure, which then moves the bytes;
+ *   the next task follows without the CPU.
+ *   - Chain: the last task is a basic transfer; its completion
+ *     interrupt (Timer0A vector) stops the timer. Timer0A's
+ *     timeout interrupt stays masked, and the uDMA done has no
+ *     mask bit on the TM4C123, so it is the only one taken.
+ *   - Loop: one more task copies pg_reload back into the
+ *     primary structure, which restarts the list forever.
+ *
+ * Timing:
+ *   tick = (TAILR + 1) / 80 MHz. Each byte is written on its
+ *   tick, independent of the CPU. Switching tasks may take a
+ *   tick of its own (the pins hold their value), so keep
+ *   periodic patterns inside one segment (up to 1024 bytes)
+ *   and use segments for the parts that change.
+ *   The uDMA needs about 10 - 16 clocks per item here, which
+ *   limits the rate to 5 MHz (TAILR >= 15).
+ *
+ * Patterns in this demo:
+ *   l         stepper, half steps on PB0-PB3, looping
+ *   o         one-shot test stimulus on PB4-PB7: 16-tick
+ *             preamble, then a 4-bit counter 0-15 x 4
+ *   r <hz>    pattern clock (default 1 kHz, max 5000000)
+ *   s         stop
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define PG_MAX_TASKS 8
+#define PG_MAX_LEN 1024   // items per uDMA transfer
+#define PG_MIN_TAILR 15   // 5 MHz
+#define DMA_CH_TIMER0A 18
+
+typedef struct
+{
+    const uint8_t *data;
+    uint16_t len;  // 1 - PG_MAX_LEN
+    uint8_t mask;  // pins driven by this segment
+} pg_segment_t;
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+dma_entry_t pg_tasks[PG_MAX_TASKS + 1]; // + loop task
+dma_entry_t pg_reload;                 // primary structure image
+volatile uint8_t pg_done;
+uint32_t pg_tailr = SYSCLK / 1000 - 1;
+
+/***********************************************************
+ * PATTERNS
+ ***********************************************************/
+const uint8_t half_steps[8] = {0x01, 0x03, 0x02, 0x06, 0x04, 0x0C, 0x08, 0x09};
+uint8_t stepper[256];          // half_steps x 32
+uint8_t preamble[16];          // 1010... on PB4-PB7
+uint8_t counter[64];           // 0 - 15, four times
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void pg_init(void);
+uint32_t pg_build(const pg_segment_t *seg, uint32_t n, int loop);
+void pg_start(void);
+void pg_stop(void);
+void pg_rate(uint32_t hz);
+void command(char *line);
+uint32_t parse_number(char **p);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    char line[32];
+    uint32_t len = 0, i;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz system clock, enable clocks
+     ***********************************************************/
+    PLL_Init80MHz();
+    SYSCTL_RCGCGPIO_R |= 0x03; // Ports A, B
+    SYSCTL_RCGCTIMER_R |= 0x01;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x03) != 0x03)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 80 MHz (IBRD 43, FBRD 26)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: Pattern tables, PB0-PB7, timer and uDMA
+     ***********************************************************/
+    for (i = 0; i < sizeof(stepper); i++)
+        stepper[i] = half_steps[i & 7];
+    for (i = 0; i < sizeof(preamble); i++)
+        preamble[i] = (i & 1) ? 0x00 : 0xA0;
+    for (i = 0; i < sizeof(counter); i++)
+        counter[i] = (uint8_t)((i & 0x0F) << 4);
+
+    pg_init();
+    UART0_SendString("\r\nPattern generator: l, o, r <hz>, s\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – commands only, the pins need no CPU
+     ***********************************************************/
+    while (1)
+    {
+        if (pg_done)
+        {
+            pg_done = 0;
+            UART0_SendString("pattern done\r\n");
+        }
+
+        if ((UART0_FR_R & 0x10) != 0) // RX FIFO empty
+            continue;
+
+        c = (char)UART0_DR_R;
+        if (c == '\r' || c == '\n')
+        {
+            line[len] = 0;
+            if (len)
+                command(line);
+            len = 0;
+        }
+        else if (len < sizeof(line) - 1)
+        {
+            line[len++] = c;
+        }
+    }
+}
+
+/***********************************************************
+ * pg_init() – PB0-PB7 outputs on AHB, Timer0A periodic with
+ * uDMA requests, channel 18 assigned to Timer0A
+ ***********************************************************/
+void pg_init(void)
+{
+    SYSCTL_GPIOHBCTL_R |= 0x02; // Port B on the AHB aperture
+    GPIO_PORTB_AHB_DIR_R |= 0xFF;
+    GPIO_PORTB_AHB_DEN_R |= 0xFF;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02; // Periodic
+    TIMER0_TAILR_R = pg_tailr;
+    TIMER0_IMR_R = 0x00;  // No timeout IRQ: ticks go to uDMA
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0x00000F00; // CH18 → Timer0A
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_TIMER0A;
+
+    NVIC_EN0_R = 1 << 19; // IRQ 19 = Timer0A
+    __enable_irq();
+}
+
+/***********************************************************
+ * pg_build() – one task per segment, plus a loop task
+ * Writes the primary structure; returns the number of tasks
+ * (0 if the list does not fit or a segment is not 1 -
+ * PG_MAX_LEN bytes long, which XFERSIZE cannot express).
+ ***********************************************************/
+uint32_t pg_build(const pg_segment_t *seg, uint32_t n, int loop)
+{
+    dma_entry_t *t;
+    uint32_t i, count = n + (loop ? 1 : 0);
+
+    if (n == 0 || n > PG_MAX_TASKS)
+        return 0;
+    for (i = 0; i < n; i++)
+        if (seg[i].len == 0 || seg[i].len > PG_MAX_LEN)
+            return 0;
+
+    for (i = 0; i < n; i++)
+    {
+        t = &pg_tasks[i];
+        t->src_end = (uint32_t)(uintptr_t)&seg[i].data[seg[i].len - 1];
+        t->dst_end = (uint32_t)(uintptr_t)&GPIO_PORTB_AHB_DATA_BITS_R[seg[i].mask];
+        t->ctl = (3u << 30)                   // DSTINC: none
+                 | (0u << 28)                 // DSTSIZE: byte
+                 | (0u << 26)                 // SRCINC: byte
+                 | (0u << 24)                 // SRCSIZE: byte
+                 | (0u << 14)                 // ARBSIZE: 1 per tick
+                 | ((seg[i].len - 1u) << 4)   // XFERSIZE
+                 | 0x7;                       // Alternate peripheral S-G
+        t->unused = 0;
+    }
+
+    // Chain: the last task ends the list with an interrupt
+    if (!loop)
+        pg_tasks[n - 1].ctl = (pg_tasks[n - 1].ctl & ~0x7u) | 0x1;
+
+    // Primary: copy count tasks, 4 words each, into the alternate
+    pg_reload.src_end = (uint32_t)(uintptr_t)&pg_tasks[count - 1].unused;
+    pg_reload.dst_end = (uint32_t)(uintptr_t)&dma_table[DMA_CH_TIMER0A + 32].unused;
+    pg_reload.ctl = (2u << 30)                // DSTINC: word
+                    | (2u << 28)              // DSTSIZE: word
+                    | (2u << 26)              // SRCINC: word
+                    | (2u << 24)              // SRCSIZE: word
+                    | (2u << 14)              // ARBSIZE: 4 (one task)
+                    | ((4 * count - 1) << 4)  // XFERSIZE
+                    | 0x6;                    // Peripheral S-G
+    pg_reload.unused = 0;
+
+    // Loop: restore the primary structure, which restarts the list
+    if (loop)
+    {
+        t = &pg_tasks[n];
+        t->src_end = (uint32_t)(uintptr_t)&pg_reload.unused;
+        t->dst_end = (uint32_t)(uintptr_t)&dma_table[DMA_CH_TIMER0A].unused;
+        t->ctl = (2u << 30) | (2u << 28) | (2u << 26) | (2u << 24)
+                 | (2u << 14)                 // ARBSIZE: 4
+                 | (3u << 4)                  // 4 words
+                 | 0x7;                       // Alternate peripheral S-G
+        t->unused = 0;
+    }
+
+    dma_table[DMA_CH_TIMER0A] = pg_reload;
+    return count;
+}
+
+/*** pg_start() – run the list built by pg_build() ***/
+void pg_start(void)
+{
+    pg_done = 0;
+    UDMA_ALTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_ENASET_R = 1 << DMA_CH_TIMER0A;
+    TIMER0_TAILR_R = pg_tailr;
+    TIMER0_TAV_R = pg_tailr;
+    TIMER0_CTL_R = 0x01;
+}
+
+/*** pg_stop() – timer and channel off, pins keep their level ***/
+void pg_stop(void)
+{
+    TIMER0_CTL_R = 0x00;
+    UDMA_ENACLR_R = 1 << DMA_CH_TIMER0A;
+}
+
+/***********************************************************
+ * pg_rate() – pattern clock in Hz, limited to 5 MHz
+ * hz is clamped before the division: above SYSCLK,
+ * SYSCLK / hz - 1 would wrap to the slowest rate.
+ ***********************************************************/
+void pg_rate(uint32_t hz)
+{
+    if (hz > SYSCLK / (PG_MIN_TAILR + 1))
+        hz = SYSCLK / (PG_MIN_TAILR + 1);
+
+    pg_tailr = hz ? SYSCLK / hz - 1 : 0xFFFFFFFF;
+    TIMER0_TAILR_R = pg_tailr;
+}
+
+/***********************************************************
+ * TIMER0A_Handler() – uDMA done: a chain has ended
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    TIMER0_ICR_R = 0x01; // TATOCINT
+    UDMA_CHIS_R = 1 << DMA_CH_TIMER0A;
+    TIMER0_CTL_R = 0x00;
+    pg_done = 1;
+}
+
+/***********************************************************
+ * command() – l, o, r <hz>, s
+ ***********************************************************/
+void command(char *line)
+{
+    static const pg_segment_t loop_seg[] = {
+        {stepper, sizeof(stepper), 0x0F},
+    };
+    static const pg_segment_t chain_seg[] = {
+        {preamble, sizeof(preamble), 0xF0},
+        {counter, sizeof(counter), 0xF0},
+    };
+    char *p = line + 1;
+
+    switch (line[0])
+    {
+    case 'l':
+        pg_stop();
+        pg_build(loop_seg, 1, 1);
+        pg_start();
+        break;
+
+    case 'o':
+        pg_stop();
+        pg_build(chain_seg, 2, 0);
+        pg_start();
+        break;
+
+    case 'r':
+        pg_rate(parse_number(&p));
+        UART0_SendString("tick ");
+        UART0_SendNumber(pg_tailr + 1);
+        UART0_SendString(" clocks\r\n");
+        break;
+
+    case 's':
+        pg_stop();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*** parse_number() – skip spaces, read decimal digits ***/
+uint32_t parse_number(char **p)
+{
+    uint32_t n = 0;
+
+    while (**p == ' ')
+        (*p)++;
+    while (**p >= '0' && **p <= '9')
+        n = n * 10 + (*(*p)++ - '0');
+
+    return n;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
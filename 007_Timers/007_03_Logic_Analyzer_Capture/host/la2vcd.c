@@ -0,0 +1,170 @@
+/***************************************************************
+ * PROJECT NAME : la2vcd – Logic Analyzer Stream to VCD
+ * TARGET       : Host PC (standard C, any compiler)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Converts a stream saved from 007_03 (e.g. with a terminal's
+ * "log to file" while the demo runs "g" ... "s") into a Value
+ * Change Dump, which GTKWave, PulseView (sigrok) and most other
+ * waveform viewers open directly.
+ *
+ *      cc -O2 -o la2vcd la2vcd.c
+ *      la2vcd capture.bin > capture.vcd
+ *
+ * Stream format (see 007_03 main.c):
+ *      "LOGA", version, channels, sample rate (u32, LE)
+ *      value, run (LEB128)            run > 0: pins held
+ *      value, 0, lost (LEB128)        lost > 0: samples dropped
+ *      value, 0, 0                    end of capture
+ * Text before "LOGA" (the command echo) is skipped. Dropped
+ * samples are shown as 'x' on every channel.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+static FILE *in;
+
+/*** get_byte() – next byte, -1 at end of file ***/
+static int get_byte(void)
+{
+    return fgetc(in);
+}
+
+/*** get_varint() – LEB128, returns 0 and sets *ok = 0 on EOF ***/
+static uint32_t get_varint(int *ok)
+{
+    uint32_t v = 0;
+    int shift = 0, c;
+
+    do
+    {
+        c = get_byte();
+        if (c < 0 || shift > 28)
+        {
+            *ok = 0;
+            return 0;
+        }
+        v |= (uint32_t)(c & 0x7F) << shift;
+        shift += 7;
+    } while (c & 0x80);
+
+    return v;
+}
+
+/*** find_header() – skip to "LOGA", 0 if not found ***/
+static int find_header(void)
+{
+    const char *magic = "LOGA";
+    int i = 0, c;
+
+    while ((c = get_byte()) >= 0)
+    {
+        if (c == magic[i])
+        {
+            if (++i == 4)
+                return 1;
+        }
+        else
+        {
+            i = (c == magic[0]);
+        }
+    }
+    return 0;
+}
+
+/*** emit() – timestamp and the channels that changed ***/
+static void emit(uint64_t t, int value, int prev, int channels)
+{
+    int ch;
+
+    printf("#%llu\n", (unsigned long long)t);
+    for (ch = 0; ch < channels; ch++)
+    {
+        if (value < 0)
+            printf("x%c\n", '!' + ch);
+        else if (prev < 0 || ((value ^ prev) >> ch & 1))
+            printf("%d%c\n", value >> ch & 1, '!' + ch);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rate = 0, run, lost;
+    uint64_t sample = 0, ns;
+    int version, channels, ch, i, value, prev = -1, ok = 1;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: la2vcd <capture.bin> > capture.vcd\n");
+        return 2;
+    }
+    in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    /* Header */
+    if (!find_header())
+    {
+        fprintf(stderr, "la2vcd: no LOGA header\n");
+        return 1;
+    }
+    version = get_byte();
+    channels = get_byte();
+    for (i = 0; i < 4; i++)
+        rate |= (uint32_t)(get_byte() & 0xFF) << (8 * i);
+    if (version != 1 || channels < 1 || channels > 8 || rate == 0)
+    {
+        fprintf(stderr, "la2vcd: bad header\n");
+        return 1;
+    }
+
+    /* VCD header: one 1-bit wire per pin, 1 ns timescale */
+    printf("$comment 007_03 logic analyzer, %lu Hz $end\n", (unsigned long)rate);
+    printf("$timescale 1ns $end\n$scope module la $end\n");
+    for (ch = 0; ch < channels; ch++)
+        printf("$var wire 1 %c PB%d $end\n", '!' + ch, ch);
+    printf("$upscope $end\n$enddefinitions $end\n");
+
+    /* Records */
+    while ((value = get_byte()) >= 0)
+    {
+        run = get_varint(&ok);
+        if (!ok)
+            break;
+
+        ns = sample * 1000000000u / rate;
+        if (run)
+        {
+            if (value != prev)
+                emit(ns, value, prev, channels);
+            prev = value;
+            sample += run;
+            continue;
+        }
+
+        lost = get_varint(&ok);
+        if (!ok || lost == 0)
+            break; // End of capture
+        emit(ns, -1, prev, channels);
+        fprintf(stderr, "la2vcd: %lu samples lost at %llu ns\n",
+                (unsigned long)lost, (unsigned long long)ns);
+        prev = -1;
+        sample += lost;
+    }
+
+    printf("#%llu\n", (unsigned long long)(sample * 1000000000u / rate));
+    fprintf(stderr, "la2vcd: %llu samples at %lu Hz%s\n",
+            (unsigned long long)sample, (unsigned long)rate,
+            ok ? "" : " (stream truncated)");
+    fclose(in);
+    return 0;
+}
@@ -0,0 +1,591 @@
+/***************************************************************
+ * PROJECT NAME : 8-Channel Logic Analyzer (RLE Streaming)
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - GPIO Port B on the AHB aperture, PB0-PB7 inputs
+ *      - Timer0A (sample clock, one uDMA request per sample)
+ *      - uDMA channel 18 (Timer0A, GPIO → RAM, ping-pong)
+ *      - uDMA channel 9 (UART0 TX stream)
+ *      - Timer1 (free-running, CPU load measurement)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 921600 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Turns a second LaunchPad into a logic analyzer, e.g. for the
+ * 74HC595 / LCD bus driven by shift_out1() in 004_LCD: connect
+ * its data, clock and latch lines (and GND) to PB0-PB7.
+ *
+ * Sampling (no CPU per sample):
+ *   Timer0A requests uDMA channel 18 at the sample rate; each
+ *   request copies GPIO_PORTB_AHB_DATA_BITS_R[0xFF] (all eight
+ *   pins) into a ping-pong buffer of LA_HALF bytes. Timer0A's
+ *   own interrupts stay masked; the TM4C123 has no mask bit for
+ *   the uDMA done, which reaches the Timer0A vector once per
+ *   half and is acknowledged in UDMA_CHIS_R.
+ *
+ * Compression (TIMER0A_Handler, once per LA_HALF samples):
+ *   Run-length: a record is written only when the pins change,
+ *      value (1 byte), run (LEB128 varint: 7 bits per byte,
+ *      bit 7 = more bytes follow)
+ *   A bus that is idle most of the time costs a few bytes per
+ *   burst instead of one byte per sample.
+ *
+ * Stream (UART0 TX by uDMA from an 8 KB ring):
+ *   "LOGA", version 1, channels 8, sample rate (u32, LE)
+ *   records ...
+ *   value, run 0, lost (varint): lost > 0 means the ring was
+ *   full and that many samples were dropped; lost = 0 ends
+ *   the capture.
+ *   host/la2vcd.c converts a saved stream into a VCD file for
+ *   GTKWave, PulseView (sigrok) and similar viewers:
+ *      la2vcd capture.bin > capture.vcd
+ *
+ * Throughput:
+ *   921600 baud = 92160 bytes/s sustained. The sample rate the
+ *   link can keep up with depends on the signal; after "s" the
+ *   demo prints the rate, the compressed size, the link-limited
+ *   sustained sample rate for this signal, lost samples and the
+ *   CPU load of the compressor. The sample clock is limited to
+ *   2 MHz (the compressor must finish a half before the next).
+ *
+ * Commands (text, while stopped):
+ *      r <hz>    sample rate (default 1 MHz)
+ *      g         start streaming (binary until "s")
+ *      s         stop, then print the statistics
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define LA_HALF 1024          // samples per ping-pong half
+#define LA_TX_SIZE 8192       // stream ring, power of two
+#define LA_MAX_HZ 2000000
+#define LA_LINK_BPS 92160     // 921600 baud, 10 bits per byte
+#define DMA_CH_TIMER0A 18
+#define DMA_CH_UART0TX 9
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+uint8_t la_buf[2][LA_HALF];
+uint32_t la_rate = 1000000;
+volatile uint8_t la_running;
+volatile uint32_t la_halves;
+
+// Run-length state, carried from one half to the next
+uint32_t la_value, la_run;
+
+// Stream ring: head written by the compressor, tail by uDMA
+uint8_t la_tx[LA_TX_SIZE];
+volatile uint32_t la_tx_head, la_tx_tail;
+volatile uint32_t la_tx_chunk; // bytes in flight, 0 = idle
+
+// Statistics
+uint32_t la_bytes, la_lost, la_lost_pending;
+uint32_t la_busy_ticks;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void UART0_Init(void);
+void la_init(void);
+void la_start(void);
+void la_stop(void);
+void la_dma_half(uint32_t n);
+void la_compress(const uint8_t *s, uint32_t n);
+void la_gap(void);
+void la_record(uint32_t value, uint32_t run);
+void la_put(uint8_t b);
+void la_varint(uint32_t v);
+uint32_t la_free(void);
+void la_tx_kick(void);
+void la_report(void);
+void command(char *line);
+uint32_t parse_number(char **p);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    char line[32];
+    uint32_t len = 0;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz system clock, enable clocks
+     ***********************************************************/
+    PLL_Init80MHz();
+    SYSCTL_RCGCGPIO_R |= 0x02; // Port B
+    SYSCTL_RCGCTIMER_R |= 0x03;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x02) == 0)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 921600 8N1, uDMA TX
+     ***********************************************************/
+    UART0_Init();
+
+    /***********************************************************
+     * STEP 3: PB0-PB7 inputs, sample clock, uDMA channels
+     ***********************************************************/
+    la_init();
+    UART0_SendString("\r\nLogic analyzer: r <hz>, g, s\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – commands (RX by CPU, TX by uDMA)
+     ***********************************************************/
+    while (1)
+    {
+        if ((UART0_FR_R & 0x10) != 0) // RX FIFO empty
+            continue;
+
+        c = (char)UART0_DR_R;
+        if (la_running) // Binary stream: single keys only
+        {
+            if (c == 's')
+                la_stop();
+            continue;
+        }
+
+        if (c == '\r' || c == '\n')
+        {
+            line[len] = 0;
+            if (len)
+                command(line);
+            len = 0;
+        }
+        else if (len < sizeof(line) - 1)
+        {
+            line[len++] = c;
+        }
+    }
+}
+
+/***********************************************************
+ * la_init() – PB0-PB7 inputs on AHB, Timer0A and Timer1,
+ * uDMA channel 18 (Timer0A) and 9 (UART0 TX)
+ ***********************************************************/
+void la_init(void)
+{
+    SYSCTL_GPIOHBCTL_R |= 0x02; // Port B on the AHB aperture
+    GPIO_PORTB_AHB_DIR_R &= ~0xFF;
+    GPIO_PORTB_AHB_DEN_R |= 0xFF;
+
+    // Timer1: free-running, CPU load reference
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;
+    TIMER1_TAMR_R = 0x02;
+    TIMER1_TAILR_R = 0xFFFFFFFF;
+    TIMER1_CTL_R = 0x01;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02; // Periodic
+    TIMER0_IMR_R = 0x00;  // Sample ticks only request uDMA
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP1_R &= ~0x000000F0; // CH9 → UART0 TX
+    UDMA_CHMAP2_R &= ~0x00000F00; // CH18 → Timer0A
+    UDMA_USEBURSTCLR_R = (1 << DMA_CH_TIMER0A) | (1 << DMA_CH_UART0TX);
+    UDMA_REQMASKCLR_R = (1 << DMA_CH_TIMER0A) | (1 << DMA_CH_UART0TX);
+
+    NVIC_EN0_R = (1 << 19) | (1 << 5); // Timer0A, UART0
+    __enable_irq();
+}
+
+/***********************************************************
+ * la_start() – header, then sampling from the next tick
+ ***********************************************************/
+void la_start(void)
+{
+    static const uint8_t magic[4] = {'L', 'O', 'G', 'A'};
+    uint32_t i;
+
+    la_tx_head = la_tx_tail = 0;
+    la_bytes = la_lost = la_lost_pending = 0;
+    la_busy_ticks = 0;
+    la_halves = 0;
+    la_run = 0;
+
+    for (i = 0; i < 4; i++)
+        la_put(magic[i]);
+    la_put(1); // Version
+    la_put(8); // Channels
+    for (i = 0; i < 4; i++)
+        la_put((uint8_t)(la_rate >> (8 * i)));
+
+    la_dma_half(0);
+    la_dma_half(1);
+    UDMA_ALTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_ENASET_R = 1 << DMA_CH_TIMER0A;
+
+    TIMER0_TAILR_R = SYSCLK / la_rate - 1;
+    TIMER0_TAV_R = SYSCLK / la_rate - 1;
+    la_running = 1;
+    TIMER0_CTL_R = 0x01;
+    la_tx_kick();
+}
+
+/***********************************************************
+ * la_stop() – stop sampling, flush the last run, end marker,
+ * wait until the ring is sent, then print the statistics
+ ***********************************************************/
+void la_stop(void)
+{
+    TIMER0_CTL_R = 0x00;
+    UDMA_ENACLR_R = 1 << DMA_CH_TIMER0A;
+    while (la_free() < 32)
+        ; // Room for the last run, a gap and the end marker
+
+    __disable_irq();
+    la_running = 0;
+    if (la_lost_pending)
+        la_gap(); // Ring has room for it: the last half was dropped
+    if (la_run)
+        la_record(la_value, la_run);
+    la_put((uint8_t)la_value); // End: run 0, lost 0
+    la_put(0);
+    la_put(0);
+    la_tx_kick();
+    __enable_irq();
+
+    while (la_tx_tail != la_tx_head || la_tx_chunk)
+        ;
+    la_report();
+}
+
+/***********************************************************
+ * la_dma_half() – half n: even → primary, odd → alternate
+ ***********************************************************/
+void la_dma_half(uint32_t n)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_TIMER0A + ((n & 1) ? 32 : 0)];
+
+    e->src_end = (uint32_t)(uintptr_t)&GPIO_PORTB_AHB_DATA_BITS_R[0xFF];
+    e->dst_end = (uint32_t)(uintptr_t)&la_buf[n & 1][LA_HALF - 1];
+    e->ctl = (0u << 30)              // DSTINC: byte
+             | (0u << 28)            // DSTSIZE: byte
+             | (3u << 26)            // SRCINC: none
+             | (0u << 24)            // SRCSIZE: byte
+             | (0u << 14)            // ARBSIZE: 1 per sample
+             | ((LA_HALF - 1) << 4)  // XFERSIZE
+             | 0x3;                  // Ping-pong
+}
+
+/***********************************************************
+ * TIMER0A_Handler() – one half sampled: compress it, re-arm
+ * If the ring cannot take a worst-case half (2 bytes per
+ * sample), the half is dropped and reported as lost.
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    uint32_t n = la_halves;
+    uint32_t t0 = TIMER1_TAR_R;
+
+    TIMER0_ICR_R = 0x01; // TATOCINT
+    UDMA_CHIS_R = 1 << DMA_CH_TIMER0A;
+
+    if (la_free() < 2 * LA_HALF + 16)
+    {
+        la_lost_pending += LA_HALF;
+    }
+    else
+    {
+        if (la_lost_pending)
+            la_gap();
+        la_compress(la_buf[n & 1], LA_HALF);
+        la_tx_kick();
+    }
+
+    la_dma_half(n + 2); // Same half, same structure
+    la_halves = n + 1;
+    la_busy_ticks += t0 - TIMER1_TAR_R; // down counter
+}
+
+/***********************************************************
+ * la_gap() – close the current run, then a gap marker for the
+ * dropped samples; the next half starts a new run
+ ***********************************************************/
+void la_gap(void)
+{
+    if (la_run)
+        la_record(la_value, la_run);
+    la_put((uint8_t)la_value); // Run 0, lost
+    la_put(0);
+    la_varint(la_lost_pending);
+    la_lost += la_lost_pending;
+    la_lost_pending = 0;
+    la_run = 0;
+}
+
+/***********************************************************
+ * la_compress() – run-length encode n samples into the ring
+ * The worst case is a change on every sample: two bytes per
+ * sample. The records are written as in la_record(), but the
+ * ring head stays in a register and is published once at the
+ * end, so that case costs a few instructions per sample
+ * instead of two la_put() calls on the volatile head.
+ ***********************************************************/
+void la_compress(const uint8_t *s, uint32_t n)
+{
+    uint32_t v = la_value, run = la_run, h = la_tx_head, i;
+
+    if (run == 0) // First sample of a capture or after a gap
+        v = s[0];
+
+    for (i = 0; i < n; i++)
+    {
+        if (s[i] != v)
+        {
+            la_tx[h++ & (LA_TX_SIZE - 1)] = (uint8_t)v;
+            for (; run >= 0x80; run >>= 7)
+                la_tx[h++ & (LA_TX_SIZE - 1)] = (uint8_t)(run | 0x80);
+            la_tx[h++ & (LA_TX_SIZE - 1)] = (uint8_t)run;
+            v = s[i];
+            run = 0;
+        }
+        run++;
+    }
+
+    la_bytes += h - la_tx_head;
+    la_tx_head = h;
+    la_value = v;
+    la_run = run;
+}
+
+/*** la_record() – value byte + run length as varint ***/
+void la_record(uint32_t value, uint32_t run)
+{
+    la_put((uint8_t)value);
+    la_varint(run);
+}
+
+/*** la_varint() – LEB128: 7 bits per byte, LSB group first ***/
+void la_varint(uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        la_put((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    la_put((uint8_t)v);
+}
+
+/*** la_put() – one byte into the stream ring (space checked per half) ***/
+void la_put(uint8_t b)
+{
+    la_tx[la_tx_head & (LA_TX_SIZE - 1)] = b;
+    la_tx_head++;
+    la_bytes++;
+}
+
+uint32_t la_free(void)
+{
+    return LA_TX_SIZE - (la_tx_head - la_tx_tail);
+}
+
+/***********************************************************
+ * la_tx_kick() – if uDMA TX is idle, send the next contiguous
+ * part of the ring (up to the wrap, max 1024 bytes)
+ ***********************************************************/
+void la_tx_kick(void)
+{
+    uint32_t tail = la_tx_tail, n = la_tx_head - tail;
+    uint32_t to_wrap = LA_TX_SIZE - (tail & (LA_TX_SIZE - 1));
+
+    if (la_tx_chunk || n == 0)
+        return;
+
+    n = n > to_wrap ? to_wrap : n;
+    n = n > 1024 ? 1024 : n;
+
+    dma_table[DMA_CH_UART0TX].src_end = (uint32_t)(uintptr_t)&la_tx[(tail & (LA_TX_SIZE - 1)) + n - 1];
+    dma_table[DMA_CH_UART0TX].dst_end = (uint32_t)(uintptr_t)&UART0_DR_R;
+    dma_table[DMA_CH_UART0TX].ctl = (3u << 30)       // DSTINC: none
+                                    | (0u << 28)     // DSTSIZE: byte
+                                    | (0u << 26)     // SRCINC: byte
+                                    | (0u << 24)     // SRCSIZE: byte
+                                    | (2u << 14)     // ARBSIZE: 4
+                                    | ((n - 1) << 4) // XFERSIZE
+                                    | 0x1;           // Basic mode
+    la_tx_chunk = n;
+    UDMA_ENASET_R = 1 << DMA_CH_UART0TX;
+}
+
+/***********************************************************
+ * UART0_Handler() – uDMA TX chunk done: free it, send more
+ ***********************************************************/
+void UART0_Handler(void)
+{
+    if ((UDMA_CHIS_R & (1 << DMA_CH_UART0TX)) == 0)
+        return;
+
+    UDMA_CHIS_R = 1 << DMA_CH_UART0TX;
+    la_tx_tail += la_tx_chunk;
+    la_tx_chunk = 0;
+    la_tx_kick();
+}
+
+/***********************************************************
+ * la_report() – rate, size, sustained rate, lost, CPU load
+ ***********************************************************/
+void la_report(void)
+{
+    uint32_t samples = la_halves * LA_HALF;
+    uint64_t ticks = (uint64_t)samples * (SYSCLK / la_rate);
+
+    samples = samples ? samples : 1;
+    UART0_SendString("\r\nrate ");
+    UART0_SendNumber(la_rate);
+    UART0_SendString(" Hz, ");
+    UART0_SendNumber(samples);
+    UART0_SendString(" samples, ");
+    UART0_SendNumber(la_bytes);
+    UART0_SendString(" bytes (");
+    UART0_SendNumber((uint32_t)((uint64_t)la_bytes * 1000 / samples));
+    UART0_SendString(" mbyte/sample)\r\nstream ");
+    UART0_SendNumber((uint32_t)((uint64_t)la_bytes * la_rate / samples));
+    UART0_SendString(" B/s of ");
+    UART0_SendNumber(LA_LINK_BPS);
+    UART0_SendString(", sustained ");
+    UART0_SendNumber((uint32_t)((uint64_t)LA_LINK_BPS * samples / (la_bytes ? la_bytes : 1)));
+    UART0_SendString(" samples/s at this ratio\r\nlost ");
+    UART0_SendNumber(la_lost);
+    UART0_SendString(", cpu ");
+    UART0_SendNumber((uint32_t)((uint64_t)la_busy_ticks * 1000 / (ticks ? ticks : 1)));
+    UART0_SendString(" permille\r\n");
+}
+
+/***********************************************************
+ * command() – r <hz>, g
+ ***********************************************************/
+void command(char *line)
+{
+    char *p = line + 1;
+    uint32_t hz;
+
+    switch (line[0])
+    {
+    case 'r':
+        hz = parse_number(&p);
+        hz = hz == 0 ? 1 : hz > LA_MAX_HZ ? LA_MAX_HZ : hz;
+        la_rate = SYSCLK / (SYSCLK / hz); // Rate the timer really gives
+        UART0_SendString("rate ");
+        UART0_SendNumber(la_rate);
+        UART0_SendString(" Hz\r\n");
+        break;
+
+    case 'g':
+        la_start();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*** parse_number() – skip spaces, read decimal digits ***/
+uint32_t parse_number(char **p)
+{
+    uint32_t n = 0;
+
+    while (**p == ' ')
+        (*p)++;
+    while (**p >= '0' && **p <= '9')
+        n = n * 10 + (*(*p)++ - '0');
+
+    return n;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0 at 921600 8N1 from an 80 MHz clock, uDMA TX
+ * IBRD = 80 MHz / (16 x 921600) = 5.425 → 5
+ * FBRD = 0.425 x 64 + 0.5 = 27
+ ***********************************************************/
+void UART0_Init(void)
+{
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 5;
+    UART0_FBRD_R = 27;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_DMACTL_R = 0x02; // TXDMAE
+    UART0_CTL_R = 0x301;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,585 @@
+/***************************************************************
+ * PROJECT NAME : Auto-Ranging Frequency Counter
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - Wide Timer 0A, input edge-count on PC4 (WT0CCP0)
+ *      - Wide Timer 0B, input edge-time on PC5 (WT0CCP1)
+ *      - Timer1A (gate window, one uDMA request per gate)
+ *      - uDMA channel 20 (Timer1A, edge count → RAM, ping-pong)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Edge-time capture (014_03, 014_04) costs one interrupt per
+ * edge, which tops out in the tens of kHz. This counter measures
+ * up to 20 MHz with no CPU work per edge and picks the method
+ * with the better resolution on its own.
+ *
+ * Count method (high frequencies):
+ *   WT0A counts rising edges on PC4 in hardware (48 bits with
+ *   the prescaler, never stops in practice). Timer1A times out
+ *   once per gate and requests uDMA channel 20, which copies
+ *   the count into a ping-pong buffer. Both timers run from the
+ *   same 80 MHz clock and the uDMA read has a fixed latency, so
+ *   every gate is exactly gate_ticks long, without the jitter
+ *   of reading the counter from an interrupt.
+ *      edges per gate = count[k] - count[k - 1]
+ *      f = edges x 80 MHz / gate_ticks
+ *   One reading per gate (1 ms default: 1000 readings/s, up to
+ *   10000/s with g 100). TIMER1A_Handler runs once per
+ *   FC_HALF gates, on the uDMA done of channel 20 (the TM4C123
+ *   has no timer mask bit for it, and the gate timeout itself
+ *   is not enabled as an interrupt); it keeps the edges of the last FC_LOG gates
+ *   in fc_gate_edges[] for fc_gate_reading(), and adds them
+ *   to 64-bit sums for the printed reading (a 1 s gate makes
+ *   one block 5.12e9 ticks long).
+ *
+ * Period method (low frequencies):
+ *   WT0B time-stamps rising edges on PC5 (jumper PC4 - PC5) in
+ *   80 MHz ticks. Only enabled below FC_TO_PERIOD, and off
+ *   again above FC_TO_COUNT: at about 50 cycles per edge the
+ *   interrupt costs 2.5 % of the CPU at 40 kHz and about 3 %
+ *   at the 50 kHz switch-back point.
+ *      f = periods x 80 MHz / ticks of those periods
+ *
+ * Resolution and error (shown with every reading):
+ *   count:  +-1 edge per display interval T      → 1 / T
+ *   period: +-1 tick over the timed periods      → f / ticks
+ *   error = resolution + crystal tolerance (FC_XTAL_PPM of f)
+ *   The count method runs all the time; the range switches to
+ *   period below FC_TO_PERIOD and back above FC_TO_COUNT
+ *   (hysteresis). Below 40 kHz +-2 Hz is worse than 50 ppm,
+ *   while timing the periods still resolves millihertz.
+ *
+ * Commands:
+ *      g <us>    gate time in microseconds (100 - 1000000)
+ *      d         the last 16 per-gate readings (res 1 edge
+ *                per gate)
+ *
+ * Output (every FC_DISPLAY = 0.5 s, but at most once per
+ * FC_HALF gates: every 64 s with g 1000000), averaged over
+ * that interval; "count 1000/s" is the per-gate reading rate:
+ *      f 1234567.890 Hz  res 2.000  err 63.728 Hz  count 1000/s
+ *      f 1000.000 Hz  res 0.001  err 0.051 Hz  period 1000/s
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define FC_HALF 64              // gates per ping-pong half
+#define FC_LOG 256              // per-gate readings kept, power of two
+#define FC_DISPLAY (SYSCLK / 2) // ticks per printed reading
+#define FC_TO_PERIOD 40000000   // mHz: switch to period below 40 kHz
+#define FC_TO_COUNT 50000000    // mHz: switch to count above 50 kHz
+#define FC_XTAL_PPM 50          // LaunchPad 16 MHz crystal
+#define FC_MIN_GATE_US 100
+#define DMA_CH_TIMER1A 20
+
+enum
+{
+    FC_COUNT,
+    FC_PERIOD
+};
+
+typedef struct
+{
+    uint64_t mhz;     // frequency in millihertz
+    uint32_t res_mhz; // one count (or one tick) in millihertz
+    uint32_t err_mhz; // resolution + crystal tolerance
+    uint8_t method;   // FC_COUNT or FC_PERIOD
+} fc_reading_t;
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+uint32_t fc_stamp[2][FC_HALF]; // edge count at the end of each gate
+uint32_t fc_gate_ticks = SYSCLK / 1000;
+uint32_t fc_prev;              // count at the end of the last gate
+volatile uint32_t fc_halves;
+volatile uint32_t fc_readings; // gates measured
+uint32_t fc_gate_edges[FC_LOG]; // edges in gate k at [k % FC_LOG]
+
+// Count method, summed over the display interval
+volatile uint64_t fc_acc_edges, fc_acc_ticks;
+
+// Period method
+volatile uint8_t fc_method = FC_COUNT;
+volatile uint32_t fc_per_n, fc_last_edge;
+volatile uint64_t fc_per_ticks;
+volatile uint8_t fc_have_edge;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void fc_init(void);
+void fc_gate(uint32_t us);
+void fc_dma_half(uint32_t n);
+void fc_gate_block(const uint32_t *stamp, uint32_t n);
+void fc_period_enable(int on);
+void fc_from_count(uint64_t edges, uint64_t ticks, fc_reading_t *r);
+void fc_from_period(uint32_t periods, uint64_t ticks, fc_reading_t *r);
+int fc_gate_reading(uint32_t k, fc_reading_t *r);
+uint8_t fc_range(uint8_t method, uint64_t mhz);
+void fc_print(const fc_reading_t *r, uint32_t per_second);
+void fc_print_mhz(uint64_t mhz);
+void command(char *line);
+uint32_t parse_number(char **p);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    char line[32];
+    uint32_t len = 0, periods, seen = 0;
+    uint64_t edges, ticks, pticks;
+    fc_reading_t count, period;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz system clock, enable clocks
+     ***********************************************************/
+    PLL_Init80MHz();
+    SYSCTL_RCGCGPIO_R |= 0x05; // Ports A, C
+    SYSCTL_RCGCTIMER_R |= 0x02;
+    SYSCTL_RCGCWTIMER_R |= 0x01;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x05) != 0x05)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 80 MHz (IBRD 43, FBRD 26)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: Edge counter, edge timer, gate timer and uDMA
+     ***********************************************************/
+    fc_init();
+    UART0_SendString("\r\nFrequency counter on PC4 (+ PC5): g <us>\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – print a reading every 0.5 s (or per
+     * block of FC_HALF gates if that is longer)
+     ***********************************************************/
+    while (1)
+    {
+        // The 64-bit sums change once per block: read them then,
+        // with interrupts masked, instead of polling them torn
+        ticks = 0;
+        if (fc_halves != seen)
+        {
+            seen = fc_halves;
+            __disable_irq();
+            ticks = fc_acc_ticks;
+            edges = fc_acc_edges;
+            periods = fc_per_n;
+            pticks = fc_per_ticks;
+            if (ticks >= FC_DISPLAY)
+            {
+                fc_acc_edges = fc_acc_ticks = 0;
+                fc_per_n = fc_per_ticks = 0;
+            }
+            __enable_irq();
+        }
+
+        if (ticks >= FC_DISPLAY)
+        {
+            fc_from_count(edges, ticks, &count);
+            fc_method = fc_range(fc_method, count.mhz);
+            fc_period_enable(fc_method == FC_PERIOD);
+
+            if (fc_method == FC_PERIOD && periods)
+            {
+                fc_from_period(periods, pticks, &period);
+                fc_print(&period, (uint32_t)((uint64_t)periods * SYSCLK / ticks));
+            }
+            else if (fc_method == FC_COUNT || edges == 0)
+            {
+                fc_print(&count, SYSCLK / fc_gate_ticks);
+            } // else: no full period in the interval yet
+        }
+
+        if ((UART0_FR_R & 0x10) != 0) // RX FIFO empty
+            continue;
+
+        c = (char)UART0_DR_R;
+        if (c == '\r' || c == '\n')
+        {
+            line[len] = 0;
+            if (len)
+                command(line);
+            len = 0;
+        }
+        else if (len < sizeof(line) - 1)
+        {
+            line[len++] = c;
+        }
+    }
+}
+
+/***********************************************************
+ * fc_init() – PC4 = WT0CCP0 (edge count), PC5 = WT0CCP1
+ * (edge time), Timer1A gate with uDMA channel 20
+ ***********************************************************/
+void fc_init(void)
+{
+    GPIO_PORTC_DIR_R &= ~0x30;
+    GPIO_PORTC_AFSEL_R |= 0x30;
+    GPIO_PORTC_DEN_R |= 0x30;
+    GPIO_PORTC_PCTL_R = (GPIO_PORTC_PCTL_R & ~0x00FF0000) | 0x00770000;
+
+    /* WT0A: edge count, up, 48 bits (prescaler = upper 16 bits) */
+    WTIMER0_CTL_R = 0x00;
+    WTIMER0_CFG_R = 0x04;    // Two 32-bit timers
+    WTIMER0_TAMR_R = 0x13;   // Capture, edge count, count up
+    WTIMER0_TAILR_R = 0xFFFFFFFF;
+    WTIMER0_TAPR_R = 0xFFFF;
+    WTIMER0_TAMATCHR_R = 0xFFFFFFFF;
+    WTIMER0_TAPMR_R = 0xFFFF; // Stops after 2^48 edges (163 days at 20 MHz)
+
+    /* WT0B: edge time, up, free-running 32-bit time base */
+    WTIMER0_TBMR_R = 0x17;   // Capture, edge time, count up
+    WTIMER0_TBILR_R = 0xFFFFFFFF;
+    WTIMER0_CTL_R = 0x0101;  // TAEVENT = TBEVENT = rising, TAEN, TBEN
+
+    /* Timer1A: gate, one uDMA request per timeout */
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;
+    TIMER1_TAMR_R = 0x02;    // Periodic
+    TIMER1_IMR_R = 0x00;     // Gate timeouts only trigger uDMA
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0x000F0000; // CH20 → Timer1A
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_TIMER1A;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_TIMER1A;
+
+    NVIC_EN0_R = 1 << 21;  // Timer1A
+    __enable_irq();
+
+    fc_gate(1000);
+}
+
+/***********************************************************
+ * fc_gate() – (re)start the gate timer with a new window
+ ***********************************************************/
+void fc_gate(uint32_t us)
+{
+    TIMER1_CTL_R = 0x00;
+    UDMA_ENACLR_R = 1 << DMA_CH_TIMER1A;
+
+    __disable_irq();
+    fc_gate_ticks = us * (SYSCLK / 1000000);
+    fc_acc_edges = fc_acc_ticks = 0;
+    fc_halves = 0;
+    fc_readings = 0; // Logged gates had the old length
+    fc_prev = WTIMER0_TAR_R; // Edges are counted from here
+    __enable_irq();
+
+    fc_dma_half(0);
+    fc_dma_half(1);
+    UDMA_ALTCLR_R = 1 << DMA_CH_TIMER1A;
+    UDMA_ENASET_R = 1 << DMA_CH_TIMER1A;
+
+    TIMER1_TAILR_R = fc_gate_ticks - 1;
+    TIMER1_TAV_R = fc_gate_ticks - 1;
+    TIMER1_CTL_R = 0x01;
+}
+
+/***********************************************************
+ * fc_dma_half() – half n: even → primary, odd → alternate
+ ***********************************************************/
+void fc_dma_half(uint32_t n)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_TIMER1A + ((n & 1) ? 32 : 0)];
+
+    e->src_end = (uint32_t)(uintptr_t)&WTIMER0_TAR_R;
+    e->dst_end = (uint32_t)(uintptr_t)&fc_stamp[n & 1][FC_HALF - 1];
+    e->ctl = (2u << 30)              // DSTINC: word
+             | (2u << 28)            // DSTSIZE: word
+             | (3u << 26)            // SRCINC: none
+             | (2u << 24)            // SRCSIZE: word
+             | (0u << 14)            // ARBSIZE: 1 per gate
+             | ((FC_HALF - 1) << 4)  // XFERSIZE
+             | 0x3;                  // Ping-pong
+}
+
+/***********************************************************
+ * TIMER1A_Handler() – FC_HALF gates done: sum them, re-arm
+ ***********************************************************/
+void TIMER1A_Handler(void)
+{
+    uint32_t n = fc_halves;
+
+    TIMER1_ICR_R = 0x01; // TATOCINT
+    UDMA_CHIS_R = 1 << DMA_CH_TIMER1A;
+
+    fc_gate_block(fc_stamp[n & 1], FC_HALF);
+    fc_dma_half(n + 2); // Same half, same structure
+    fc_halves = n + 1;
+}
+
+/***********************************************************
+ * fc_gate_block() – edges per gate from n count stamps
+ * The counter wraps at 2^32 in TAR; the differences do not.
+ * Each gate's edges go into the fc_gate_edges[] log.
+ ***********************************************************/
+void fc_gate_block(const uint32_t *stamp, uint32_t n)
+{
+    uint32_t prev = fc_prev, k = fc_readings, edges = 0, d, i;
+
+    for (i = 0; i < n; i++)
+    {
+        d = stamp[i] - prev;
+        prev = stamp[i];
+        fc_gate_edges[(k + i) & (FC_LOG - 1)] = d;
+        edges += d;
+    }
+
+    fc_prev = prev;
+    fc_acc_edges += edges;
+    fc_acc_ticks += (uint64_t)n * fc_gate_ticks;
+    fc_readings = k + n;
+}
+
+/***********************************************************
+ * fc_gate_reading() – reading of gate k alone (k counts from
+ * 0 like fc_readings). Returns 0 if gate k is not measured
+ * yet or its log slot may be refilled by the next block,
+ * checked after the read so a refill meanwhile is caught.
+ ***********************************************************/
+int fc_gate_reading(uint32_t k, fc_reading_t *r)
+{
+    uint32_t edges = fc_gate_edges[k & (FC_LOG - 1)];
+    uint32_t n = fc_readings;
+
+    if (k >= n || n - k - 1 >= FC_LOG - FC_HALF)
+        return 0;
+    fc_from_count(edges, fc_gate_ticks, r);
+    return 1;
+}
+
+/***********************************************************
+ * WTIMER0B_Handler() – period method, one rising edge
+ ***********************************************************/
+void WTIMER0B_Handler(void)
+{
+    uint32_t t = WTIMER0_TBR_R;
+
+    WTIMER0_ICR_R = 0x0400; // CBECINT
+
+    if (fc_have_edge)
+    {
+        fc_per_ticks += t - fc_last_edge;
+        fc_per_n++;
+    }
+    fc_last_edge = t;
+    fc_have_edge = 1;
+}
+
+/*** fc_period_enable() – period interrupts on or off ***/
+void fc_period_enable(int on)
+{
+    if (on && (WTIMER0_IMR_R & 0x0400) == 0)
+    {
+        fc_have_edge = 0;
+        WTIMER0_ICR_R = 0x0400;
+        WTIMER0_IMR_R |= 0x0400; // CBEIM
+        NVIC_EN2_R = 1 << 31;    // WTIMER0B (IRQ 95)
+    }
+    else if (!on && (WTIMER0_IMR_R & 0x0400) != 0)
+    {
+        WTIMER0_IMR_R &= ~0x0400;
+    }
+}
+
+/***********************************************************
+ * fc_from_count() – edges over ticks of 80 MHz
+ * res = one edge over the interval, err = res + crystal
+ * edges x SYSCLK fits 64 bits (edges < 2^37), x 1000 does
+ * not always (64 s at 20 MHz), so the quotient and the
+ * remainder are scaled to millihertz separately.
+ ***********************************************************/
+void fc_from_count(uint64_t edges, uint64_t ticks, fc_reading_t *r)
+{
+    uint64_t x = edges * SYSCLK;
+
+    ticks = ticks ? ticks : 1;
+    r->method = FC_COUNT;
+    r->mhz = x / ticks * 1000 + x % ticks * 1000 / ticks;
+    r->res_mhz = (uint32_t)((uint64_t)SYSCLK * 1000 / ticks);
+    r->err_mhz = r->res_mhz + (uint32_t)(r->mhz * FC_XTAL_PPM / 1000000);
+}
+
+/***********************************************************
+ * fc_from_period() – periods timed over ticks of 80 MHz
+ * res = one tick over the interval (f / ticks), same
+ * division order as fc_from_count()
+ ***********************************************************/
+void fc_from_period(uint32_t periods, uint64_t ticks, fc_reading_t *r)
+{
+    uint64_t x = (uint64_t)periods * SYSCLK;
+
+    ticks = ticks ? ticks : 1;
+    r->method = FC_PERIOD;
+    r->mhz = x / ticks * 1000 + x % ticks * 1000 / ticks;
+    r->res_mhz = (uint32_t)(r->mhz / ticks);
+    r->res_mhz = r->res_mhz ? r->res_mhz : 1;
+    r->err_mhz = r->res_mhz + (uint32_t)(r->mhz * FC_XTAL_PPM / 1000000);
+}
+
+/*** fc_range() – method for the next interval, with hysteresis ***/
+uint8_t fc_range(uint8_t method, uint64_t mhz)
+{
+    if (method == FC_COUNT && mhz < FC_TO_PERIOD)
+        return FC_PERIOD;
+    if (method == FC_PERIOD && mhz > FC_TO_COUNT)
+        return FC_COUNT;
+    return method;
+}
+
+/***********************************************************
+ * fc_print() – "f <Hz>  res <Hz>  err <Hz>  <method> <n>/s"
+ ***********************************************************/
+void fc_print(const fc_reading_t *r, uint32_t per_second)
+{
+    UART0_SendString("f ");
+    fc_print_mhz(r->mhz);
+    UART0_SendString(" Hz  res ");
+    fc_print_mhz(r->res_mhz);
+    UART0_SendString("  err ");
+    fc_print_mhz(r->err_mhz);
+    UART0_SendString(r->method == FC_COUNT ? " Hz  count " : " Hz  period ");
+    UART0_SendNumber(per_second);
+    UART0_SendString("/s\r\n");
+}
+
+/*** fc_print_mhz() – millihertz as <Hz>.<3 digits> ***/
+void fc_print_mhz(uint64_t mhz)
+{
+    uint32_t frac = (uint32_t)(mhz % 1000);
+
+    UART0_SendNumber((uint32_t)(mhz / 1000));
+    UART0Tx('.');
+    UART0Tx('0' + frac / 100);
+    UART0Tx('0' + frac / 10 % 10);
+    UART0Tx('0' + frac % 10);
+}
+
+/***********************************************************
+ * command() – g <us>, d
+ ***********************************************************/
+void command(char *line)
+{
+    char *p = line + 1;
+    uint32_t us, k, i;
+    fc_reading_t r;
+
+    if (line[0] == 'd')
+    {
+        k = fc_readings;
+        for (i = 16; i > 0; i--)
+            if (fc_gate_reading(k - i, &r))
+                fc_print(&r, SYSCLK / fc_gate_ticks);
+        return;
+    }
+    if (line[0] != 'g')
+        return;
+
+    us = parse_number(&p);
+    us = us < FC_MIN_GATE_US ? FC_MIN_GATE_US : us > 1000000 ? 1000000 : us;
+    fc_gate(us);
+    UART0_SendString("gate ");
+    UART0_SendNumber(us);
+    UART0_SendString(" us\r\n");
+}
+
+/*** parse_number() – skip spaces, read decimal digits ***/
+uint32_t parse_number(char **p)
+{
+    uint32_t n = 0;
+
+    while (**p == ' ')
+        (*p)++;
+    while (**p >= '0' && **p <= '9')
+        n = n * 10 + (*(*p)++ - '0');
+
+    return n;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,159 @@
+/***************************************************************
+ * PROJECT NAME : scop2csv – Oscilloscope Stream to CSV
+ * TARGET       : Host PC (standard C, any compiler)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Converts a stream saved from 011_04 (e.g. with a terminal's
+ * "log to file" while the demo runs) into CSV, one row per
+ * sample, which a spreadsheet, gnuplot or PulseView (import
+ * "CSV", analog column) plots directly.
+ *
+ *      cc -O2 -o scop2csv scop2csv.c
+ *      scop2csv capture.bin > capture.csv
+ *
+ * Stream format (see 011_04 main.c), little endian:
+ *      "SCOP", rate_hz (u32), count (u16), pre (u16),
+ *      trigger type (u8), forced flag (u8),
+ *      count x 12-bit samples, 2 samples in 3 bytes,
+ *      checksum (u8, XOR of the packed samples)
+ * The stream may hold several captures (auto / normal mode);
+ * each becomes its own block of rows. Text between captures
+ * (command echo) is skipped.
+ *
+ * Columns: capture, time in seconds relative to the trigger
+ * sample, raw 12-bit code, volts (3.3 V reference).
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+static FILE *in;
+
+static const char *trig_name[] = {"level", "rising", "falling", "window"};
+
+/*** get_byte() – next byte, -1 at end of file ***/
+static int get_byte(void)
+{
+    return fgetc(in);
+}
+
+/*** get_le() – n byte little endian value, -1 at end of file ***/
+static long get_le(int n)
+{
+    long v = 0;
+    int i, c;
+
+    for (i = 0; i < n; i++)
+    {
+        c = get_byte();
+        if (c < 0)
+            return -1;
+        v |= (long)c << (8 * i);
+    }
+    return v;
+}
+
+/*** find_header() – skip to "SCOP", 0 if not found ***/
+static int find_header(void)
+{
+    const char *magic = "SCOP";
+    int i = 0, c;
+
+    while ((c = get_byte()) >= 0)
+    {
+        if (c == magic[i])
+        {
+            if (++i == 4)
+                return 1;
+        }
+        else
+        {
+            i = (c == magic[0]);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static uint16_t sample[65536];
+    long rate, count, pre, type, forced;
+    uint8_t p[3], sum;
+    int capture = 0, i, k, c;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: scop2csv <capture.bin> > capture.csv\n");
+        return 2;
+    }
+    in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    printf("capture,time_s,code,volts\n");
+
+    while (find_header())
+    {
+        /* Header */
+        rate = get_le(4);
+        count = get_le(2);
+        pre = get_le(2);
+        type = get_byte();
+        forced = get_byte();
+        if (rate <= 0 || count <= 0 || (count & 1) || pre < 0 || pre >= count ||
+            type < 0 || type > 3 || forced < 0)
+        {
+            fprintf(stderr, "scop2csv: bad header after capture %d, resyncing\n", capture);
+            continue;
+        }
+
+        /* Samples: a = p0 | (p1 & 0x0F) << 8, b = p1 >> 4 | p2 << 4 */
+        sum = 0;
+        for (i = 0; i < count; i += 2)
+        {
+            for (k = 0; k < 3; k++)
+            {
+                if ((c = get_byte()) < 0)
+                    break;
+                p[k] = (uint8_t)c;
+                sum ^= p[k];
+            }
+            if (k < 3)
+                break;
+            sample[i] = (uint16_t)(p[0] | (p[1] & 0x0F) << 8);
+            sample[i + 1] = (uint16_t)(p[1] >> 4 | p[2] << 4);
+        }
+        c = get_byte();
+        if (i < count || c < 0)
+        {
+            fprintf(stderr, "scop2csv: capture %d truncated\n", capture);
+            break;
+        }
+        if ((uint8_t)c != sum)
+        {
+            fprintf(stderr, "scop2csv: capture %d checksum error, skipped\n", capture);
+            continue;
+        }
+
+        for (i = 0; i < count; i++)
+            printf("%d,%.9f,%u,%.4f\n", capture, (double)(i - pre) / (double)rate,
+                   sample[i], sample[i] * 3.3 / 4095.0);
+
+        fprintf(stderr, "scop2csv: capture %d: %ld samples at %ld Hz, %s trigger%s\n",
+                capture, count, rate, trig_name[type], forced ? " (forced)" : "");
+        capture++;
+    }
+
+    if (capture == 0)
+        fprintf(stderr, "scop2csv: no SCOP capture found\n");
+    fclose(in);
+    return capture ? 0 : 1;
+}
@@ -0,0 +1,565 @@
+/***************************************************************
+ * PROJECT NAME : ADC Oscilloscope Capture with Pre-Trigger
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad) @ 80 MHz (PLL)
+ * MODULES USED :
+ *      - ADC0 SS3 on PE3 (AIN0), triggered by Timer0A (100 kHz)
+ *      - uDMA channel 17 (ADC0 SS3, ping-pong) → sample ring
+ *      - uDMA channel 9 (UART0 TX) → host stream
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 921600 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 011_01 / 011_03 keep one value in "result". Here the ADC is
+ * sampled without gaps and the board behaves like a scope:
+ *
+ * Continuous sampling:
+ *   Timer0A triggers SS3 every 10 us and uDMA moves each result
+ *   into a ring of SCOPE_BLOCKS x SCOPE_BLOCK samples. The
+ *   primary and alternate control structures take turns: when
+ *   one finishes block n, ADC0SS3_Handler re-arms it for block
+ *   n + 2 while the other is already filling block n + 1. The
+ *   CPU runs once per block (every 2.56 ms), not per sample:
+ *   the per-sample SS3 interrupt stays masked (ADCIM = 0), and
+ *   the TM4C123 delivers the uDMA done of channel 17 on the SS3
+ *   vector with no ADC mask or status bit of its own; it is
+ *   acknowledged in UDMA_CHIS_R.
+ *
+ * Block-wise trigger scan (in the same interrupt):
+ *   LEVEL  : first sample >= level
+ *   EDGE   : crossing of level, rising or falling, with
+ *            hysteresis (must first go below/above level ∓ hyst)
+ *   WINDOW : first sample outside [lo, hi]
+ *   The trigger is only accepted once SCOPE_PRE samples exist,
+ *   and the edge state carries over from block to block.
+ *
+ * Freeze:
+ *   After the trigger, sampling continues until SCOPE_POST more
+ *   samples are in the ring, then uDMA and Timer0A stop. The
+ *   ring holds SCOPE_PRE + SCOPE_POST + 2 blocks, so the block
+ *   being filled at that moment never touches the capture.
+ *
+ * Host stream (UART0 uDMA at 921600, the fastest link on the
+ * ICDI port), little endian:
+ *      "SCOP"           4 bytes sync
+ *      rate_hz          4 bytes
+ *      count            2 bytes (SCOPE_PRE + SCOPE_POST)
+ *      pre              2 bytes (index of the trigger sample)
+ *      trigger type     1 byte, forced (auto) flag 1 byte
+ *      samples          count x 12 bits, 2 samples in 3 bytes
+ *      checksum         1 byte, XOR of the packed samples
+ *   Packing saves 25 % against 16-bit samples: one capture is
+ *   2319 bytes, about 25 ms on the wire. host/scop2csv.c turns
+ *   a saved stream into CSV for a spreadsheet or PulseView.
+ *
+ * Commands on UART0 (one line each):
+ *      l <level>          level trigger
+ *      r <level> / f <level>  rising / falling edge
+ *      w <lo> <hi>        window trigger
+ *      a                  auto: force a capture after 100 ms
+ *      n                  normal: wait for the trigger
+ *      s                  single: stop after the next capture
+ *      g                  go (re-arm)
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define SCOPE_RATE 100000   // samples per second
+#define SCOPE_BLOCK 256     // samples per uDMA block
+#define SCOPE_BLOCKS 8      // power of two
+#define SCOPE_RING (SCOPE_BLOCK * SCOPE_BLOCKS)
+#define SCOPE_PRE 512
+#define SCOPE_POST 1024
+#define SCOPE_COUNT (SCOPE_PRE + SCOPE_POST)
+#define SCOPE_AUTO_BLOCKS 40 // 100 ms without trigger in auto mode
+
+#define DMA_CH_ADC0SS3 17
+#define DMA_CH_UART0TX 9
+
+#if SCOPE_COUNT + 2 * SCOPE_BLOCK > SCOPE_RING
+#error "ring too small for pre + post trigger samples"
+#endif
+
+enum
+{
+    TRIG_LEVEL,
+    TRIG_EDGE_RISE,
+    TRIG_EDGE_FALL,
+    TRIG_WINDOW,
+};
+
+enum
+{
+    SCOPE_ARMED,     // sampling, looking for the trigger
+    SCOPE_TRIGGERED, // sampling the post-trigger part
+    SCOPE_FROZEN,    // capture complete, ready to send
+    SCOPE_SENDING,
+    SCOPE_STOPPED,   // single shot done, waiting for 'g'
+};
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+/***********************************************************
+ * CAPTURE STATE
+ ***********************************************************/
+uint16_t scope_ring[SCOPE_RING];
+
+volatile uint8_t scope_state;
+volatile uint32_t scope_blocks;  // completed blocks since arm
+volatile uint32_t scope_trigger; // sample index of the trigger
+volatile uint8_t scope_forced;
+
+uint8_t trig_type = TRIG_EDGE_RISE;
+uint16_t trig_level = 2048, trig_hyst = 64;
+uint16_t trig_lo = 1024, trig_hi = 3072;
+uint8_t trig_primed;  // edge: signal was on the far side of level
+uint8_t scope_auto = 1, scope_single;
+
+uint8_t scope_tx[16 + SCOPE_COUNT * 3 / 2 + 1];
+uint32_t scope_tx_len, scope_tx_sent;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void UART0_Init(void);
+void scope_init(void);
+void scope_arm(void);
+void scope_dma_block(uint32_t n);
+int scope_scan(const uint16_t *s, uint32_t first, uint32_t count, uint32_t index);
+uint8_t scope_pack(uint8_t *p, uint32_t pos, uint32_t count);
+void scope_send(void);
+void scope_tx_next(void);
+void scope_command(char *line);
+uint32_t parse_number(char **p);
+
+int main(void)
+{
+    char line[32];
+    uint32_t len = 0;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz clock, UART0 921600 with uDMA TX
+     ***********************************************************/
+    PLL_Init80MHz();
+    UART0_Init();
+
+    /***********************************************************
+     * STEP 2: ADC0 SS3 + Timer0A + uDMA ring, start sampling
+     ***********************************************************/
+    scope_init();
+    scope_arm();
+
+    /***********************************************************
+     * STEP 3: Main loop – send captures, read commands
+     ***********************************************************/
+    while (1)
+    {
+        if (scope_state == SCOPE_FROZEN)
+            scope_send();
+
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            c = (char)UART0_DR_R;
+            if (c == '\r' || c == '\n')
+            {
+                line[len] = 0;
+                if (len)
+                    scope_command(line);
+                len = 0;
+            }
+            else if (len < sizeof(line) - 1)
+            {
+                line[len++] = c;
+            }
+        }
+    }
+}
+
+/***********************************************************
+ * scope_init() – PE3 analog, SS3 on Timer0A, uDMA channel 17
+ ***********************************************************/
+void scope_init(void)
+{
+    SYSCTL_RCGCGPIO_R |= 0x10;  // Port E
+    SYSCTL_RCGCADC_R |= 0x01;   // ADC0
+    SYSCTL_RCGCTIMER_R |= 0x01; // Timer0
+    SYSCTL_RCGCDMA_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x10) == 0)
+        ;
+
+    GPIO_PORTE_AFSEL_R |= 0x08;
+    GPIO_PORTE_DEN_R &= ~0x08;
+    GPIO_PORTE_AMSEL_R |= 0x08;
+
+    ADC0_ACTSS_R &= ~0x08;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0xF000) | 0x5000; // SS3: timer
+    ADC0_SSMUX3_R = 0;                              // AIN0
+    ADC0_SSCTL3_R = 0x06;                           // END0, IE0 (DMA request)
+    ADC0_IM_R = 0;                                  // No per-sample interrupt
+    ADC0_ACTSS_R |= 0x08;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02; // Periodic
+    TIMER0_TAILR_R = SYSCLK / SCOPE_RATE - 1;
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0x000000F0; // CH17 → ADC0 SS3
+    UDMA_CHMAP1_R &= ~0x000000F0; // CH9  → UART0 TX
+    UDMA_USEBURSTCLR_R = (1 << DMA_CH_ADC0SS3) | (1 << DMA_CH_UART0TX);
+    UDMA_REQMASKCLR_R = (1 << DMA_CH_ADC0SS3) | (1 << DMA_CH_UART0TX);
+
+    NVIC_EN0_R = (1 << 5) | (1 << 17); // UART0, ADC0 SS3
+    __enable_irq();
+}
+
+/***********************************************************
+ * scope_dma_block() – point the structure of block n at its
+ * place in the ring (even blocks: primary, odd: alternate)
+ ***********************************************************/
+void scope_dma_block(uint32_t n)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_ADC0SS3 + ((n & 1) ? 32 : 0)];
+    uint16_t *dst = &scope_ring[(n & (SCOPE_BLOCKS - 1)) * SCOPE_BLOCK];
+
+    e->src_end = (uint32_t)(uintptr_t)&ADC0_SSFIFO3_R;
+    e->dst_end = (uint32_t)(uintptr_t)&dst[SCOPE_BLOCK - 1];
+    e->ctl = (1u << 30)                  // DSTINC: halfword
+             | (1u << 28)                // DSTSIZE: halfword
+             | (3u << 26)                // SRCINC: none
+             | (1u << 24)                // SRCSIZE: halfword
+             | (0u << 14)                // ARBSIZE: 1
+             | ((SCOPE_BLOCK - 1) << 4)  // XFERSIZE
+             | 0x3;                      // Ping-pong
+}
+
+/***********************************************************
+ * scope_arm() – restart sampling from an empty ring
+ ***********************************************************/
+void scope_arm(void)
+{
+    TIMER0_CTL_R = 0x00;
+    UDMA_ENACLR_R = 1 << DMA_CH_ADC0SS3;
+
+    scope_blocks = 0;
+    scope_forced = 0;
+    trig_primed = 0;
+    scope_dma_block(0);
+    scope_dma_block(1);
+    UDMA_ALTCLR_R = 1 << DMA_CH_ADC0SS3; // Start with primary
+    UDMA_ENASET_R = 1 << DMA_CH_ADC0SS3;
+
+    scope_state = SCOPE_ARMED;
+    TIMER0_CTL_R = 0x21; // TAOTE (ADC trigger), TAEN
+}
+
+/***********************************************************
+ * ADC0SS3_Handler() – one block of SCOPE_BLOCK samples done
+ ***********************************************************/
+void ADC0SS3_Handler(void)
+{
+    uint32_t n = scope_blocks;
+    uint32_t first = n * SCOPE_BLOCK;
+    const uint16_t *blk = &scope_ring[(n & (SCOPE_BLOCKS - 1)) * SCOPE_BLOCK];
+    int hit;
+
+    UDMA_CHIS_R = 1 << DMA_CH_ADC0SS3; // uDMA done: no ADC status bit
+
+    scope_dma_block(n + 2); // Reuse this block's structure
+    scope_blocks = ++n;
+
+    if (scope_state == SCOPE_ARMED)
+    {
+        // Skip samples without SCOPE_PRE history in front of them
+        if (first + SCOPE_BLOCK > SCOPE_PRE)
+        {
+            hit = scope_scan(blk, first < SCOPE_PRE ? SCOPE_PRE - first : 0,
+                             SCOPE_BLOCK, first);
+            if (hit >= 0)
+            {
+                scope_trigger = (uint32_t)hit;
+                scope_state = SCOPE_TRIGGERED;
+            }
+            else if (scope_auto && n >= SCOPE_AUTO_BLOCKS)
+            {
+                scope_trigger = first; // Nothing seen: capture anyway
+                scope_forced = 1;
+                scope_state = SCOPE_TRIGGERED;
+            }
+        }
+    }
+
+    if (scope_state == SCOPE_TRIGGERED && n * SCOPE_BLOCK >= scope_trigger + SCOPE_POST)
+    {
+        TIMER0_CTL_R = 0x00;
+        UDMA_ENACLR_R = 1 << DMA_CH_ADC0SS3;
+        scope_state = SCOPE_FROZEN;
+    }
+}
+
+/***********************************************************
+ * scope_scan() – look for the trigger in s[first..count)
+ * index = sample number of s[0]. Returns the sample number
+ * of the trigger or -1.
+ ***********************************************************/
+int scope_scan(const uint16_t *s, uint32_t first, uint32_t count, uint32_t index)
+{
+    uint32_t i;
+    uint16_t v;
+
+    switch (trig_type)
+    {
+    case TRIG_LEVEL:
+        for (i = first; i < count; i++)
+            if (s[i] >= trig_level)
+                return (int)(index + i);
+        break;
+
+    case TRIG_EDGE_RISE:
+        for (i = first; i < count; i++)
+        {
+            v = s[i];
+            if (!trig_primed)
+                trig_primed = (v + trig_hyst < trig_level);
+            else if (v >= trig_level)
+                return (int)(index + i);
+        }
+        break;
+
+    case TRIG_EDGE_FALL:
+        for (i = first; i < count; i++)
+        {
+            v = s[i];
+            if (!trig_primed)
+                trig_primed = (v > trig_level + trig_hyst);
+            else if (v <= trig_level)
+                return (int)(index + i);
+        }
+        break;
+
+    case TRIG_WINDOW:
+        for (i = first; i < count; i++)
+        {
+            v = s[i];
+            if (v < trig_lo || v > trig_hi)
+                return (int)(index + i);
+        }
+        break;
+    }
+
+    return -1;
+}
+
+/***********************************************************
+ * scope_pack() – count ring samples from pos, two 12-bit
+ * samples in 3 bytes (a low 8 | a high 4, b low 4 | b high 8).
+ * Wraps at the ring end; returns the XOR of the bytes.
+ ***********************************************************/
+uint8_t scope_pack(uint8_t *p, uint32_t pos, uint32_t count)
+{
+    uint32_t i;
+    uint16_t a, b;
+    uint8_t sum = 0;
+
+    for (i = 0; i < count; i += 2)
+    {
+        a = scope_ring[(pos + i) & (SCOPE_RING - 1)];
+        b = scope_ring[(pos + i + 1) & (SCOPE_RING - 1)];
+        p[0] = (uint8_t)a;
+        p[1] = (uint8_t)((a >> 8) | (b << 4));
+        p[2] = (uint8_t)(b >> 4);
+        sum ^= p[0] ^ p[1] ^ p[2];
+        p += 3;
+    }
+
+    return sum;
+}
+
+/***********************************************************
+ * scope_send() – pack the frozen capture and start uDMA TX
+ ***********************************************************/
+void scope_send(void)
+{
+    uint32_t i, n = 0;
+
+    scope_state = SCOPE_SENDING;
+
+    scope_tx[n++] = 'S';
+    scope_tx[n++] = 'C';
+    scope_tx[n++] = 'O';
+    scope_tx[n++] = 'P';
+    for (i = 0; i < 4; i++)
+        scope_tx[n++] = (uint8_t)(SCOPE_RATE >> (8 * i));
+    scope_tx[n++] = (uint8_t)SCOPE_COUNT;
+    scope_tx[n++] = (uint8_t)(SCOPE_COUNT >> 8);
+    scope_tx[n++] = (uint8_t)SCOPE_PRE;
+    scope_tx[n++] = (uint8_t)(SCOPE_PRE >> 8);
+    scope_tx[n++] = trig_type;
+    scope_tx[n++] = scope_forced;
+
+    // Straight from the ring, oldest pre-trigger sample first
+    scope_tx[n + SCOPE_COUNT * 3 / 2] =
+        scope_pack(&scope_tx[n], scope_trigger - SCOPE_PRE, SCOPE_COUNT);
+    n += SCOPE_COUNT * 3 / 2 + 1;
+
+    scope_tx_len = n;
+    scope_tx_sent = 0;
+    scope_tx_next();
+}
+
+/***********************************************************
+ * scope_tx_next() – next uDMA chunk (max 1024 bytes)
+ ***********************************************************/
+void scope_tx_next(void)
+{
+    uint32_t n = scope_tx_len - scope_tx_sent;
+
+    if (n > 1024)
+        n = 1024;
+
+    dma_table[DMA_CH_UART0TX].src_end = (uint32_t)(uintptr_t)&scope_tx[scope_tx_sent + n - 1];
+    dma_table[DMA_CH_UART0TX].dst_end = (uint32_t)(uintptr_t)&UART0_DR_R;
+    dma_table[DMA_CH_UART0TX].ctl = (3u << 30)       // DSTINC: none
+                                    | (0u << 28)     // DSTSIZE: byte
+                                    | (0u << 26)     // SRCINC: byte
+                                    | (0u << 24)     // SRCSIZE: byte
+                                    | (2u << 14)     // ARBSIZE: 4
+                                    | ((n - 1) << 4) // XFERSIZE
+                                    | 0x1;           // Basic mode
+    scope_tx_sent += n;
+    UDMA_ENASET_R = 1 << DMA_CH_UART0TX;
+}
+
+/***********************************************************
+ * UART0_Handler() – uDMA TX chunk done
+ ***********************************************************/
+void UART0_Handler(void)
+{
+    if ((UDMA_CHIS_R & (1 << DMA_CH_UART0TX)) == 0)
+        return;
+
+    UDMA_CHIS_R = 1 << DMA_CH_UART0TX;
+
+    if (scope_tx_sent < scope_tx_len)
+        scope_tx_next();
+    else if (scope_single)
+        scope_state = SCOPE_STOPPED;
+    else
+        scope_arm(); // Next capture
+}
+
+/***********************************************************
+ * scope_command() – one command line from the host
+ ***********************************************************/
+void scope_command(char *line)
+{
+    char *p = line + 1;
+
+    switch (line[0])
+    {
+    case 'l':
+        trig_type = TRIG_LEVEL;
+        trig_level = (uint16_t)parse_number(&p);
+        break;
+    case 'r':
+        trig_type = TRIG_EDGE_RISE;
+        trig_level = (uint16_t)parse_number(&p);
+        break;
+    case 'f':
+        trig_type = TRIG_EDGE_FALL;
+        trig_level = (uint16_t)parse_number(&p);
+        break;
+    case 'w':
+        trig_type = TRIG_WINDOW;
+        trig_lo = (uint16_t)parse_number(&p);
+        trig_hi = (uint16_t)parse_number(&p);
+        break;
+    case 'a':
+        scope_auto = 1;
+        break;
+    case 'n':
+        scope_auto = 0;
+        break;
+    case 's':
+        scope_single = 1;
+        break;
+    case 'g':
+        scope_single = 0;
+        if (scope_state == SCOPE_STOPPED)
+            scope_arm();
+        break;
+    default:
+        break;
+    }
+}
+
+/*** parse_number() – skip spaces, read a decimal number ***/
+uint32_t parse_number(char **p)
+{
+    uint32_t n = 0;
+
+    while (**p == ' ')
+        (*p)++;
+    while (**p >= '0' && **p <= '9')
+        n = n * 10 + (uint32_t)(*(*p)++ - '0');
+
+    return n;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5 = 80 MHz
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0 at 921600 8N1 from an 80 MHz clock, uDMA TX
+ * IBRD = 80 MHz / (16 x 921600) = 5.425 → 5
+ * FBRD = 0.425 x 64 + 0.5 = 27
+ ***********************************************************/
+void UART0_Init(void)
+{
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 5;
+    UART0_FBRD_R = 27;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_DMACTL_R = 0x02; // TXDMAE
+    UART0_CTL_R = 0x301;
+}
@@ -0,0 +1,320 @@
+/***************************************************************
+ * PROJECT NAME : Activity-Adaptive ADC Sampling Rate
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - ADC0 SS3 on PE0 (AIN3), LM35D or LDR divider as in 011_03
+ *      - Timer0A (ADC trigger, period changed at run time)
+ *      - Timer1 (free-running 16 MHz timestamp, 32-bit ticks
+ *        extended to a ms counter that wraps after 49 days)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 011_03 converts as fast as the loop runs, although a room
+ * temperature or light level hardly ever changes. Here the ADC
+ * trigger timer runs slowly while the signal is quiet and
+ * speeds up only while something happens:
+ *
+ *      IDLE   :   10 Hz
+ *      BURST  : 1000 Hz
+ *
+ * Activity metric (ADC0SS3_Handler, every sample):
+ *   activity = |x[n] - x[n-k]|, k = rate / 10
+ *   i.e. the change over the last 100 ms in ADC counts, in both
+ *   modes. A short history ring supplies x[n-k]. Because the
+ *   span is fixed in time, the same thresholds work at both
+ *   rates, and burst mode does not see its own sample-to-
+ *   sample noise as activity.
+ *
+ * Hysteresis (level and time):
+ *   IDLE  → BURST : activity >= ACT_ENTER
+ *   BURST → IDLE  : activity <  ACT_EXIT for HOLD_MS without a
+ *                   break
+ *   ACT_EXIT < ACT_ENTER, so a slowly drifting signal near one
+ *   threshold does not toggle the mode on every sample.
+ *
+ * Mode changes are logged as {time, mode, activity, sample}
+ * in a ring that the main loop prints on UART0, together with
+ * how many samples each mode took, e.g.
+ *      "1234 ms BURST act 52 x 820 (idle 12, burst 0)"
+ *
+ * The sample itself is kept as in 011_03 (result), plus the
+ * LM35 value in 0.1 °C: 10 mV per °C → tenths = millivolts.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 16000000
+#define RATE_IDLE 10    // Hz
+#define RATE_BURST 1000 // Hz
+#define ACT_SPAN_HZ 10  // activity = change over 1 / 10 s
+#define ACT_ENTER 40    // counts per 100 ms (about 32 mV)
+#define ACT_EXIT 10
+#define HOLD_MS 500
+#define HIST_SIZE 128   // power of two, > RATE_BURST / ACT_SPAN_HZ
+#define LOG_SIZE 32     // power of two
+
+enum
+{
+    MODE_IDLE,
+    MODE_BURST,
+};
+
+typedef struct
+{
+    uint32_t time; // ms
+    uint8_t mode;
+    uint8_t reserved;
+    uint16_t activity;
+    uint16_t sample;
+} mode_log_t;
+
+/***********************************************************
+ * SAMPLER STATE
+ ***********************************************************/
+volatile int result;        // latest raw sample (0 - 4095)
+volatile int temp_tenths;   // LM35: 0.1 °C
+
+uint16_t hist[HIST_SIZE];
+uint32_t hist_n;            // samples since the last mode change
+volatile uint8_t mode = MODE_IDLE;
+uint32_t rate_hz = RATE_IDLE;
+uint32_t quiet_since;       // ms, start of the current quiet stretch
+volatile uint32_t samples[2]; // per mode
+
+uint32_t clk_last, clk_frac, clk_ms; // now_ms() state, ISR only
+
+mode_log_t mode_log[LOG_SIZE];
+volatile uint32_t log_head, log_tail;
+
+// Function prototypes
+uint32_t now_ms(void);
+void set_rate(uint32_t hz);
+void set_mode(uint8_t m, uint32_t activity, uint16_t x);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    mode_log_t e;
+
+    /***********************************************************
+     * STEP 1: Enable clocks – GPIO A, E, ADC0, Timer0/1, UART0
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x11;
+    SYSCTL_RCGCADC_R |= 0x01;
+    SYSCTL_RCGCTIMER_R |= 0x03;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x11) != 0x11)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 16 MHz (IBRD 8, FBRD 44)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: PE0 (AIN3) → ADC0 SS3, Timer0A trigger
+     ***********************************************************/
+    GPIO_PORTE_AFSEL_R |= 0x01;
+    GPIO_PORTE_DEN_R &= ~0x01;
+    GPIO_PORTE_AMSEL_R |= 0x01;
+
+    ADC0_ACTSS_R &= ~0x08;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0xF000) | 0x5000; // SS3: timer
+    ADC0_SSMUX3_R = 3;                              // AIN3
+    ADC0_SSCTL3_R = 0x06;                           // END0, IE0
+    ADC0_IM_R |= 0x08;
+    ADC0_ACTSS_R |= 0x08;
+
+    // Timer1: free-running timestamp
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;
+    TIMER1_TAMR_R = 0x02;
+    TIMER1_TAILR_R = 0xFFFFFFFF;
+    TIMER1_CTL_R = 0x01;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02; // Periodic
+    set_rate(RATE_IDLE);
+    TIMER0_CTL_R = 0x21;  // TAOTE (ADC trigger), TAEN
+
+    NVIC_EN0_R = 1 << 17; // IRQ 17 = ADC0 SS3
+    __enable_irq();
+
+    UART0_SendString("\r\nAdaptive sampler ready\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – print the mode log, sleep otherwise
+     ***********************************************************/
+    while (1)
+    {
+        if (log_tail == log_head)
+        {
+            __WFI();
+            continue;
+        }
+
+        e = mode_log[log_tail & (LOG_SIZE - 1)];
+        log_tail++;
+
+        UART0_SendNumber(e.time);
+        UART0_SendString(e.mode == MODE_BURST ? " ms BURST act " : " ms IDLE act ");
+        UART0_SendNumber(e.activity);
+        UART0_SendString(" x ");
+        UART0_SendNumber(e.sample);
+        UART0_SendString(" (idle ");
+        UART0_SendNumber(samples[MODE_IDLE]);
+        UART0_SendString(", burst ");
+        UART0_SendNumber(samples[MODE_BURST]);
+        UART0_SendString(")\r\n");
+    }
+}
+
+/***********************************************************
+ * ADC0SS3_Handler() – new sample: activity and mode control
+ ***********************************************************/
+void ADC0SS3_Handler(void)
+{
+    uint16_t x = (uint16_t)ADC0_SSFIFO3_R;
+    uint32_t k = rate_hz / ACT_SPAN_HZ;
+    uint32_t activity = 0, t = now_ms();
+    uint16_t old;
+
+    ADC0_ISC_R = 0x08;
+
+    result = x;
+    temp_tenths = x * 3300 / 4095; // mV = 0.1 °C for the LM35
+    samples[mode]++;
+
+    // Change over the last 100 ms (0 until that much history exists)
+    if (hist_n >= k)
+    {
+        old = hist[(hist_n - k) & (HIST_SIZE - 1)];
+        activity = (x > old) ? x - old : old - x;
+    }
+    hist[hist_n & (HIST_SIZE - 1)] = x;
+    hist_n++;
+
+    if (mode == MODE_IDLE)
+    {
+        if (activity >= ACT_ENTER)
+            set_mode(MODE_BURST, activity, x);
+    }
+    else
+    {
+        if (activity >= ACT_EXIT)
+            quiet_since = t;
+        else if (t - quiet_since >= HOLD_MS)
+            set_mode(MODE_IDLE, activity, x);
+    }
+}
+
+/***********************************************************
+ * set_mode() – new trigger rate, restart history, log it
+ ***********************************************************/
+void set_mode(uint8_t m, uint32_t activity, uint16_t x)
+{
+    mode_log_t *e;
+
+    mode = m;
+    set_rate(m == MODE_BURST ? RATE_BURST : RATE_IDLE);
+
+    // Old samples are on the other time base
+    hist[0] = x;
+    hist_n = 1;
+    quiet_since = now_ms();
+
+    if ((log_head - log_tail) < LOG_SIZE)
+    {
+        e = &mode_log[log_head & (LOG_SIZE - 1)];
+        e->time = quiet_since;
+        e->mode = m;
+        e->reserved = 0;
+        e->activity = (uint16_t)activity;
+        e->sample = x;
+        log_head++;
+    }
+}
+
+/***********************************************************
+ * set_rate() – Timer0A period; TAV is reloaded so a faster
+ * rate starts at once instead of after the old long period
+ ***********************************************************/
+void set_rate(uint32_t hz)
+{
+    rate_hz = hz;
+    TIMER0_TAILR_R = SYSCLK / hz - 1;
+    TIMER0_TAV_R = SYSCLK / hz - 1;
+}
+
+/***********************************************************
+ * now_ms() – milliseconds from free-running Timer1
+ * Timer1 wraps every 2^32 ticks (268 s), so dividing TAR
+ * itself would jump back to 0 there. The tick difference is
+ * taken modulo 2^32 and added to a ms counter instead; this
+ * stays exact as long as calls are less than 268 s apart,
+ * which the sample interrupt (>= 10 Hz) guarantees.
+ ***********************************************************/
+uint32_t now_ms(void)
+{
+    uint32_t ticks = ~TIMER1_TAR_R; // counts down → up
+
+    clk_frac += ticks - clk_last;
+    clk_last = ticks;
+    clk_ms += clk_frac / (SYSCLK / 1000);
+    clk_frac %= SYSCLK / 1000;
+
+    return clk_ms;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,590 @@
+/***************************************************************
+ * PROJECT NAME : Differential ADC with Two-Point Calibration
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - ADC0 SS1, differential pairs 0 (PE3+/PE2-) and 1 (PE1+/PE0-)
+ *      - Timer0A (1 kHz ADC trigger)
+ *      - uDMA channel 15 (ADC0 SS1, ping-pong blocks)
+ *      - EEPROM (calibration record)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 011_01 - 011_03 read one pin against ground and scale with
+ * the nominal 3.3 V / 4095. A bridge sensor needs the DIFFERENCE
+ * of two pins, and its scale must be calibrated.
+ *
+ * Differential sampling:
+ *   The SSCTL Dn bit of a step turns its SSMUX value into a
+ *   pair number: pair n = AIN(2n) - AIN(2n+1). The result is
+ *      code = 2048 + (Vin+ - Vin-) x 4096 / 6.6 V
+ *   so 0 V difference reads mid-scale. SS1 converts pair 0 and
+ *   pair 1 on every Timer0A trigger; uDMA collects BLOCK_FRAMES
+ *   frames per block (ping-pong, as in 011_04). The uDMA done of
+ *   channel 15 arrives on the SS1 vector; the per-sample SS1
+ *   interrupt stays masked.
+ *
+ * Correction (block path, ADC0SS1_Handler):
+ *   uV = ((code x gain) >> 16) + bias       per channel
+ *   gain is uV per code in Q16, bias is in uV. One multiply-
+ *   add per sample; the channel loop is unrolled (NCH = 2), so
+ *   there is no branch per sample, only the loop counter.
+ *
+ * Two-point calibration (command "c <ch> <uV>"):
+ *   Apply a known difference (e.g. inputs shorted = 0 uV), send
+ *   "c 0 0"; apply a second one (e.g. 1.000000 V), send
+ *   "c 0 1000000". Each point averages CAL_SAMPLES raw codes
+ *   (kept in Q8 for sub-LSB resolution), then
+ *      gain = (uV1 - uV0) / (code1 - code0)
+ *      bias = uV0 - code0 x gain
+ *   A result whose gain or whose uV at code 0 / 4095 does not
+ *   fit in 32 bits is refused. gain and bias are published
+ *   together with interrupts masked, so a block is never
+ *   corrected with the new gain and the old bias.
+ *   "s" stores all channels in EEPROM block 1 with a magic word
+ *   and checksum; the record is loaded at reset. "d" restores
+ *   the nominal scale, "p" prints the coefficients.
+ *
+ * Every 16 blocks (~1 s) the mean of each channel is printed
+ * in uV.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 16000000
+#define NCH 2             // differential pairs
+#define BLOCK_FRAMES 64   // frames (NCH samples) per uDMA block
+#define CAL_SAMPLES 1024
+#define CAL_MAGIC 0x314C4143 // "CAL1"
+#define CAL_EE_BLOCK 1
+#define DMA_CH_ADC0SS1 15
+
+// Nominal: 6.6 V span / 4096 codes = 1611.328 uV per code
+#define GAIN_NOMINAL 105600000 // Q16
+#define BIAS_NOMINAL (-3300000) // code 2048 = 0 uV
+
+/***********************************************************
+ * CALIBRATION DATA (also the EEPROM record layout)
+ ***********************************************************/
+typedef struct
+{
+    int32_t gain; // uV per code, Q16
+    int32_t bias; // uV
+} cal_t;
+
+typedef struct
+{
+    uint32_t magic;
+    cal_t ch[NCH];
+    uint32_t check; // sum of the words above
+} cal_record_t;
+
+cal_record_t cal;
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+uint16_t adc_block[2][BLOCK_FRAMES * NCH];
+int32_t adc_uv[BLOCK_FRAMES * NCH]; // latest corrected block
+volatile int32_t ch_mean[NCH];      // uV, mean of that block
+volatile uint32_t blocks;
+
+// Two-point measurement in progress
+volatile uint8_t cal_active, cal_ch;
+volatile uint32_t cal_n;
+volatile uint32_t cal_sum;
+int32_t cal_pt_code[NCH][2]; // mean code, Q8
+int32_t cal_pt_uv[NCH][2];
+uint8_t cal_pt_count[NCH];
+
+// Function prototypes
+void adc_diff_init(void);
+void adc_dma_block(uint32_t n);
+void cal_apply(const uint16_t *in, int32_t *out, uint32_t frames);
+void cal_defaults(void);
+void cal_publish(uint32_t ch, int32_t gain, int32_t bias);
+int cal_compute(uint32_t ch);
+uint32_t cal_checksum(const cal_record_t *r);
+int eeprom_init(void);
+void eeprom_read(uint32_t block, uint32_t *w, uint32_t n);
+int eeprom_write(uint32_t block, const uint32_t *w, uint32_t n);
+void command(char *line);
+int32_t parse_signed(char **p);
+void print_signed(int32_t v);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    char line[32];
+    uint32_t len = 0, last = 0, i;
+    int32_t uv;
+    int n;
+    char c;
+
+    /***********************************************************
+     * STEP 1: Enable clocks – GPIO A, E, ADC0, Timer0, uDMA,
+     * UART0, EEPROM
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x11;
+    SYSCTL_RCGCADC_R |= 0x01;
+    SYSCTL_RCGCTIMER_R |= 0x01;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x11) != 0x11)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 16 MHz (IBRD 8, FBRD 44)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: Calibration from EEPROM, or nominal values
+     ***********************************************************/
+    cal_defaults();
+    if (eeprom_init() == 0)
+    {
+        eeprom_read(CAL_EE_BLOCK, (uint32_t *)&cal, sizeof(cal) / 4);
+        if (cal.magic != CAL_MAGIC || cal.check != cal_checksum(&cal))
+            cal_defaults();
+        else
+            UART0_SendString("\r\ncalibration loaded");
+    }
+
+    /***********************************************************
+     * STEP 4: Differential SS1 → uDMA blocks
+     ***********************************************************/
+    adc_diff_init();
+    UART0_SendString("\r\nDifferential ADC ready\r\n");
+
+    /***********************************************************
+     * STEP 5: Main loop – commands, calibration, readout
+     ***********************************************************/
+    while (1)
+    {
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            c = (char)UART0_DR_R;
+            if (c == '\r' || c == '\n')
+            {
+                line[len] = 0;
+                if (len)
+                    command(line);
+                len = 0;
+            }
+            else if (len < sizeof(line) - 1)
+            {
+                line[len++] = c;
+            }
+        }
+
+        if (cal_active == 2) // Point measured
+        {
+            i = cal_pt_count[cal_ch] & 1;
+            cal_pt_code[cal_ch][i] = (int32_t)(((uint64_t)cal_sum << 8) / cal_n);
+            cal_pt_count[cal_ch]++;
+            cal_active = 0;
+
+            UART0_SendString("point ");
+            UART0_SendNumber(i);
+            UART0_SendString(" code x256 ");
+            UART0_SendNumber((uint32_t)cal_pt_code[cal_ch][i]);
+            UART0_SendString("\r\n");
+
+            if (cal_pt_count[cal_ch] >= 2)
+            {
+                n = cal_compute(cal_ch);
+                UART0_SendString(n > 0    ? "calibrated\r\n"
+                                 : n == 0 ? "points too close\r\n"
+                                          : "scale out of range\r\n");
+            }
+        }
+
+        if (blocks - last >= 16)
+        {
+            last = blocks;
+            for (i = 0; i < NCH; i++)
+            {
+                uv = ch_mean[i];
+                UART0_SendString(i ? "  ch1 " : "ch0 ");
+                print_signed(uv);
+            }
+            UART0_SendString(" uV\r\n");
+        }
+    }
+}
+
+/***********************************************************
+ * adc_diff_init() – PE0-PE3 analog, SS1 = 2 differential steps
+ ***********************************************************/
+void adc_diff_init(void)
+{
+    GPIO_PORTE_AFSEL_R |= 0x0F;
+    GPIO_PORTE_DEN_R &= ~0x0F;
+    GPIO_PORTE_AMSEL_R |= 0x0F;
+
+    ADC0_ACTSS_R &= ~0x02;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0x00F0) | 0x0050; // SS1: timer
+    ADC0_SSMUX1_R = 0x10;  // Step 0: pair 0, step 1: pair 1
+    ADC0_SSCTL1_R = 0x71;  // D0 | D1, END1, IE1 (uDMA request)
+    ADC0_IM_R = 0;         // No per-frame interrupt
+    ADC0_ACTSS_R |= 0x02;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02;              // Periodic
+    TIMER0_TAILR_R = SYSCLK / 1000 - 1; // 1 kHz frames
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP1_R &= ~0xF0000000; // CH15 → ADC0 SS1
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_ADC0SS1;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_ADC0SS1;
+    adc_dma_block(0);
+    adc_dma_block(1);
+    UDMA_ALTCLR_R = 1 << DMA_CH_ADC0SS1;
+    UDMA_ENASET_R = 1 << DMA_CH_ADC0SS1;
+
+    NVIC_EN0_R = 1 << 15; // IRQ 15 = ADC0 SS1
+    __enable_irq();
+
+    TIMER0_CTL_R = 0x21; // TAOTE (ADC trigger), TAEN
+}
+
+/***********************************************************
+ * adc_dma_block() – block n: even → primary, odd → alternate
+ ***********************************************************/
+void adc_dma_block(uint32_t n)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_ADC0SS1 + ((n & 1) ? 32 : 0)];
+    uint16_t *dst = adc_block[n & 1];
+
+    e->src_end = (uint32_t)(uintptr_t)&ADC0_SSFIFO1_R;
+    e->dst_end = (uint32_t)(uintptr_t)&dst[BLOCK_FRAMES * NCH - 1];
+    e->ctl = (1u << 30)                        // DSTINC: halfword
+             | (1u << 28)                      // DSTSIZE: halfword
+             | (3u << 26)                      // SRCINC: none
+             | (1u << 24)                      // SRCSIZE: halfword
+             | (1u << 14)                      // ARBSIZE: 2 (one frame)
+             | ((BLOCK_FRAMES * NCH - 1) << 4) // XFERSIZE
+             | 0x3;                            // Ping-pong
+}
+
+/***********************************************************
+ * ADC0SS1_Handler() – one block done: correct it, re-arm
+ ***********************************************************/
+void ADC0SS1_Handler(void)
+{
+    uint32_t n = blocks;
+    const uint16_t *in = adc_block[n & 1];
+    int64_t acc[NCH] = {0};
+    uint32_t i, sum;
+
+    UDMA_CHIS_R = 1 << DMA_CH_ADC0SS1; // uDMA done: no ADC status bit
+
+    cal_apply(in, adc_uv, BLOCK_FRAMES);
+
+    for (i = 0; i < BLOCK_FRAMES * NCH; i += NCH)
+    {
+        acc[0] += adc_uv[i];
+        acc[1] += adc_uv[i + 1];
+    }
+    ch_mean[0] = (int32_t)(acc[0] / BLOCK_FRAMES);
+    ch_mean[1] = (int32_t)(acc[1] / BLOCK_FRAMES);
+
+    // Raw codes for a calibration point (one check per block)
+    if (cal_active == 1)
+    {
+        sum = 0;
+        for (i = cal_ch; i < BLOCK_FRAMES * NCH; i += NCH)
+            sum += in[i];
+        cal_sum += sum;
+        cal_n += BLOCK_FRAMES;
+        if (cal_n >= CAL_SAMPLES)
+            cal_active = 2;
+    }
+
+    adc_dma_block(n + 2); // Same buffer, same structure
+    blocks = n + 1;
+}
+
+/***********************************************************
+ * cal_apply() – uV = ((code x gain) >> 16) + bias, NCH = 2
+ * The coefficients are loaded once per block; the loop body
+ * is two multiply-adds (SMULL + ADD on the Cortex-M4).
+ ***********************************************************/
+void cal_apply(const uint16_t *in, int32_t *out, uint32_t frames)
+{
+    const int32_t g0 = cal.ch[0].gain, b0 = cal.ch[0].bias;
+    const int32_t g1 = cal.ch[1].gain, b1 = cal.ch[1].bias;
+
+    while (frames--)
+    {
+        out[0] = (int32_t)(((int64_t)in[0] * g0) >> 16) + b0;
+        out[1] = (int32_t)(((int64_t)in[1] * g1) >> 16) + b1;
+        in += NCH;
+        out += NCH;
+    }
+}
+
+/*** cal_defaults() – nominal 6.6 V / 4096, mid-scale = 0 ***/
+void cal_defaults(void)
+{
+    uint32_t i;
+
+    cal.magic = CAL_MAGIC;
+    for (i = 0; i < NCH; i++)
+        cal_publish(i, GAIN_NOMINAL, BIAS_NOMINAL);
+}
+
+/***********************************************************
+ * cal_publish() – new gain and bias of ch, as one update
+ * ADC0SS1_Handler reads both at the start of a block; with
+ * interrupts masked it sees either the old pair or the new.
+ ***********************************************************/
+void cal_publish(uint32_t ch, int32_t gain, int32_t bias)
+{
+    __disable_irq();
+    cal.ch[ch].gain = gain;
+    cal.ch[ch].bias = bias;
+    cal.check = cal_checksum(&cal);
+    __enable_irq();
+}
+
+/*** cal_checksum() – sum of every word before "check" ***/
+uint32_t cal_checksum(const cal_record_t *r)
+{
+    const uint32_t *w = (const uint32_t *)r;
+    uint32_t i, sum = 0x5A5A5A5A;
+
+    for (i = 0; i < sizeof(*r) / 4 - 1; i++)
+        sum += w[i];
+    return sum;
+}
+
+/***********************************************************
+ * cal_compute() – gain and bias from the two points of ch
+ * Codes are Q8, so gain (Q16) = duV << 24 / dcode.
+ * Returns 1 if applied, 0 if the points are too close, -1 if
+ * gain, bias or the corrected range would overflow int32.
+ ***********************************************************/
+int cal_compute(uint32_t ch)
+{
+    int64_t dcode = cal_pt_code[ch][1] - cal_pt_code[ch][0];
+    int64_t duv = (int64_t)cal_pt_uv[ch][1] - cal_pt_uv[ch][0];
+    int64_t gain, bias, top;
+
+    if (dcode > -64 * 256 && dcode < 64 * 256) // < 64 codes apart
+        return 0;
+
+    gain = (duv << 24) / dcode;
+    if (gain > INT32_MAX || gain < INT32_MIN)
+        return -1;
+    bias = cal_pt_uv[ch][0] - ((cal_pt_code[ch][0] * gain) >> 24);
+    top = ((4095 * gain) >> 16) + bias; // cal_apply() at full scale
+    if (bias > INT32_MAX || bias < INT32_MIN || top > INT32_MAX || top < INT32_MIN)
+        return -1;
+
+    cal_publish(ch, (int32_t)gain, (int32_t)bias);
+    return 1;
+}
+
+/***********************************************************
+ * EEPROM
+ * eeprom_init() follows the datasheet start-up sequence:
+ * wait for WORKING to clear, check the retry flags, reset the
+ * module and check again. Returns 0 when usable.
+ ***********************************************************/
+int eeprom_init(void)
+{
+    volatile uint32_t delay;
+
+    SYSCTL_RCGCEEPROM_R |= 0x01;
+    for (delay = 0; delay < 6; delay++)
+        ;
+
+    while (EEPROM_EEDONE_R & 0x01) // WORKING
+        ;
+    if (EEPROM_EESUPP_R & 0x0C) // PRETRY / ERETRY
+        return -1;
+
+    SYSCTL_SREEPROM_R = 0x01;
+    SYSCTL_SREEPROM_R = 0x00;
+    for (delay = 0; delay < 6; delay++)
+        ;
+
+    while (EEPROM_EEDONE_R & 0x01)
+        ;
+    if (EEPROM_EESUPP_R & 0x0C)
+        return -1;
+
+    return 0;
+}
+
+/*** eeprom_read() – n words from offset 0 of block ***/
+void eeprom_read(uint32_t block, uint32_t *w, uint32_t n)
+{
+    EEPROM_EEBLOCK_R = block;
+    EEPROM_EEOFFSET_R = 0;
+    while (n--)
+        *w++ = EEPROM_EERDWRINC_R;
+}
+
+/*** eeprom_write() – n words to offset 0 of block, 0 = ok ***/
+int eeprom_write(uint32_t block, const uint32_t *w, uint32_t n)
+{
+    EEPROM_EEBLOCK_R = block;
+    EEPROM_EEOFFSET_R = 0;
+    while (n--)
+    {
+        EEPROM_EERDWRINC_R = *w++;
+        while (EEPROM_EEDONE_R & 0x01) // WORKING
+            ;
+        if (EEPROM_EEDONE_R & 0x1C) // NOPERM, WKCOPY, WKERASE
+            return -1;
+    }
+    return 0;
+}
+
+/***********************************************************
+ * command() – c <ch> <uV>, s, d, p
+ ***********************************************************/
+void command(char *line)
+{
+    char *p = line + 1;
+    int32_t ch;
+    uint32_t i;
+
+    switch (line[0])
+    {
+    case 'c': // Measure one calibration point
+        ch = parse_signed(&p);
+        if (ch < 0 || ch >= NCH || cal_active)
+            break;
+        cal_pt_uv[ch][cal_pt_count[ch] & 1] = parse_signed(&p);
+        cal_sum = 0;
+        cal_n = 0;
+        cal_ch = (uint8_t)ch;
+        cal_active = 1;
+        break;
+
+    case 's':
+        UART0_SendString(eeprom_write(CAL_EE_BLOCK, (const uint32_t *)&cal, sizeof(cal) / 4) == 0
+                             ? "saved\r\n"
+                             : "EEPROM error\r\n");
+        break;
+
+    case 'd':
+        cal_defaults();
+        break;
+
+    case 'p':
+        for (i = 0; i < NCH; i++)
+        {
+            UART0_SendString("ch");
+            UART0_SendNumber(i);
+            UART0_SendString(" gain ");
+            print_signed(cal.ch[i].gain);
+            UART0_SendString(" bias ");
+            print_signed(cal.ch[i].bias);
+            UART0_SendString("\r\n");
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*** parse_signed() – skip spaces, read an optional '-' and digits ***/
+int32_t parse_signed(char **p)
+{
+    int32_t n = 0, neg = 0;
+
+    while (**p == ' ')
+        (*p)++;
+    if (**p == '-')
+    {
+        neg = 1;
+        (*p)++;
+    }
+    while (**p >= '0' && **p <= '9')
+        n = n * 10 + (*(*p)++ - '0');
+
+    return neg ? -n : n;
+}
+
+/*** print_signed() – signed decimal ***/
+void print_signed(int32_t v)
+{
+    if (v < 0)
+    {
+        UART0Tx('-');
+        UART0_SendNumber((uint32_t)-v);
+    }
+    else
+    {
+        UART0_SendNumber((uint32_t)v);
+    }
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
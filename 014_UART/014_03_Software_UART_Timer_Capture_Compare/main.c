@@ -0,0 +1,457 @@
+/***************************************************************
+ * PROJECT NAME : Software UART with Timer Capture / Compare
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad) @ 80 MHz (PLL)
+ * MODULES USED :
+ *      - Wide Timer 0 : A = RX edge capture (PC4 = WT0CCP0)
+ *                       B = bit scheduler (match interrupt)
+ *                       TX = PC5 (GPIO)
+ *      - Wide Timer 1 : A = RX edge capture (PC6 = WT1CCP0)
+ *                       B = bit scheduler, TX = PC7 (GPIO)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 014_01 and 014_02 use the hardware UARTs. When those run out,
+ * this driver adds more 8N1 ports on ordinary pins. Each
+ * instance uses ONE wide timer; both halves are started with
+ * the same write, so they count down in lock step from
+ * 0xFFFFFFFF and their values can be compared directly:
+ *
+ *   RX start bit : timer A in edge-time capture mode latches the
+ *                  exact time of the falling edge in TAR. The
+ *                  capture interrupt is then masked for the rest
+ *                  of the character (data edges are ignored).
+ *
+ *   Scheduler    : timer B runs free with a MATCH interrupt.
+ *                  TBMATCHR is always set to the nearest pending
+ *                  event of this instance:
+ *                      TX : next bit edge (start, 8 data, stop)
+ *                      RX : middle of the next bit
+ *                  RX samples are placed at edge + 0.5, 1.5, ...
+ *                  bit times from the CAPTURED edge, so the
+ *                  interrupt latency of the capture ISR does not
+ *                  shift the sampling point.
+ *
+ *   Bounded ISR cost: one match interrupt per bit per direction
+ *   (10 per character), one capture interrupt per received
+ *   character. Nothing is ever polled or busy-waited.
+ *
+ * API (same ring-buffer style as UART0_Read() in 016):
+ *      suart_write(u, c)   → queue one byte, waits only if full
+ *      suart_read(u, &c)   → 1 and the byte, or 0 if empty
+ *
+ * Demo: text typed on the PC (UART0) is sent on both soft UARTs;
+ * whatever they receive is printed as "[0] ..." / "[1] ...".
+ * Connect PC5 → PC6 and PC7 → PC4 to loop the two ports.
+ *
+ * NOTE :
+ * Time in the driver is the count-up value ~TBV, so all event
+ * times are plain unsigned numbers and (int32_t)(a - b) orders
+ * them even across the 53 s wrap of the 32-bit timer.
+ *
+ * CPU budget at 115200 baud (80 MHz): 1 bit = 694 clocks. One
+ * scheduler interrupt costs roughly 60 - 100 clocks including
+ * entry and exit, so one full-duplex port at full speed takes
+ * about 20 - 30 % of the CPU. Lower baud rates cost
+ * proportionally less.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define SUART_BAUD 115200
+#define SUART_RING_SIZE 64 // power of two
+#define SUART_MIN_LEAD 64  // clocks; closer events are handled at once
+
+/***********************************************************
+ * ONE SOFTWARE UART INSTANCE
+ ***********************************************************/
+typedef struct
+{
+    // Hardware: timer registers and pin windows (DATA_BITS[mask])
+    volatile uint32_t *tar;      // A: captured edge time
+    volatile uint32_t *tbv;      // B: free-running value
+    volatile uint32_t *tbmatchr; // B: next event
+    volatile uint32_t *imr;
+    volatile uint32_t *icr;
+    volatile uint32_t *tx_pin;
+    volatile uint32_t *rx_pin;
+    uint32_t bit_ticks;
+
+    // TX: ring + shift register
+    volatile uint8_t tx_ring[SUART_RING_SIZE];
+    volatile uint32_t tx_head, tx_tail;
+    volatile uint8_t tx_busy;
+    uint16_t tx_frame; // start + 8 data + stop, LSB first
+    uint8_t tx_bits;   // bits left in tx_frame
+    uint32_t tx_next;  // time of the next TX edge
+
+    // RX: ring + shift register
+    volatile uint8_t rx_ring[SUART_RING_SIZE];
+    volatile uint32_t rx_head, rx_tail;
+    uint16_t rx_shift;
+    uint8_t rx_bits;  // samples left, 0 = waiting for start bit
+    uint32_t rx_next; // time of the next RX sample
+
+    volatile uint32_t rx_framing_errors;
+    volatile uint32_t rx_overruns;
+} suart_t;
+
+#define TIMER_IMR_CAEIM 0x004 // A capture event
+#define TIMER_IMR_TBMIM 0x800 // B match
+
+#define SUART_HW(n, tx_mask, rx_mask)                          \
+    {                                                          \
+        &WTIMER##n##_TAR_R, &WTIMER##n##_TBV_R,                \
+        &WTIMER##n##_TBMATCHR_R, &WTIMER##n##_IMR_R,           \
+        &WTIMER##n##_ICR_R, &GPIO_PORTC_DATA_BITS_R[tx_mask],  \
+        &GPIO_PORTC_DATA_BITS_R[rx_mask],                      \
+        (SYSCLK + SUART_BAUD / 2) / SUART_BAUD,                \
+    }
+
+suart_t suart[2] = {
+    SUART_HW(0, 0x20, 0x10), // TX PC5, RX PC4
+    SUART_HW(1, 0x80, 0x40), // TX PC7, RX PC6
+};
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void UART0_Init(void);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void suart_init(void);
+void suart_write(suart_t *u, char c);
+int suart_read(suart_t *u, char *c);
+void suart_schedule(suart_t *u);
+void suart_capture_isr(suart_t *u);
+void suart_timer_isr(suart_t *u);
+
+int main(void)
+{
+    char c;
+    int i;
+
+    PLL_Init80MHz();
+    UART0_Init();
+    suart_init();
+
+    UART0_SendString("\r\nsoftware UARTs ready\r\n");
+
+    /***********************************************************
+     * Main loop – PC → both soft UARTs, soft UARTs → PC
+     ***********************************************************/
+    while (1)
+    {
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            c = (char)UART0_DR_R;
+            suart_write(&suart[0], c);
+            suart_write(&suart[1], c);
+        }
+
+        for (i = 0; i < 2; i++)
+        {
+            while (suart_read(&suart[i], &c))
+            {
+                UART0_SendString(i ? "[1] " : "[0] ");
+                UART0Tx(c);
+                UART0_SendString("\r\n");
+            }
+        }
+    }
+}
+
+/***********************************************************
+ * suart_init() – pins and wide timers 0 / 1
+ ***********************************************************/
+void suart_init(void)
+{
+    SYSCTL_RCGCGPIO_R |= 0x04;   // Port C
+    SYSCTL_RCGCWTIMER_R |= 0x03; // Wide Timer 0, 1
+    while ((SYSCTL_PRGPIO_R & 0x04) == 0)
+        ;
+    while ((SYSCTL_PRWTIMER_R & 0x03) != 0x03)
+        ;
+
+    // PC4, PC6 = WTnCCP0 (RX, pull-up), PC5, PC7 = GPIO TX idle HIGH
+    GPIO_PORTC_AFSEL_R |= 0x50;
+    GPIO_PORTC_PCTL_R = (GPIO_PORTC_PCTL_R & ~0x0F0F0000) | 0x07070000;
+    GPIO_PORTC_PUR_R |= 0x50;
+    GPIO_PORTC_DATA_R |= 0xA0;
+    GPIO_PORTC_DIR_R |= 0xA0;
+    GPIO_PORTC_DEN_R |= 0xF0;
+
+    /*
+     * Both halves: 32-bit, count down from 0xFFFFFFFF.
+     * A: capture, edge-time, falling edge (TAEVENT = 01)
+     * B: periodic with match interrupt enable (TBMIE)
+     */
+    WTIMER0_CTL_R = 0x00;
+    WTIMER0_CFG_R = 0x04;        // Two 32-bit timers
+    WTIMER0_TAMR_R = 0x07;       // TACMR = edge time, TAMR = capture
+    WTIMER0_TBMR_R = 0x22;       // TBMIE, periodic
+    WTIMER0_TAILR_R = 0xFFFFFFFF;
+    WTIMER0_TBILR_R = 0xFFFFFFFF;
+    WTIMER0_ICR_R = TIMER_IMR_CAEIM | TIMER_IMR_TBMIM;
+    WTIMER0_IMR_R = TIMER_IMR_CAEIM;
+    WTIMER0_CTL_R = 0x0105;      // TBEN, TAEVENT = falling, TAEN (same write)
+
+    WTIMER1_CTL_R = 0x00;
+    WTIMER1_CFG_R = 0x04;
+    WTIMER1_TAMR_R = 0x07;
+    WTIMER1_TBMR_R = 0x22;
+    WTIMER1_TAILR_R = 0xFFFFFFFF;
+    WTIMER1_TBILR_R = 0xFFFFFFFF;
+    WTIMER1_ICR_R = TIMER_IMR_CAEIM | TIMER_IMR_TBMIM;
+    WTIMER1_IMR_R = TIMER_IMR_CAEIM;
+    WTIMER1_CTL_R = 0x0105;
+
+    // IRQ 94 / 95 = WTIMER0A / B, IRQ 96 / 97 = WTIMER1A / B
+    NVIC_EN2_R = (1u << (94 - 64)) | (1u << (95 - 64));
+    NVIC_EN3_R = (1u << (96 - 96)) | (1u << (97 - 96));
+    __enable_irq();
+}
+
+/***********************************************************
+ * suart_write() – queue one byte, start TX if it was idle
+ ***********************************************************/
+void suart_write(suart_t *u, char c)
+{
+    while ((u->tx_head - u->tx_tail) >= SUART_RING_SIZE)
+        ; // Ring full: wait for the ISR
+
+    u->tx_ring[u->tx_head & (SUART_RING_SIZE - 1)] = (uint8_t)c;
+    u->tx_head++;
+
+    __disable_irq();
+    if (!u->tx_busy)
+    {
+        u->tx_busy = 1;
+        u->tx_bits = 0; // Scheduler loads the byte at tx_next
+        u->tx_next = ~*u->tbv + SUART_MIN_LEAD;
+        suart_schedule(u);
+    }
+    __enable_irq();
+}
+
+/***********************************************************
+ * suart_read() – non-blocking read from the RX ring
+ * Returns 1 and stores the byte in *c, or 0 if empty.
+ ***********************************************************/
+int suart_read(suart_t *u, char *c)
+{
+    if (u->rx_tail == u->rx_head)
+        return 0;
+
+    *c = (char)u->rx_ring[u->rx_tail & (SUART_RING_SIZE - 1)];
+    u->rx_tail++;
+    return 1;
+}
+
+/***********************************************************
+ * suart_capture_isr() – falling edge of a start bit
+ * The first sample (start bit check) is half a bit after the
+ * captured edge, then 9 more at one bit spacing.
+ ***********************************************************/
+void suart_capture_isr(suart_t *u)
+{
+    uint32_t edge = ~*u->tar; // Count-up time of the edge
+
+    *u->icr = TIMER_IMR_CAEIM;
+    *u->imr &= ~TIMER_IMR_CAEIM; // Ignore data edges
+
+    u->rx_shift = 0;
+    u->rx_bits = 10; // start + 8 data + stop
+    u->rx_next = edge + u->bit_ticks / 2;
+    suart_schedule(u);
+}
+
+/***********************************************************
+ * suart_timer_isr() – timer B match: run every due event
+ ***********************************************************/
+void suart_timer_isr(suart_t *u)
+{
+    *u->icr = TIMER_IMR_TBMIM;
+    suart_schedule(u);
+}
+
+/***********************************************************
+ * suart_schedule() – handle due events, program the next match
+ * An event is due when its time is less than SUART_MIN_LEAD
+ * clocks away; it is handled now instead of risking a match
+ * value the counter has already passed.
+ ***********************************************************/
+void suart_schedule(suart_t *u)
+{
+    uint32_t now, next = 0;
+    uint16_t bit;
+    int pending;
+
+    while (1)
+    {
+        now = ~*u->tbv;
+        pending = 0;
+
+        // TX edge
+        if (u->tx_busy && (int32_t)(u->tx_next - now) < SUART_MIN_LEAD)
+        {
+            if (u->tx_bits == 0) // Between characters
+            {
+                if (u->tx_tail == u->tx_head)
+                {
+                    u->tx_busy = 0; // Nothing more to send
+                }
+                else
+                {
+                    u->tx_frame = (uint16_t)(0x200 | (u->tx_ring[u->tx_tail & (SUART_RING_SIZE - 1)] << 1));
+                    u->tx_tail++;
+                    u->tx_bits = 10;
+                }
+            }
+            if (u->tx_bits)
+            {
+                *u->tx_pin = (u->tx_frame & 1) ? 0xFF : 0x00;
+                u->tx_frame >>= 1;
+                u->tx_bits--;
+                u->tx_next += u->bit_ticks;
+            }
+        }
+
+        // RX sample
+        if (u->rx_bits && (int32_t)(u->rx_next - now) < SUART_MIN_LEAD)
+        {
+            bit = (*u->rx_pin != 0);
+            u->rx_shift = (uint16_t)((u->rx_shift >> 1) | (bit << 9));
+            u->rx_next += u->bit_ticks;
+
+            if (u->rx_bits == 10 && bit)
+            {
+                u->rx_bits = 0; // Glitch, not a start bit
+            }
+            else if (--u->rx_bits == 0)
+            {
+                if ((u->rx_shift & 0x201) != 0x200) // start 0, stop 1
+                    u->rx_framing_errors++;
+                else if ((u->rx_head - u->rx_tail) >= SUART_RING_SIZE)
+                    u->rx_overruns++;
+                else
+                {
+                    u->rx_ring[u->rx_head & (SUART_RING_SIZE - 1)] = (uint8_t)(u->rx_shift >> 1);
+                    u->rx_head++;
+                }
+            }
+
+            if (u->rx_bits == 0) // Wait for the next start edge
+            {
+                *u->icr = TIMER_IMR_CAEIM;
+                *u->imr |= TIMER_IMR_CAEIM;
+            }
+        }
+
+        // Nearest remaining event
+        if (u->tx_busy)
+        {
+            next = u->tx_next;
+            pending = 1;
+        }
+        if (u->rx_bits && (!pending || (int32_t)(u->rx_next - next) < 0))
+        {
+            next = u->rx_next;
+            pending = 1;
+        }
+
+        if (!pending)
+        {
+            *u->imr &= ~TIMER_IMR_TBMIM;
+            return;
+        }
+
+        *u->tbmatchr = ~next; // Back to count-down value
+        *u->imr |= TIMER_IMR_TBMIM;
+
+        // Still far enough ahead after programming? Then done.
+        if ((int32_t)(next - ~*u->tbv) >= SUART_MIN_LEAD)
+            return;
+    }
+}
+
+/***********************************************************
+ * Interrupt handlers – one capture and one match per instance
+ ***********************************************************/
+void WTIMER0A_Handler(void)
+{
+    suart_capture_isr(&suart[0]);
+}
+
+void WTIMER0B_Handler(void)
+{
+    suart_timer_isr(&suart[0]);
+}
+
+void WTIMER1A_Handler(void)
+{
+    suart_capture_isr(&suart[1]);
+}
+
+void WTIMER1B_Handler(void)
+{
+    suart_timer_isr(&suart[1]);
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5 = 80 MHz
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0 at 115200 8N1 from an 80 MHz clock
+ * IBRD = 80 MHz / (16 x 115200) = 43.40 → 43
+ * FBRD = 0.40 x 64 + 0.5 = 26
+ ***********************************************************/
+void UART0_Init(void)
+{
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+}
+
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ;
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
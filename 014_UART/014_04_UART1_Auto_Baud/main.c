@@ -0,0 +1,377 @@
+/***************************************************************
+ * PROJECT NAME : UART1 Auto-Baud Detection from RX Edge Timing
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad) @ 80 MHz (PLL)
+ * MODULES USED :
+ *      - UART1 (PB0 = RX, PB1 = TX) → field device / TTL converter
+ *      - Timer2A edge-time capture on PB0 (T2CCP0)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1 log
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 014_02 runs UART1 at a fixed 9600 baud (IBRD 104, FBRD 11).
+ * Here the baud rate is measured from the first character the
+ * device sends, and UART1 is reprogrammed on the fly.
+ *
+ * Sync character 'U' (0x55) on the wire, LSB first:
+ *
+ *      idle  S  1  0  1  0  1  0  1  0  P  idle
+ *      ‾‾‾‾‾|__|‾‾|__|‾‾|__|‾‾|__|‾‾|__|‾‾‾‾‾‾‾‾
+ *           t0 t1 t2 t3 t4 t5 t6 t7 t8 t9
+ *
+ * Every bit changes level, so there are 10 edges and
+ * t9 - t0 is exactly 9 bit times.
+ *
+ *   1. autobaud_start() switches PB0 from U1RX to T2CCP0 and
+ *      arms Timer2A as a 24-bit edge-time capture on both edges.
+ *   2. TIMER2A_Handler stores the edge times. Each interval must
+ *      be within ±25 % of the first one, otherwise counting
+ *      starts again (noise, or a character other than 'U').
+ *   3. At edge t9 (start of the stop bit) the divisor is
+ *      computed WITHOUT floating point. With T = t9 - t0 in
+ *      system clocks, one bit is T / 9 clocks and the UART needs
+ *          BRD = clocks per bit / 16
+ *      In 1/64 steps (IBRD.FBRD):
+ *          BRD x 64 = 4 x T / 9
+ *          IBRD = BRD64 >> 6,  FBRD = BRD64 & 63
+ *      If the result is within 2 % of a standard rate, the exact
+ *      divisor of that rate is used instead.
+ *   4. UART1 gets the new divisor and PB0 goes back to U1RX
+ *      while the stop bit is still on the line, so the very next
+ *      character is received normally.
+ *
+ * Detection latency is therefore ONE character. A received
+ * BREAK, or 4 framing errors in a row, starts detection again
+ * (the device changed its rate).
+ *
+ * Resolution: at 115200 baud T = 6250 clocks, so the measured
+ * rate is accurate to about 0.02 %.
+ *
+ * Highest rate: 460800 baud (174 clocks per bit). Every edge of
+ * the sync character is one capture interrupt; at 921600 baud a
+ * bit is only 87 clocks, less than the handler with interrupt
+ * entry and exit, so edges would be lost and it is not offered.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define AB_EDGES 10      // edges of 'U'
+#define AB_MAX_FE 4      // framing errors in a row → re-detect
+#define UART_RING_SIZE 64
+
+static const uint32_t std_baud[] = {
+    1200, 2400, 4800, 9600, 14400, 19200, 38400, 57600, 115200, 230400, 460800,
+};
+
+volatile uint8_t ab_active;   // 1 while waiting for the sync character
+uint8_t ab_edges;
+uint32_t ab_time[AB_EDGES];   // captured edge times (24-bit, count down)
+
+volatile uint32_t ab_baud;    // detected rate (0 = none yet)
+volatile uint8_t ab_done;     // set by the ISR, cleared by main
+uint8_t fe_count;
+
+volatile uint8_t uart1_rx_ring[UART_RING_SIZE];
+volatile uint32_t uart1_rx_head, uart1_rx_tail;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void UART0_Init(void);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+void UART1Tx(char c);
+int UART1_Read(char *c);
+void autobaud_start(void);
+void autobaud_finish(void);
+
+int main(void)
+{
+    char c;
+
+    PLL_Init80MHz();
+    UART0_Init();
+
+    /***********************************************************
+     * STEP 1: UART1 on PB0 / PB1, RX and error interrupts
+     ***********************************************************/
+    SYSCTL_RCGCUART_R |= 0x02;  // UART1
+    SYSCTL_RCGCGPIO_R |= 0x02;  // Port B
+    SYSCTL_RCGCTIMER_R |= 0x04; // Timer2
+    while ((SYSCTL_PRGPIO_R & 0x02) == 0)
+        ;
+
+    GPIO_PORTB_AFSEL_R |= 0x03;
+    GPIO_PORTB_PUR_R |= 0x01; // RX idles HIGH when unplugged
+    GPIO_PORTB_DEN_R |= 0x03;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0xFF) | 0x11;
+
+    UART1_CTL_R = 0x00;
+    UART1_IBRD_R = 520; // 9600 at 80 MHz until the first detection
+    UART1_FBRD_R = 53;
+    UART1_LCRH_R = 0x70; // 8-bit, FIFO enable
+    UART1_CC_R = 0x00;
+    UART1_IFLS_R = 0x10;  // RX interrupt at 1/2 full
+    UART1_IM_R = 0x2D0;   // BEIM (9), FEIM (7), RTIM (6), RXIM (4)
+    UART1_CTL_R = 0x301;
+
+    NVIC_EN0_R = (1 << 6) | (1 << 23); // IRQ 6 = UART1, IRQ 23 = Timer2A
+    __enable_irq();
+
+    UART0_SendString("\r\nauto-baud: send 'U' on UART1\r\n");
+    autobaud_start();
+
+    /***********************************************************
+     * STEP 2: Report detections, echo UART1 traffic
+     ***********************************************************/
+    while (1)
+    {
+        if (ab_done)
+        {
+            ab_done = 0;
+            UART0_SendString("baud ");
+            UART0_SendNumber(ab_baud);
+            UART0_SendString(" IBRD ");
+            UART0_SendNumber(UART1_IBRD_R);
+            UART0_SendString(" FBRD ");
+            UART0_SendNumber(UART1_FBRD_R);
+            UART0_SendString("\r\n");
+        }
+
+        while (UART1_Read(&c))
+        {
+            UART1Tx(c); // Echo at the detected rate
+            UART0Tx(c);
+        }
+    }
+}
+
+/***********************************************************
+ * autobaud_start() – route PB0 to Timer2A and wait for 'U'
+ * Timer2A: 16-bit + 8-bit prescaler = 24-bit count down,
+ * edge-time capture on both edges (TAEVENT = 11).
+ ***********************************************************/
+void autobaud_start(void)
+{
+    ab_active = 1;
+    ab_edges = 0;
+
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0x0F) | 0x07; // PB0 = T2CCP0
+
+    TIMER2_CTL_R = 0x00;
+    TIMER2_CFG_R = 0x04;  // 16-bit (with prescaler → 24-bit)
+    TIMER2_TAMR_R = 0x07; // Capture, edge time, count down
+    TIMER2_TAILR_R = 0xFFFF;
+    TIMER2_TAPR_R = 0xFF;
+    TIMER2_ICR_R = 0x04;
+    TIMER2_IMR_R = 0x04;  // CAEIM
+    TIMER2_CTL_R = 0x0D;  // TAEVENT = both edges, TAEN
+}
+
+/***********************************************************
+ * TIMER2A_Handler() – one RX edge
+ * The first edge must be a falling one (start bit); the pin
+ * reads LOW right after it.
+ ***********************************************************/
+void TIMER2A_Handler(void)
+{
+    uint32_t t, first, span;
+
+    TIMER2_ICR_R = 0x04;
+    t = TIMER2_TAR_R & 0x00FFFFFF;
+
+    if (ab_edges == 0 && (GPIO_PORTB_DATA_R & 0x01))
+        return; // Rising edge: not a start bit
+
+    if (ab_edges >= 2)
+    {
+        first = (ab_time[0] - ab_time[1]) & 0x00FFFFFF;   // count down
+        span = (ab_time[ab_edges - 1] - t) & 0x00FFFFFF;
+        if (span < first - first / 4 || span > first + first / 4)
+        {
+            // Not a 'U' at one rate: restart from this edge if it
+            // could be a start bit
+            ab_edges = 0;
+            if (GPIO_PORTB_DATA_R & 0x01)
+                return;
+        }
+    }
+
+    ab_time[ab_edges++] = t;
+
+    if (ab_edges == AB_EDGES)
+        autobaud_finish();
+}
+
+/***********************************************************
+ * autobaud_finish() – divisor from t0..t9, back to U1RX
+ ***********************************************************/
+void autobaud_finish(void)
+{
+    uint32_t span, brd64, baud, lo, hi;
+    unsigned int i;
+
+    span = (ab_time[0] - ab_time[AB_EDGES - 1]) & 0x00FFFFFF; // 9 bits
+    brd64 = (4 * span + 4) / 9;                                // round
+    baud = (9 * SYSCLK) / span;
+
+    // Snap to a standard rate within ±2 %
+    for (i = 0; i < sizeof(std_baud) / sizeof(std_baud[0]); i++)
+    {
+        lo = std_baud[i] - std_baud[i] / 50;
+        hi = std_baud[i] + std_baud[i] / 50;
+        if (baud >= lo && baud <= hi)
+        {
+            baud = std_baud[i];
+            brd64 = (SYSCLK * 4 + baud / 2) / baud; // exact divisor x 64
+            break;
+        }
+    }
+
+    TIMER2_IMR_R = 0x00;
+    TIMER2_CTL_R = 0x00;
+
+    // New divisor: LCRH must be written after IBRD / FBRD
+    UART1_CTL_R &= ~0x01;
+    UART1_IBRD_R = brd64 >> 6;
+    UART1_FBRD_R = brd64 & 0x3F;
+    UART1_LCRH_R = 0x70;
+    UART1_ECR_R = 0; // Clear old errors
+    UART1_CTL_R |= 0x01;
+
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0x0F) | 0x01; // PB0 = U1RX
+
+    fe_count = 0;
+    ab_baud = baud;
+    ab_active = 0;
+    ab_done = 1;
+}
+
+/***********************************************************
+ * UART1_Handler() – RX ring, BREAK / framing error watch
+ * DR bit 10 = BE, bit 8 = FE.
+ ***********************************************************/
+void UART1_Handler(void)
+{
+    uint32_t data;
+
+    UART1_ICR_R = 0x2D0;
+
+    while ((UART1_FR_R & 0x10) == 0)
+    {
+        data = UART1_DR_R;
+
+        if (data & 0x500)
+        {
+            if ((data & 0x400) || ++fe_count >= AB_MAX_FE)
+            {
+                if (!ab_active)
+                    autobaud_start(); // Device changed its rate
+            }
+            continue;
+        }
+
+        fe_count = 0;
+        if ((uart1_rx_head - uart1_rx_tail) < UART_RING_SIZE)
+        {
+            uart1_rx_ring[uart1_rx_head & (UART_RING_SIZE - 1)] = (uint8_t)data;
+            uart1_rx_head++;
+        }
+    }
+}
+
+/***********************************************************
+ * UART1_Read() – non-blocking read from the RX ring
+ ***********************************************************/
+int UART1_Read(char *c)
+{
+    if (uart1_rx_tail == uart1_rx_head)
+        return 0;
+
+    *c = (char)uart1_rx_ring[uart1_rx_tail & (UART_RING_SIZE - 1)];
+    uart1_rx_tail++;
+    return 1;
+}
+
+void UART1Tx(char c)
+{
+    while ((UART1_FR_R & 0x20) != 0)
+        ;
+    UART1_DR_R = c;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5 = 80 MHz
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0 at 115200 8N1 from an 80 MHz clock
+ * IBRD = 80 MHz / (16 x 115200) = 43.40 → 43
+ * FBRD = 0.40 x 64 + 0.5 = 26
+ ***********************************************************/
+void UART0_Init(void)
+{
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+}
+
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ;
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
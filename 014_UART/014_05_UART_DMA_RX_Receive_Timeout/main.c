@@ -0,0 +1,389 @@
+/***************************************************************
+ * PROJECT NAME : UART0 uDMA Receive with Receive-Timeout Framing
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *      - uDMA channel 8 (UART0 RX)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * UART0Rx() in 014_01 returns one character per call, and the
+ * interrupt driver in 016 still takes one interrupt per FIFO
+ * half. Here uDMA writes every received byte into a 1 KB ring
+ * and the CPU only runs once per FRAME:
+ *
+ *   uDMA   : burst requests only (USEBURST), RX FIFO level 1/2,
+ *            ARBSIZE 4. Each burst moves 4 bytes, so after the
+ *            last byte of a frame 1 - 7 bytes are ALWAYS left in
+ *            the FIFO.
+ *
+ *   RT irq : those leftover bytes make the UART raise the
+ *            receive-timeout interrupt 32 bit times after the
+ *            line goes quiet = end of frame. UART0_Handler then
+ *              1. stops the channel and reads how far it got
+ *              2. copies the 1 - 7 leftover bytes by CPU
+ *              3. records the frame end
+ *              4. re-arms uDMA at the new ring position
+ *
+ *   Ring end: uDMA basic mode stops at the end of the ring
+ *            (max 1024 items per transfer); the completion
+ *            interrupt re-arms it at the start.
+ *
+ * Zero-copy frames:
+ *   uart_frame_get() returns a frame as up to two spans that
+ *   point straight into the ring (two when it wraps). The
+ *   parser reads them in place and calls uart_frame_release().
+ *   uDMA does not stop at unreleased data: once the live write
+ *   position is more than RX_RING_SIZE bytes past a frame, the
+ *   frame is overwritten. uart_frame_get() skips such frames,
+ *   and uart_frame_release() checks again, because the sender
+ *   may overrun the frame while the parser reads it. Both count
+ *   in rx_overwritten (main only); rx_dropped counts frame ends
+ *   the ISR could not queue (ISR only).
+ *
+ * Demo: every frame is echoed back with its length, e.g.
+ *   "[12] hello world" plus the interrupts taken so far, to
+ *   compare with the byte count.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define RX_RING_SIZE 1024 // power of two, <= 1024 (one uDMA transfer)
+#define FRAME_QUEUE 16    // power of two
+#define DMA_CH_UART0RX 8
+
+/***********************************************************
+ * uDMA CONTROL TABLE (must be 1024-byte aligned)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[32] __attribute__((aligned(1024)));
+
+/***********************************************************
+ * RX RING AND FRAME QUEUE
+ * Positions are free-running byte counts; "& (RX_RING_SIZE - 1)"
+ * turns them into ring indexes.
+ ***********************************************************/
+uint8_t rx_ring[RX_RING_SIZE];
+uint32_t rx_wr;          // bytes written before the current uDMA arm
+uint32_t rx_arm_len;     // items of the current uDMA arm
+uint32_t rx_rd;          // start of the oldest unreleased frame
+
+uint32_t frame_end[FRAME_QUEUE];
+volatile uint32_t frame_head, frame_tail;
+
+typedef struct
+{
+    const uint8_t *data[2]; // second span only when the frame wraps
+    uint16_t len[2];
+} uart_frame_t;
+
+volatile uint32_t rx_irqs, rx_frames, rx_overruns, rx_dropped; // ISR
+uint32_t rx_overwritten;                                         // main
+
+// Function prototypes
+void uart_rx_dma_init(void);
+void uart_rx_dma_arm(void);
+uint32_t uart_rx_dma_done(void);
+uint32_t uart_rx_position(void);
+int uart_frame_get(uart_frame_t *f);
+int uart_frame_release(void);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    uart_frame_t f;
+    uint32_t i, s;
+
+    /***********************************************************
+     * STEP 1: Enable clocks – GPIO A, UART0, uDMA
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1, FIFO on
+     * IBRD = 16 MHz / (16 x 115200) = 8.680 → 8, FBRD = 44
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70; // 8-bit, FIFO enable
+    UART0_CC_R = 0x00;
+    UART0_IFLS_R = 0x10; // RX level 1/2 (8 bytes) → uDMA burst request
+    UART0_IM_R = 0x440;  // OEIM (bit 10), RTIM (bit 6); no RXIM
+    UART0_DMACTL_R = 0x01; // RXDMAE
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: uDMA channel 8 → rx_ring
+     ***********************************************************/
+    uart_rx_dma_init();
+
+    NVIC_EN0_R = 1 << 5; // IRQ 5 = UART0 (RT, overrun, uDMA done)
+    __enable_irq();
+
+    UART0_SendString("\r\nDMA RX ready, send frames\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – one call per frame, data read in place
+     ***********************************************************/
+    while (1)
+    {
+        if (!uart_frame_get(&f))
+            continue;
+
+        UART0Tx('[');
+        UART0_SendNumber(f.len[0] + f.len[1]);
+        UART0_SendString("] ");
+        for (s = 0; s < 2; s++)
+            for (i = 0; i < f.len[s]; i++)
+                UART0Tx((char)f.data[s][i]);
+        UART0_SendString("  irqs ");
+        UART0_SendNumber(rx_irqs);
+
+        if (!uart_frame_release())
+            UART0_SendString("  (overwritten while sent)");
+        UART0_SendString("\r\n");
+    }
+}
+
+/***********************************************************
+ * uart_rx_dma_init() – channel 8 = UART0 RX, burst only
+ ***********************************************************/
+void uart_rx_dma_init(void)
+{
+    UDMA_CFG_R = 0x01; // MASTEN
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP1_R &= ~0x0000000F; // CH8 → UART0 RX
+    UDMA_ALTCLR_R = 1 << DMA_CH_UART0RX;
+    UDMA_USEBURSTSET_R = 1 << DMA_CH_UART0RX; // Ignore single requests
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_UART0RX;
+
+    rx_wr = 0;
+    uart_rx_dma_arm();
+}
+
+/***********************************************************
+ * uart_rx_dma_arm() – receive from rx_wr to the end of the ring
+ ***********************************************************/
+void uart_rx_dma_arm(void)
+{
+    uint32_t pos = rx_wr & (RX_RING_SIZE - 1);
+
+    rx_arm_len = RX_RING_SIZE - pos;
+
+    dma_table[DMA_CH_UART0RX].src_end = (uint32_t)(uintptr_t)&UART0_DR_R;
+    dma_table[DMA_CH_UART0RX].dst_end = (uint32_t)(uintptr_t)&rx_ring[RX_RING_SIZE - 1];
+    dma_table[DMA_CH_UART0RX].ctl = (0u << 30)                // DSTINC: byte
+                                    | (0u << 28)              // DSTSIZE: byte
+                                    | (3u << 26)              // SRCINC: none
+                                    | (0u << 24)              // SRCSIZE: byte
+                                    | (2u << 14)              // ARBSIZE: 4
+                                    | ((rx_arm_len - 1) << 4) // XFERSIZE
+                                    | 0x1;                    // Basic mode
+    UDMA_ENASET_R = 1 << DMA_CH_UART0RX;
+}
+
+/***********************************************************
+ * uart_rx_dma_done() – bytes written by the current arm
+ * XFERSIZE counts down as items move; mode = 0 when finished.
+ ***********************************************************/
+uint32_t uart_rx_dma_done(void)
+{
+    uint32_t ctl = dma_table[DMA_CH_UART0RX].ctl;
+
+    if ((ctl & 0x7) == 0)
+        return rx_arm_len;
+
+    return rx_arm_len - (((ctl >> 4) & 0x3FF) + 1);
+}
+
+/***********************************************************
+ * uart_rx_position() – live write position of uDMA
+ * rx_wr and the arm change in UART0_Handler, so they are read
+ * with interrupts masked.
+ ***********************************************************/
+uint32_t uart_rx_position(void)
+{
+    uint32_t pos;
+
+    __disable_irq();
+    pos = rx_wr + uart_rx_dma_done();
+    __enable_irq();
+    return pos;
+}
+
+/***********************************************************
+ * UART0_Handler() – ring end, end of frame, overrun
+ ***********************************************************/
+void UART0_Handler(void)
+{
+    uint32_t mis = UART0_MIS_R;
+
+    rx_irqs++;
+
+    // uDMA reached the end of the ring: continue at the start.
+    // A flag left from an arm the RT path below already counted
+    // finds the new arm still running and is ignored.
+    if (UDMA_CHIS_R & (1 << DMA_CH_UART0RX))
+    {
+        UDMA_CHIS_R = 1 << DMA_CH_UART0RX;
+        if ((dma_table[DMA_CH_UART0RX].ctl & 0x7) == 0)
+        {
+            rx_wr += rx_arm_len;
+            uart_rx_dma_arm();
+        }
+    }
+
+    if (mis & 0x400) // OE: FIFO overflowed (bytes lost)
+    {
+        UART0_ICR_R = 0x400;
+        rx_overruns++;
+    }
+
+    // Receive timeout: the line has been idle for 32 bit times
+    if (mis & 0x40)
+    {
+        UART0_ICR_R = 0x40;
+
+        // Stop the channel, then clear a completion that may have
+        // come after the check above: uart_rx_dma_done() counts it
+        UDMA_ENACLR_R = 1 << DMA_CH_UART0RX;
+        UDMA_CHIS_R = 1 << DMA_CH_UART0RX;
+        rx_wr += uart_rx_dma_done();
+
+        while ((UART0_FR_R & 0x10) == 0) // Leftover bytes (< 8)
+        {
+            rx_ring[rx_wr & (RX_RING_SIZE - 1)] = (uint8_t)UART0_DR_R;
+            rx_wr++;
+        }
+
+        if ((frame_head - frame_tail) < FRAME_QUEUE)
+        {
+            frame_end[frame_head & (FRAME_QUEUE - 1)] = rx_wr;
+            frame_head++;
+            rx_frames++;
+        }
+        else
+        {
+            rx_dropped++; // Parser too slow; bytes join the next frame
+        }
+
+        uart_rx_dma_arm();
+    }
+}
+
+/***********************************************************
+ * uart_frame_get() – oldest frame as spans into rx_ring
+ * Returns 0 if no frame is complete. Frames that uDMA has
+ * already written over (live position more than RX_RING_SIZE
+ * bytes past their start) are skipped.
+ ***********************************************************/
+int uart_frame_get(uart_frame_t *f)
+{
+    uint32_t end, len, pos, first;
+
+    while (frame_tail != frame_head)
+    {
+        end = frame_end[frame_tail & (FRAME_QUEUE - 1)];
+        len = end - rx_rd;
+
+        if (uart_rx_position() - rx_rd > RX_RING_SIZE) // Overwritten
+        {
+            rx_overwritten++;
+            rx_rd = end;
+            frame_tail++;
+            continue;
+        }
+
+        pos = rx_rd & (RX_RING_SIZE - 1);
+        first = RX_RING_SIZE - pos;
+        if (first > len)
+            first = len;
+
+        f->data[0] = &rx_ring[pos];
+        f->len[0] = (uint16_t)first;
+        f->data[1] = rx_ring;
+        f->len[1] = (uint16_t)(len - first);
+        return 1;
+    }
+
+    return 0;
+}
+
+/***********************************************************
+ * uart_frame_release() – parser is done with the oldest frame
+ * Returns 0 if uDMA overwrote the frame while it was read; the
+ * parser must then discard what it took from it.
+ ***********************************************************/
+int uart_frame_release(void)
+{
+    int intact;
+
+    if (frame_tail == frame_head)
+        return 0;
+
+    intact = uart_rx_position() - rx_rd <= RX_RING_SIZE;
+    if (!intact)
+        rx_overwritten++;
+
+    rx_rd = frame_end[frame_tail & (FRAME_QUEUE - 1)];
+    frame_tail++;
+    return intact;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,615 @@
+/***************************************************************
+ * PROJECT NAME : Modbus RTU Slave
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - UART1 (PB0 = RX, PB1 = TX), 19200 8E1, RS-485
+ *      - PB2 = RS-485 driver enable (DE and /RE tied together)
+ *      - Timer0A (t1.5 / t3.5 silent-interval timer)
+ *      - uDMA channel 23 (UART1 TX)
+ *      - ADC0 SS3 on PE3 (AIN0), triggered by Timer1A at 1 kHz
+ *      - PWM1 generator 3B on PF3 (green LED), PF1 (red LED), PF4 (SW1)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Modbus RTU has no start/end characters: a frame ends when
+ * the line has been silent for 3.5 character times (t3.5), and
+ * a gap of more than 1.5 characters (t1.5) inside a frame
+ * makes it invalid. A polling loop such as UART1Rx() in 014_02
+ * cannot see these gaps, so here they are measured by timer.
+ *
+ * Silent-interval timer (Timer0A, one shot, counts down):
+ *   Every received character reloads TAV = t3.5. The match
+ *   register sits at t3.5 - t1.5, so ONE timer gives both
+ *   events:
+ *      match   (t1.5) : RECEPTION → CONTROL
+ *      timeout (t3.5) : CONTROL   → frame complete
+ *   A character arriving in CONTROL marks the frame bad. The
+ *   UART FIFO is off so each character interrupts on arrival
+ *   and the timer is restarted at the true character time.
+ *
+ *      INIT ──t3.5──► IDLE ──char──► RECEPTION ──t1.5──► CONTROL
+ *                      ▲                                   │ t3.5
+ *                      └──── bad frame / not for us ◄─ PROCESS
+ *      EMISSION (uDMA) ──EOT──► INIT
+ *
+ * Request handling:
+ *   The main loop sleeps until a frame is complete, checks the
+ *   CRC with a 256-entry table (one lookup per byte instead of
+ *   8 shift/xor steps) and answers through uDMA, so the
+ *   turnaround is the processing time only (well below 1 ms).
+ *   The UART end-of-transmission (EOT) interrupt drops DE after
+ *   the last stop bit.
+ *
+ * Supported functions:
+ *   03 Read Holding Registers     04 Read Input Registers
+ *   06 Write Single Register      16 Write Multiple Registers
+ *   Exceptions: 01 illegal function, 02 illegal address,
+ *               03 illegal value. Address 0 = broadcast (no reply).
+ *
+ * Register map (bound directly to live hardware):
+ *   Holding 0 : PWM duty, PWM1_3_CMPB (0 - PWM_LOAD)
+ *   Holding 1 : red LED, PF1 (0/1)
+ *   Input   0 : ADC0 AIN0 (0 - 4095)
+ *   Input   1 : SW1, PF4 (0 = pressed)
+ *   Input   2 : frames answered
+ *   Input   3 : CRC errors
+ *   Input   4 : bad frames (t1.5 gap, parity, overflow)
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 16000000
+#define MB_BAUD 19200
+#define MB_SLAVE_ID 1
+#define MB_BUF_SIZE 256 // largest RTU frame
+#define DMA_CH_UART1TX 23
+#define PWM_LOAD 1599 // 10 kHz at 16 MHz
+
+/***********************************************************
+ * SILENT INTERVALS
+ * One character = 11 bits (start, 8 data, parity, stop).
+ * Above 19200 baud the standard fixes t1.5 = 750 us and
+ * t3.5 = 1750 us.
+ ***********************************************************/
+#if MB_BAUD > 19200
+#define MB_T15 (SYSCLK / 1000000 * 750)
+#define MB_T35 (SYSCLK / 1000000 * 1750)
+#else
+#define MB_T15 (SYSCLK / MB_BAUD * 11 * 3 / 2)
+#define MB_T35 (SYSCLK / MB_BAUD * 11 * 7 / 2)
+#endif
+
+enum
+{
+    MB_INIT,
+    MB_IDLE,
+    MB_RECEPTION,
+    MB_CONTROL,
+    MB_PROCESS,
+    MB_EMISSION,
+};
+
+/***********************************************************
+ * REGISTER MAP
+ * Each entry is a field of a live register (or variable):
+ * value = (*reg >> shift) & mask.
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t *reg;
+    uint8_t shift;
+    uint8_t writable;
+    uint16_t mask;
+    uint16_t max; // highest value accepted by a write
+} mb_map_t;
+
+volatile uint32_t adc_raw;
+volatile uint32_t mb_frames, mb_crc_errors, mb_bad_frames;
+
+const mb_map_t mb_holding[] = {
+    {&PWM1_3_CMPB_R, 0, 1, 0xFFFF, PWM_LOAD},
+    {&GPIO_PORTF_DATA_BITS_R[0x02], 1, 1, 0x0001, 1},
+};
+
+const mb_map_t mb_input[] = {
+    {&adc_raw, 0, 0, 0x0FFF, 0},
+    {&GPIO_PORTF_DATA_BITS_R[0x10], 4, 0, 0x0001, 0},
+    {&mb_frames, 0, 0, 0xFFFF, 0},
+    {&mb_crc_errors, 0, 0, 0xFFFF, 0},
+    {&mb_bad_frames, 0, 0, 0xFFFF, 0},
+};
+
+#define MB_HOLDING_COUNT (sizeof(mb_holding) / sizeof(mb_holding[0]))
+#define MB_INPUT_COUNT (sizeof(mb_input) / sizeof(mb_input[0]))
+
+/***********************************************************
+ * CRC-16 (Modbus: reflected 0xA001, init 0xFFFF)
+ ***********************************************************/
+const uint16_t mb_crc_table[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
+/***********************************************************
+ * uDMA CONTROL TABLE (must be 1024-byte aligned)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[32] __attribute__((aligned(1024)));
+
+/***********************************************************
+ * FRAME STATE
+ ***********************************************************/
+volatile uint8_t mb_state = MB_INIT;
+volatile uint8_t mb_frame_ok;
+volatile uint32_t mb_len;
+uint8_t mb_rx[MB_BUF_SIZE];
+uint8_t mb_tx[MB_BUF_SIZE];
+
+// Function prototypes
+void mb_init(void);
+void mb_timer_restart(void);
+uint16_t mb_crc16(const uint8_t *p, uint32_t n);
+void mb_process(void);
+uint32_t mb_execute(const uint8_t *req, uint32_t len, uint8_t *rsp);
+uint32_t mb_exception(uint8_t *rsp, uint8_t code);
+void mb_send(uint32_t n);
+void io_init(void);
+
+int main(void)
+{
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO B (UART1, DE), E (AIN0), F (LEDs, SW1), UART1,
+     * Timer0/1, ADC0, PWM1, uDMA
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x32;
+    SYSCTL_RCGCUART_R |= 0x02;
+    SYSCTL_RCGCTIMER_R |= 0x03;
+    SYSCTL_RCGCADC_R |= 0x01;
+    SYSCTL_RCGCPWM_R |= 0x02;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x32) != 0x32)
+        ;
+
+    /***********************************************************
+     * STEP 2: Live I/O behind the register map
+     ***********************************************************/
+    io_init();
+
+    /***********************************************************
+     * STEP 3: UART1, silent-interval timer, uDMA
+     ***********************************************************/
+    mb_init();
+
+    /***********************************************************
+     * STEP 4: Main loop – answer each complete frame
+     * Interrupts are masked while testing the state so a frame
+     * completing just before __WFI() still wakes the core.
+     ***********************************************************/
+    while (1)
+    {
+        __disable_irq();
+        if (mb_state != MB_PROCESS)
+            __WFI();
+        __enable_irq();
+
+        if (mb_state == MB_PROCESS)
+            mb_process();
+    }
+}
+
+/***********************************************************
+ * io_init() – PWM on PF3, LED PF1, SW1 PF4, ADC on PE3
+ ***********************************************************/
+void io_init(void)
+{
+    // PF1 output, PF4 input with pull-up, PF3 = M1PWM7
+    GPIO_PORTF_DIR_R |= 0x02;
+    GPIO_PORTF_DIR_R &= ~0x10;
+    GPIO_PORTF_PUR_R |= 0x10;
+    GPIO_PORTF_AFSEL_R |= 0x08;
+    GPIO_PORTF_PCTL_R = (GPIO_PORTF_PCTL_R & ~0x0000F000) | 0x00005000;
+    GPIO_PORTF_DEN_R |= 0x1A;
+
+    // Generator 3B: high from CMPB (counting down) to zero,
+    // so the duty is CMPB / (PWM_LOAD + 1)
+    PWM1_3_CTL_R = 0x00;
+    PWM1_3_GENB_R = 0x00000C02; // ACTCMPBD = high, ACTZERO = low
+    PWM1_3_LOAD_R = PWM_LOAD;
+    PWM1_3_CMPB_R = 0;
+    PWM1_3_CTL_R = 0x01;
+    PWM1_ENABLE_R |= 0x80; // M1PWM7
+
+    // PE3 = AIN0
+    GPIO_PORTE_AFSEL_R |= 0x08;
+    GPIO_PORTE_DEN_R &= ~0x08;
+    GPIO_PORTE_AMSEL_R |= 0x08;
+
+    ADC0_ACTSS_R &= ~0x08;                            // Disable SS3
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0xF000) | 0x5000;   // SS3: timer trigger
+    ADC0_SSMUX3_R = 0;                                // AIN0
+    ADC0_SSCTL3_R = 0x06;                             // END0, IE0
+    ADC0_IM_R |= 0x08;
+    ADC0_ACTSS_R |= 0x08;
+
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;
+    TIMER1_TAMR_R = 0x02;              // Periodic
+    TIMER1_TAILR_R = SYSCLK / 1000 - 1; // 1 kHz
+    TIMER1_CTL_R = 0x21;               // TAOTE (ADC trigger), TAEN
+
+    NVIC_EN0_R = 1 << 17; // IRQ 17 = ADC0 SS3
+}
+
+/***********************************************************
+ * ADC0SS3_Handler() – latest sample for input register 0
+ ***********************************************************/
+void ADC0SS3_Handler(void)
+{
+    adc_raw = ADC0_SSFIFO3_R;
+    ADC0_ISC_R = 0x08;
+}
+
+/***********************************************************
+ * mb_init() – UART1 19200 8E1 without FIFO, Timer0A, uDMA
+ * IBRD = 16 MHz / (16 x 19200) = 52.083 → 52, FBRD = 5
+ ***********************************************************/
+void mb_init(void)
+{
+    // PB0 = U1RX, PB1 = U1TX, PB2 = DE (low = receive)
+    GPIO_PORTB_AFSEL_R |= 0x03;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0xFF) | 0x11;
+    GPIO_PORTB_DIR_R |= 0x04;
+    GPIO_PORTB_DATA_R &= ~0x04;
+    GPIO_PORTB_DEN_R |= 0x07;
+
+    UART1_CTL_R = 0x00;
+    UART1_IBRD_R = 52;
+    UART1_FBRD_R = 5;
+    UART1_LCRH_R = 0x66;   // 8-bit, even parity, FIFO OFF
+    UART1_CC_R = 0x00;
+    UART1_IM_R = 0x10;     // RXIM: one interrupt per character
+    UART1_DMACTL_R = 0x02; // TXDMAE
+    UART1_CTL_R = 0x311;   // RXE, TXE, EOT, UARTEN
+
+    // Timer0A: 32-bit one shot, match at t1.5, timeout at t3.5
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x21; // One shot, TAMIE
+    TIMER0_TAILR_R = MB_T35 - 1;
+    TIMER0_TAMATCHR_R = MB_T35 - MB_T15;
+    TIMER0_ICR_R = 0x11;
+    TIMER0_IMR_R = 0x11; // TAMIM, TATOIM
+
+    // uDMA channel 23 = UART1 TX
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0xF0000000;
+    UDMA_ALTCLR_R = 1 << DMA_CH_UART1TX;
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_UART1TX;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_UART1TX;
+
+    NVIC_EN0_R = (1 << 6) | (1 << 19); // UART1, Timer0A
+    __enable_irq();
+
+    mb_state = MB_INIT; // Wait for t3.5 of silence first
+    mb_timer_restart();
+}
+
+/***********************************************************
+ * mb_timer_restart() – start a new t1.5 / t3.5 measurement
+ ***********************************************************/
+void mb_timer_restart(void)
+{
+    TIMER0_CTL_R = 0x00;
+    TIMER0_TAV_R = MB_T35 - 1;
+    TIMER0_ICR_R = 0x11;
+    TIMER0_CTL_R = 0x01;
+}
+
+/***********************************************************
+ * UART1_Handler() – RX characters, TX uDMA done, EOT
+ ***********************************************************/
+void UART1_Handler(void)
+{
+    uint32_t mis = UART1_MIS_R;
+    uint32_t d;
+
+    // Whole response handed to the UART: wait for the stop bit
+    if (UDMA_CHIS_R & (1 << DMA_CH_UART1TX))
+    {
+        UDMA_CHIS_R = 1 << DMA_CH_UART1TX;
+        UART1_ICR_R = 0x20;
+        UART1_IM_R |= 0x20; // TXIM (with EOT = line idle)
+    }
+
+    if (mis & 0x20)
+    {
+        UART1_ICR_R = 0x20;
+        UART1_IM_R &= ~0x20;
+        GPIO_PORTB_DATA_R &= ~0x04; // DE off: back to receive
+        mb_state = MB_INIT;         // t3.5 gap before the next frame
+        mb_timer_restart();
+    }
+
+    if (mis & 0x10)
+    {
+        d = UART1_DR_R; // Also clears RXRIS
+
+        switch (mb_state)
+        {
+        case MB_IDLE:
+            mb_len = 0;
+            mb_frame_ok = 1;
+            mb_state = MB_RECEPTION;
+            // fall through
+        case MB_RECEPTION:
+            if ((d & 0xF00) || mb_len >= MB_BUF_SIZE) // FE, PE, BE, OE
+                mb_frame_ok = 0;
+            else
+                mb_rx[mb_len++] = (uint8_t)d;
+            mb_timer_restart();
+            break;
+
+        case MB_CONTROL: // Gap > t1.5 inside the frame
+            mb_frame_ok = 0;
+            mb_timer_restart();
+            break;
+
+        case MB_INIT: // Line not yet quiet
+            mb_timer_restart();
+            break;
+
+        default: // PROCESS / EMISSION: master must wait for us
+            break;
+        }
+    }
+}
+
+/***********************************************************
+ * TIMER0A_Handler() – t1.5 (match) and t3.5 (timeout)
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    uint32_t mis = TIMER0_MIS_R;
+
+    TIMER0_ICR_R = mis;
+
+    if ((mis & 0x10) && mb_state == MB_RECEPTION)
+        mb_state = MB_CONTROL;
+
+    if (mis & 0x01)
+    {
+        if (mb_state == MB_INIT)
+        {
+            mb_state = MB_IDLE;
+        }
+        else if (mb_state == MB_CONTROL || mb_state == MB_RECEPTION)
+        {
+            if (mb_frame_ok)
+            {
+                mb_state = MB_PROCESS;
+            }
+            else
+            {
+                mb_bad_frames++;
+                mb_state = MB_IDLE;
+            }
+        }
+    }
+}
+
+/***********************************************************
+ * mb_crc16() – table-driven CRC, one lookup per byte
+ * Run over a frame INCLUDING its CRC the result is 0.
+ ***********************************************************/
+uint16_t mb_crc16(const uint8_t *p, uint32_t n)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (n--)
+        crc = (uint16_t)((crc >> 8) ^ mb_crc_table[(crc ^ *p++) & 0xFF]);
+
+    return crc;
+}
+
+/***********************************************************
+ * mb_process() – validate the frame and send the answer
+ ***********************************************************/
+void mb_process(void)
+{
+    uint32_t n;
+
+    if (mb_len < 4 || mb_crc16(mb_rx, mb_len) != 0)
+    {
+        mb_crc_errors++;
+        mb_state = MB_IDLE;
+        return;
+    }
+
+    if (mb_rx[0] != MB_SLAVE_ID && mb_rx[0] != 0)
+    {
+        mb_state = MB_IDLE; // For another slave
+        return;
+    }
+
+    n = mb_execute(mb_rx, mb_len - 2, mb_tx);
+
+    if (mb_rx[0] == 0) // Broadcast: act, never answer
+    {
+        mb_state = MB_IDLE;
+        return;
+    }
+
+    mb_frames++;
+    mb_send(n);
+}
+
+/***********************************************************
+ * mb_execute() – run one request, build the response PDU
+ * req/len exclude the CRC. Returns the response length
+ * without CRC.
+ ***********************************************************/
+uint32_t mb_execute(const uint8_t *req, uint32_t len, uint8_t *rsp)
+{
+    const mb_map_t *map, *m;
+    uint32_t count, start, qty, value, i;
+
+    rsp[0] = req[0];
+    rsp[1] = req[1];
+
+    // Function code before length: an unsupported function is
+    // exception 01 even when its frame is short
+    if (req[1] != 0x03 && req[1] != 0x04 && req[1] != 0x06 && req[1] != 0x10)
+        return mb_exception(rsp, 0x01);
+    if (len < 6)
+        return mb_exception(rsp, 0x03);
+
+    start = ((uint32_t)req[2] << 8) | req[3];
+    qty = ((uint32_t)req[4] << 8) | req[5]; // value for FC 06
+
+    switch (req[1])
+    {
+    case 0x03: // Read Holding Registers
+    case 0x04: // Read Input Registers
+        map = (req[1] == 0x03) ? mb_holding : mb_input;
+        count = (req[1] == 0x03) ? MB_HOLDING_COUNT : MB_INPUT_COUNT;
+
+        if (qty < 1 || qty > 125)
+            return mb_exception(rsp, 0x03);
+        if (start + qty > count)
+            return mb_exception(rsp, 0x02);
+
+        rsp[2] = (uint8_t)(qty * 2);
+        for (i = 0; i < qty; i++)
+        {
+            m = &map[start + i];
+            value = (*m->reg >> m->shift) & m->mask;
+            rsp[3 + 2 * i] = (uint8_t)(value >> 8);
+            rsp[4 + 2 * i] = (uint8_t)value;
+        }
+        return 3 + qty * 2;
+
+    case 0x06: // Write Single Register
+        if (start >= MB_HOLDING_COUNT || !mb_holding[start].writable)
+            return mb_exception(rsp, 0x02);
+
+        m = &mb_holding[start];
+        if (qty > m->max)
+            return mb_exception(rsp, 0x03);
+
+        *m->reg = (*m->reg & ~((uint32_t)m->mask << m->shift)) | (qty << m->shift);
+
+        for (i = 2; i < 6; i++) // Echo the request
+            rsp[i] = req[i];
+        return 6;
+
+    case 0x10: // Write Multiple Registers
+        if (qty < 1 || qty > 123 || len < 7 + qty * 2 || req[6] != qty * 2)
+            return mb_exception(rsp, 0x03);
+        if (start + qty > MB_HOLDING_COUNT)
+            return mb_exception(rsp, 0x02);
+
+        // Check everything first: a rejected request writes nothing
+        for (i = 0; i < qty; i++)
+        {
+            m = &mb_holding[start + i];
+            value = ((uint32_t)req[7 + 2 * i] << 8) | req[8 + 2 * i];
+            if (!m->writable)
+                return mb_exception(rsp, 0x02);
+            if (value > m->max)
+                return mb_exception(rsp, 0x03);
+        }
+
+        for (i = 0; i < qty; i++)
+        {
+            m = &mb_holding[start + i];
+            value = ((uint32_t)req[7 + 2 * i] << 8) | req[8 + 2 * i];
+            *m->reg = (*m->reg & ~((uint32_t)m->mask << m->shift)) | (value << m->shift);
+        }
+
+        for (i = 2; i < 6; i++) // Start address and quantity
+            rsp[i] = req[i];
+        return 6;
+
+    default:
+        return mb_exception(rsp, 0x01);
+    }
+}
+
+/***********************************************************
+ * mb_exception() – function code | 0x80, exception code
+ ***********************************************************/
+uint32_t mb_exception(uint8_t *rsp, uint8_t code)
+{
+    rsp[1] |= 0x80;
+    rsp[2] = code;
+    return 3;
+}
+
+/***********************************************************
+ * mb_send() – append CRC (low byte first), DE on, start uDMA
+ ***********************************************************/
+void mb_send(uint32_t n)
+{
+    uint16_t crc = mb_crc16(mb_tx, n);
+
+    mb_tx[n++] = (uint8_t)crc;
+    mb_tx[n++] = (uint8_t)(crc >> 8);
+
+    mb_state = MB_EMISSION;
+    GPIO_PORTB_DATA_R |= 0x04; // DE on
+
+    dma_table[DMA_CH_UART1TX].src_end = (uint32_t)(uintptr_t)&mb_tx[n - 1];
+    dma_table[DMA_CH_UART1TX].dst_end = (uint32_t)(uintptr_t)&UART1_DR_R;
+    dma_table[DMA_CH_UART1TX].ctl = (3u << 30)       // DSTINC: none
+                                    | (0u << 28)     // DSTSIZE: byte
+                                    | (0u << 26)     // SRCINC: byte
+                                    | (0u << 24)     // SRCSIZE: byte
+                                    | (0u << 14)     // ARBSIZE: 1
+                                    | ((n - 1) << 4) // XFERSIZE
+                                    | 0x1;           // Basic mode
+    UDMA_ENASET_R = 1 << DMA_CH_UART1TX;
+}
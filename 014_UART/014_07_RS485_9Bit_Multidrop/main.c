@@ -0,0 +1,626 @@
+/***************************************************************
+ * PROJECT NAME : RS-485 Multidrop Bus – 9-bit Addressing
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - UART1 (PB0 = RX, PB1 = TX), 1 Mbaud, 9-bit mode
+ *      - PB2 = RS-485 driver enable (DE and /RE tied together)
+ *      - Timer0A (master: reply timeout, slave: turnaround)
+ *      - uDMA channel 23 (UART1 TX, slave only)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * One master and up to BUS_MAX_SLAVES slaves share a single
+ * RS-485 pair. The same file builds either role (BUS_ROLE).
+ *
+ * 9-bit addressing (UART1_9BITADDR_R):
+ *   Each character carries a 9th bit: 1 = address, 0 = data.
+ *   A node programs its own address with 9BITEN set, and the
+ *   UART ignores every data byte that follows a different
+ *   address. A slave's CPU never sees traffic for other nodes.
+ *   The 9th bit is the (stick) parity bit: LCRH SPS + PEN with
+ *   EPS = 0 sends 1 (address), EPS = 1 sends 0 (data).
+ *
+ * Frames (every frame starts with its destination address):
+ *   poll  master → slave : [ADDR slave] [FLAGS]
+ *   reply slave → master : [ADDR 0] [SRC] [LEN] [LEN bytes] [CRC8]
+ *   FLAGS bit 0 = ACK of the slave's previous reply; without it
+ *   the slave repeats the same payload.
+ *
+ * Driver enable:
+ *   The TM4C123 UART has no DE output, so DE is a GPIO raised
+ *   just before the first character and dropped by the UART
+ *   end-of-transmission interrupt (CTL EOT) after the last stop
+ *   bit – no polling and no fixed delay.
+ *
+ * Master scheduler (token polling, pipelined):
+ *   The bus "token" is passed to one slave at a time by the
+ *   poll. The reply announces its length, so the master knows
+ *   the last byte and sends the next poll right away instead of
+ *   waiting for a silent interval. Only a slave that does not
+ *   answer costs a timeout (BUS_TIMEOUT_CHARS), and each miss
+ *   doubles the number of rounds it is skipped (up to
+ *   BUS_MAX_SKIP), so offline nodes barely load the bus.
+ *
+ *   Bus time is accounted in character times:
+ *      utilization = payload chars / all chars incl. gaps
+ *   017_QEMU_Target_Tests runs the scheduler against 32
+ *   simulated slaves and reports this figure.
+ *
+ * NOTE :
+ * The 9th-bit switch in LCRH only applies to characters not yet
+ * sent, so bus_send_addr() waits for the address character to
+ * leave (11 us at 1 Mbaud) before queuing data.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define BUS_MASTER 0
+#define BUS_SLAVE 1
+#ifndef BUS_ROLE
+#define BUS_ROLE BUS_MASTER // BUS_MASTER or BUS_SLAVE
+#endif
+
+#define SYSCLK 16000000
+#define BUS_BAUD 1000000
+#define BUS_MASTER_ADDR 0x00
+#define BUS_MY_ADDR 0x01 // slave role: this node's address (1 - 254)
+#define BUS_MAX_SLAVES 32
+#define BUS_MAX_PAYLOAD 32
+
+// Bus timing in character times (11 bits: start, 8, 9th, stop)
+#define BUS_CHAR_TICKS (SYSCLK / BUS_BAUD * 11)
+#define BUS_POLL_CHARS 2
+#define BUS_REPLY_CHARS 4 // + LEN
+#define BUS_TURNAROUND_CHARS 1
+#define BUS_TIMEOUT_CHARS 4
+#define BUS_MAX_SKIP 16
+
+#define LCRH_DATA 0xE6 // SPS, 8-bit, EPS, PEN: 9th bit = 0
+#define LCRH_ADDR 0xE2 // SPS, 8-bit, PEN:      9th bit = 1
+
+/***********************************************************
+ * MASTER SCHEDULER STATE
+ ***********************************************************/
+typedef struct
+{
+    uint8_t addr;
+    uint8_t ack;    // last reply arrived intact
+    uint8_t misses; // consecutive timeouts
+    uint8_t skip;   // rounds left to skip
+    uint32_t polls, replies, timeouts, bytes;
+} bus_slave_t;
+
+bus_slave_t bus_slaves[BUS_MAX_SLAVES];
+uint32_t bus_slave_count;
+uint32_t bus_cursor;
+uint8_t bus_backoff = 1; // 0 = poll every slave every round
+
+volatile uint32_t bus_rounds;
+volatile uint32_t bus_chars_total;   // bus time, in character times
+volatile uint32_t bus_chars_payload; // useful payload characters
+
+volatile int bus_current = -1; // slave holding the token
+
+/***********************************************************
+ * RECEIVE PARSER (both roles)
+ ***********************************************************/
+enum
+{
+    RX_IDLE,
+    RX_SRC,
+    RX_LEN,
+    RX_DATA,
+    RX_CRC,
+    RX_FLAGS,
+};
+
+uint8_t rx_state = RX_IDLE;
+uint8_t rx_src, rx_len, rx_count;
+uint8_t rx_buf[BUS_MAX_PAYLOAD];
+
+// Function prototypes
+void bus_init(uint8_t own_addr);
+void bus_add_slave(uint8_t addr);
+int bus_next_slave(void);
+void bus_reply(int i, uint32_t len);
+void bus_timeout(int i);
+uint32_t bus_utilization_pm(void);
+void bus_poll(int i);
+void bus_send_addr(uint8_t addr);
+uint8_t crc8(const uint8_t *p, uint32_t n);
+void UART0_Init(void);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+#if BUS_ROLE == BUS_SLAVE
+uint8_t slave_tx[4 + BUS_MAX_PAYLOAD];
+uint32_t slave_tx_len;
+uint32_t slave_counter;
+
+/***********************************************************
+ * uDMA CONTROL TABLE (must be 1024-byte aligned)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[32] __attribute__((aligned(1024)));
+
+void slave_reply(uint8_t flags);
+#endif
+
+int main(void)
+{
+    uint32_t i, polls, next_report = 10000;
+
+    /***********************************************************
+     * STEP 1: Enable clocks – GPIO A, B, UART0/1, Timer0, uDMA
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x03;
+    SYSCTL_RCGCUART_R |= 0x03;
+    SYSCTL_RCGCTIMER_R |= 0x01;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x03) != 0x03)
+        ;
+
+    UART0_Init();
+
+#if BUS_ROLE == BUS_MASTER
+    /***********************************************************
+     * STEP 2: Master – slave list, start the first round
+     ***********************************************************/
+    for (i = 1; i <= BUS_MAX_SLAVES; i++)
+        bus_add_slave((uint8_t)i);
+
+    bus_init(BUS_MASTER_ADDR);
+    UART0_SendString("\r\nRS-485 master\r\n");
+    bus_poll(bus_next_slave());
+
+    /***********************************************************
+     * STEP 3: Report bus statistics every 10000 polls
+     ***********************************************************/
+    while (1)
+    {
+        polls = 0;
+        for (i = 0; i < bus_slave_count; i++)
+            polls += bus_slaves[i].polls;
+
+        if (polls >= next_report)
+        {
+            next_report += 10000;
+            UART0_SendString("rounds ");
+            UART0_SendNumber(bus_rounds);
+            UART0_SendString(" util ");
+            UART0_SendNumber(bus_utilization_pm());
+            UART0_SendString(" permille, online");
+            for (i = 0; i < bus_slave_count; i++)
+                if (bus_slaves[i].misses == 0)
+                {
+                    UART0Tx(' ');
+                    UART0_SendNumber(bus_slaves[i].addr);
+                }
+            UART0_SendString("\r\n");
+        }
+        __WFI();
+    }
+#else
+    /***********************************************************
+     * STEP 2: Slave – listen for our address only
+     ***********************************************************/
+    (void)i;
+    (void)polls;
+    (void)next_report;
+    bus_init(BUS_MY_ADDR);
+    UART0_SendString("\r\nRS-485 slave ");
+    UART0_SendNumber(BUS_MY_ADDR);
+    UART0_SendString("\r\n");
+
+    while (1)
+        __WFI();
+#endif
+}
+
+/***********************************************************
+ * bus_init() – UART1 9-bit mode at 1 Mbaud, DE on PB2
+ * IBRD = 16 MHz / (16 x 1 Mbaud) = 1, FBRD = 0.
+ * The FIFO is off: the master must react to the LAST reply
+ * character at once, not after a receive timeout.
+ ***********************************************************/
+void bus_init(uint8_t own_addr)
+{
+    GPIO_PORTB_AFSEL_R |= 0x03;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0xFF) | 0x11;
+    GPIO_PORTB_DIR_R |= 0x04;
+    GPIO_PORTB_DATA_R &= ~0x04; // DE off: receive
+    GPIO_PORTB_DEN_R |= 0x07;
+
+    UART1_CTL_R = 0x00;
+    UART1_IBRD_R = 1;
+    UART1_FBRD_R = 0;
+    UART1_LCRH_R = LCRH_DATA; // FIFO off
+    UART1_CC_R = 0x00;
+    UART1_9BITAMASK_R = 0xFF;            // Compare all 8 address bits
+    UART1_9BITADDR_R = 0x8000 | own_addr; // 9BITEN
+    UART1_ICR_R = 0x17F0;
+    UART1_IM_R = 0x1010; // 9BITIM (address match), RXIM
+    UART1_CTL_R = 0x311; // RXE, TXE, EOT, UARTEN
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x01; // One shot
+    TIMER0_ICR_R = 0x01;
+    TIMER0_IMR_R = 0x01;
+    NVIC_EN0_R = (1 << 6) | (1 << 19); // UART1, Timer0A
+
+#if BUS_ROLE == BUS_SLAVE
+    UART1_DMACTL_R = 0x02; // TXDMAE
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0xF0000000; // CH23 → UART1 TX
+    UDMA_ALTCLR_R = 1 << 23;
+    UDMA_REQMASKCLR_R = 1 << 23;
+#endif
+    __enable_irq();
+}
+
+/***********************************************************
+ * bus_send_addr() – DE on, one character with 9th bit = 1
+ ***********************************************************/
+void bus_send_addr(uint8_t addr)
+{
+    GPIO_PORTB_DATA_R |= 0x04; // DE on
+    UART1_LCRH_R = LCRH_ADDR;
+    UART1_DR_R = addr;
+    while ((UART1_FR_R & 0x88) != 0x80) // TXFE set, BUSY clear
+        ;
+    UART1_LCRH_R = LCRH_DATA;
+}
+
+/***********************************************************
+ * crc8() – CRC-8, polynomial x^8 + x^2 + x + 1 (0x07)
+ ***********************************************************/
+uint8_t crc8(const uint8_t *p, uint32_t n)
+{
+    uint8_t crc = 0;
+    int b;
+
+    while (n--)
+    {
+        crc ^= *p++;
+        for (b = 0; b < 8; b++)
+            crc = (uint8_t)((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+/***********************************************************
+ * SCHEDULER (hardware independent, also run by 017)
+ ***********************************************************/
+
+/*** bus_add_slave() – append one node to the polling list ***/
+void bus_add_slave(uint8_t addr)
+{
+    bus_slave_t *s;
+
+    if (bus_slave_count >= BUS_MAX_SLAVES)
+        return;
+
+    s = &bus_slaves[bus_slave_count++];
+    s->addr = addr;
+    s->ack = 0;
+    s->misses = 0;
+    s->skip = 0;
+    s->polls = s->replies = s->timeouts = s->bytes = 0;
+}
+
+/*** bus_next_slave() – next slave to receive the token ***/
+int bus_next_slave(void)
+{
+    uint32_t n;
+    int i;
+
+    for (n = 0; n < bus_slave_count; n++)
+    {
+        i = (int)bus_cursor;
+        if (++bus_cursor >= bus_slave_count)
+        {
+            bus_cursor = 0;
+            bus_rounds++;
+        }
+
+        if (bus_slaves[i].skip == 0)
+            return i;
+        bus_slaves[i].skip--;
+    }
+
+    // Every slave is backing off: poll the next one anyway
+    i = (int)bus_cursor;
+    if (++bus_cursor >= bus_slave_count)
+    {
+        bus_cursor = 0;
+        bus_rounds++;
+    }
+    return i;
+}
+
+/*** bus_reply() – slave i answered with len payload bytes ***/
+void bus_reply(int i, uint32_t len)
+{
+    bus_slave_t *s = &bus_slaves[i];
+
+    s->polls++;
+    s->replies++;
+    s->bytes += len;
+    s->ack = 1;
+    s->misses = 0;
+    s->skip = 0;
+
+    // Next poll leaves right after the last reply character
+    bus_chars_total += BUS_POLL_CHARS + BUS_TURNAROUND_CHARS + BUS_REPLY_CHARS + len;
+    bus_chars_payload += len;
+}
+
+/*** bus_timeout() – slave i did not answer (or answered badly) ***/
+void bus_timeout(int i)
+{
+    bus_slave_t *s = &bus_slaves[i];
+
+    s->polls++;
+    s->timeouts++;
+    s->ack = 0;
+
+    if (bus_backoff)
+    {
+        if (s->misses < 8)
+            s->misses++;
+        s->skip = (uint8_t)((1u << s->misses) > BUS_MAX_SKIP ? BUS_MAX_SKIP : (1u << s->misses)) - 1;
+    }
+
+    bus_chars_total += BUS_POLL_CHARS + BUS_TIMEOUT_CHARS;
+}
+
+/*** bus_utilization_pm() – payload share of bus time, per mille ***/
+uint32_t bus_utilization_pm(void)
+{
+    if (bus_chars_total == 0)
+        return 0;
+
+    return (uint32_t)((uint64_t)bus_chars_payload * 1000 / bus_chars_total);
+}
+
+/***********************************************************
+ * bus_poll() – pass the token to slave i (master)
+ * The EOT interrupt drops DE and starts the reply timeout.
+ ***********************************************************/
+void bus_poll(int i)
+{
+    bus_current = i;
+    rx_state = RX_IDLE;
+
+    bus_send_addr(bus_slaves[i].addr);
+    UART1_DR_R = bus_slaves[i].ack; // FLAGS
+    UART1_ICR_R = 0x20;
+    UART1_IM_R |= 0x20; // TXIM with EOT: line idle
+}
+
+/***********************************************************
+ * UART1_Handler() – EOT, address match and received bytes
+ ***********************************************************/
+void UART1_Handler(void)
+{
+    uint32_t mis = UART1_MIS_R;
+    uint32_t d;
+
+#if BUS_ROLE == BUS_SLAVE
+    if (UDMA_CHIS_R & (1 << 23)) // Reply body handed to the UART
+    {
+        UDMA_CHIS_R = 1 << 23;
+        UART1_ICR_R = 0x20;
+        UART1_IM_R |= 0x20;
+    }
+#endif
+
+    if (mis & 0x20) // Last stop bit sent
+    {
+        UART1_ICR_R = 0x20;
+        UART1_IM_R &= ~0x20;
+        GPIO_PORTB_DATA_R &= ~0x04; // DE off
+#if BUS_ROLE == BUS_MASTER
+        TIMER0_TAILR_R = BUS_CHAR_TICKS * BUS_TIMEOUT_CHARS;
+        TIMER0_ICR_R = 0x01;
+        TIMER0_CTL_R = 0x01;
+#endif
+    }
+
+    if (mis & 0x1000) // Our address: a new frame starts
+    {
+        UART1_ICR_R = 0x1000;
+#if BUS_ROLE == BUS_MASTER
+        rx_state = RX_SRC;
+#else
+        rx_state = RX_FLAGS;
+#endif
+        rx_count = 0;
+        if ((UART1_FR_R & 0x10) == 0)
+            (void)UART1_DR_R; // The address character itself
+    }
+
+    while ((UART1_FR_R & 0x10) == 0) // RX not empty
+    {
+        d = UART1_DR_R;
+#if BUS_ROLE == BUS_MASTER
+        TIMER0_TAV_R = BUS_CHAR_TICKS * BUS_TIMEOUT_CHARS; // Inter-char timeout
+#endif
+        if (d & 0xF00) // FE, PE, BE, OE
+        {
+            rx_state = RX_IDLE;
+            continue;
+        }
+
+        switch (rx_state)
+        {
+#if BUS_ROLE == BUS_MASTER
+        case RX_SRC:
+            rx_src = (uint8_t)d;
+            rx_state = RX_LEN;
+            break;
+        case RX_LEN:
+            rx_len = (uint8_t)d;
+            rx_state = (rx_len > BUS_MAX_PAYLOAD) ? RX_IDLE : (rx_len ? RX_DATA : RX_CRC);
+            break;
+        case RX_DATA:
+            rx_buf[rx_count++] = (uint8_t)d;
+            if (rx_count == rx_len)
+                rx_state = RX_CRC;
+            break;
+        case RX_CRC:
+            rx_state = RX_IDLE;
+            if (bus_current < 0)
+                break; // Before the first poll: no token to take back
+            TIMER0_CTL_R = 0x00;
+            if (rx_src == bus_slaves[bus_current].addr &&
+                crc8(rx_buf, rx_len) == (uint8_t)d)
+                bus_reply(bus_current, rx_len);
+            else
+                bus_timeout(bus_current);
+            bus_poll(bus_next_slave()); // Pipelined: no idle gap
+            break;
+#else
+        case RX_FLAGS: // Reply after one character of turnaround
+            rx_state = RX_IDLE;
+            rx_src = (uint8_t)d;
+            TIMER0_TAILR_R = BUS_CHAR_TICKS * BUS_TURNAROUND_CHARS;
+            TIMER0_ICR_R = 0x01;
+            TIMER0_CTL_R = 0x01;
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+}
+
+#if BUS_ROLE == BUS_MASTER
+/***********************************************************
+ * TIMER0A_Handler() – reply timeout: take the token back
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    TIMER0_ICR_R = 0x01;
+    rx_state = RX_IDLE;
+
+    if (bus_current >= 0)
+        bus_timeout(bus_current);
+    bus_poll(bus_next_slave());
+}
+#else
+/***********************************************************
+ * TIMER0A_Handler() – turnaround over: master released DE
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    TIMER0_ICR_R = 0x01;
+    slave_reply(rx_src); // FLAGS of the poll
+}
+
+/***********************************************************
+ * slave_reply() – answer a poll; repeat the payload on NAK
+ ***********************************************************/
+void slave_reply(uint8_t flags)
+{
+    uint32_t i, n;
+
+    if ((flags & 0x01) || slave_tx_len == 0)
+    {
+        // New payload: a running counter as text
+        n = 0;
+        i = slave_counter++;
+        do
+        {
+            slave_tx[2 + n++] = (uint8_t)('0' + i % 10);
+            i /= 10;
+        } while (i && n < BUS_MAX_PAYLOAD);
+
+        slave_tx[0] = BUS_MY_ADDR;
+        slave_tx[1] = (uint8_t)n;
+        slave_tx[2 + n] = crc8(&slave_tx[2], n);
+        slave_tx_len = 3 + n;
+    }
+
+    bus_send_addr(BUS_MASTER_ADDR);
+
+    dma_table[23].src_end = (uint32_t)(uintptr_t)&slave_tx[slave_tx_len - 1];
+    dma_table[23].dst_end = (uint32_t)(uintptr_t)&UART1_DR_R;
+    dma_table[23].ctl = (3u << 30)                  // DSTINC: none
+                        | (0u << 28)                // DSTSIZE: byte
+                        | (0u << 26)                // SRCINC: byte
+                        | (0u << 24)                // SRCSIZE: byte
+                        | (0u << 14)                // ARBSIZE: 1
+                        | ((slave_tx_len - 1) << 4) // XFERSIZE
+                        | 0x1;                      // Basic mode
+    UDMA_ENASET_R = 1 << 23;
+}
+#endif
+
+/***********************************************************
+ * UART0_Init() – 115200 8N1 at 16 MHz (IBRD 8, FBRD 44)
+ ***********************************************************/
+void UART0_Init(void)
+{
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
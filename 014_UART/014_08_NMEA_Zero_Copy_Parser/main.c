@@ -0,0 +1,517 @@
+/***************************************************************
+ * PROJECT NAME : Zero-Copy NMEA Parser over the UART1 RX Ring
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - UART1 (PB0 = RX from the GPS TX), 9600 8N1
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * A GPS module sends text sentences such as
+ *
+ *   $GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,...*47
+ *
+ * Instead of collecting them with UART1Rx() into a string and
+ * then splitting that string, the parser runs straight over
+ * the RX ring buffer filled by UART1_Handler:
+ *
+ *   - nmea_feed() scans only the bytes that arrived since the
+ *     last call, so a sentence costs one pass however it is
+ *     split across interrupts.
+ *   - The XOR checksum is updated per byte and compared when
+ *     the "*hh" trailer arrives; bad sentences never reach the
+ *     application.
+ *   - Fields are slices {pos, len} into the ring (positions are
+ *     free-running, "& mask" gives the index), so nothing is
+ *     copied, even when a sentence wraps around the ring end.
+ *   - The ring is only released (uart1_rx_tail) once the
+ *     application is done with the sentence.
+ *
+ * Conversions work on slices and use integers only:
+ *   nmea_int()     "545"        → 545
+ *   nmea_fixed()   "022.4", 2   → 2240       (value x 10^n)
+ *   nmea_coord()   "4807.038",N → 481173000  (degrees x 10^7)
+ *   nmea_time_ms() "123519.50"  → 45319500   (ms since 00:00)
+ *
+ * The same parser runs over a plain array (mask = 0xFFFFFFFF);
+ * 017_QEMU_Target_Tests replays a recorded log through it and
+ * reports the parsing speed.
+ *
+ * Demo: GGA and RMC sentences are decoded and printed on UART0.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define UART1_RING_SIZE 512 // power of two
+#define NMEA_MAX_FIELDS 24
+#define NMEA_MAX_LEN 82     // longest sentence allowed by NMEA 0183
+
+/***********************************************************
+ * NMEA PARSER
+ ***********************************************************/
+typedef struct
+{
+    uint32_t pos; // free-running position of the first character
+    uint32_t len;
+} nmea_slice_t;
+
+typedef struct
+{
+    const volatile uint8_t *buf; // ring (or plain array)
+    uint32_t mask;               // ring size - 1
+    uint32_t end;                // position after the '\n'
+    uint32_t nfields;            // field[0] = address, e.g. "GPGGA"
+    nmea_slice_t field[NMEA_MAX_FIELDS];
+} nmea_sentence_t;
+
+enum
+{
+    NMEA_IDLE,
+    NMEA_BODY,
+    NMEA_CK1,
+    NMEA_CK2,
+    NMEA_EOL,
+};
+
+typedef struct
+{
+    uint8_t state;
+    uint8_t sum;     // XOR of the body so far
+    uint8_t rx_sum;  // "*hh" from the sentence
+    uint32_t pos;    // next position to scan
+    uint32_t start;  // position of '$'
+    uint32_t keep;   // first position still needed
+    uint32_t good, bad;
+    nmea_sentence_t s;
+} nmea_parser_t;
+
+/***********************************************************
+ * UART1 RX RING (power-of-two size, one producer / one consumer)
+ ***********************************************************/
+volatile uint8_t uart1_rx_ring[UART1_RING_SIZE];
+volatile uint32_t uart1_rx_head, uart1_rx_tail;
+volatile uint32_t uart1_rx_overruns;
+
+nmea_parser_t gps;
+
+// Function prototypes
+void nmea_init(nmea_parser_t *p, uint32_t pos);
+int nmea_feed(nmea_parser_t *p, const volatile uint8_t *buf, uint32_t mask, uint32_t head);
+int nmea_is(const nmea_sentence_t *s, const char *type);
+int32_t nmea_int(const nmea_sentence_t *s, uint32_t f);
+int32_t nmea_fixed(const nmea_sentence_t *s, uint32_t f, uint32_t decimals);
+int32_t nmea_coord(const nmea_sentence_t *s, uint32_t f);
+int32_t nmea_time_ms(const nmea_sentence_t *s, uint32_t f);
+void print_fixed(int32_t v, uint32_t decimals);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    nmea_sentence_t *s = &gps.s;
+
+    /***********************************************************
+     * STEP 1: Enable clocks – GPIO A, B, UART0, UART1
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x03;
+    SYSCTL_RCGCUART_R |= 0x03;
+    while ((SYSCTL_PRGPIO_R & 0x03) != 0x03)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 16 MHz (IBRD 8, FBRD 44)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: UART1 – 9600 8N1 (IBRD 104, FBRD 11), RX interrupt
+     ***********************************************************/
+    GPIO_PORTB_AFSEL_R |= 0x03;
+    GPIO_PORTB_DEN_R |= 0x03;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0xFF) | 0x11;
+
+    UART1_CTL_R = 0x00;
+    UART1_IBRD_R = 104;
+    UART1_FBRD_R = 11;
+    UART1_LCRH_R = 0x70; // 8-bit, FIFO enable
+    UART1_CC_R = 0x00;
+    UART1_IFLS_R = 0x10; // RX level 1/2
+    UART1_IM_R = 0x50;   // RXIM, RTIM
+    UART1_CTL_R = 0x301;
+
+    nmea_init(&gps, 0);
+    NVIC_EN0_R = 1 << 6; // IRQ 6 = UART1
+    __enable_irq();
+
+    UART0_SendString("\r\nNMEA parser ready\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – parse new bytes in place
+     ***********************************************************/
+    while (1)
+    {
+        if (!nmea_feed(&gps, uart1_rx_ring, UART1_RING_SIZE - 1, uart1_rx_head))
+        {
+            uart1_rx_tail = gps.keep; // Garbage / bad sentences
+            continue;
+        }
+
+        if (nmea_is(s, "GGA") && s->nfields >= 10)
+        {
+            UART0_SendString("GGA t=");
+            UART0_SendNumber((uint32_t)nmea_time_ms(s, 1));
+            UART0_SendString(" lat=");
+            print_fixed(nmea_coord(s, 2), 7);
+            UART0_SendString(" lon=");
+            print_fixed(nmea_coord(s, 4), 7);
+            UART0_SendString(" sats=");
+            UART0_SendNumber((uint32_t)nmea_int(s, 7));
+            UART0_SendString(" alt=");
+            print_fixed(nmea_fixed(s, 9, 1), 1);
+            UART0_SendString("\r\n");
+        }
+        else if (nmea_is(s, "RMC") && s->nfields >= 9)
+        {
+            UART0_SendString("RMC speed=");
+            print_fixed(nmea_fixed(s, 7, 2), 2);
+            UART0_SendString(" kn course=");
+            print_fixed(nmea_fixed(s, 8, 1), 1);
+            UART0_SendString("\r\n");
+        }
+
+        uart1_rx_tail = gps.keep; // Sentence no longer needed
+    }
+}
+
+/***********************************************************
+ * UART1_Handler() – drain RX FIFO into the ring buffer
+ ***********************************************************/
+void UART1_Handler(void)
+{
+    uint32_t data;
+
+    while ((UART1_FR_R & 0x10) == 0) // RX FIFO not empty
+    {
+        data = UART1_DR_R;
+
+        if ((uart1_rx_head - uart1_rx_tail) < UART1_RING_SIZE)
+        {
+            uart1_rx_ring[uart1_rx_head & (UART1_RING_SIZE - 1)] = (uint8_t)data;
+            uart1_rx_head++;
+        }
+        else
+        {
+            uart1_rx_overruns++; // Parser too slow
+        }
+    }
+
+    UART1_ICR_R = 0x50;
+}
+
+/***********************************************************
+ * nmea_init() – start scanning at position pos
+ ***********************************************************/
+void nmea_init(nmea_parser_t *p, uint32_t pos)
+{
+    p->state = NMEA_IDLE;
+    p->pos = p->start = p->keep = pos;
+    p->good = p->bad = 0;
+}
+
+/*** hex_digit() – '0'-'9', 'A'-'F' → 0 - 15, anything else → -1 ***/
+static int hex_digit(uint8_t c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/***********************************************************
+ * nmea_feed() – scan buf from p->pos up to head
+ * Returns 1 as soon as a sentence with a valid checksum ends
+ * (p->s describes it, scanning resumes after it on the next
+ * call), or 0 when all available bytes are consumed.
+ * p->keep is the first position the caller must not release.
+ ***********************************************************/
+int nmea_feed(nmea_parser_t *p, const volatile uint8_t *buf, uint32_t mask, uint32_t head)
+{
+    nmea_sentence_t *s = &p->s;
+    uint32_t pos = p->pos;
+    uint8_t state = p->state, sum = p->sum, c;
+    int v;
+
+    while (pos != head)
+    {
+        c = buf[pos & mask];
+
+        if (c == '$') // Always starts a new sentence
+        {
+            if (state != NMEA_IDLE)
+                p->bad++;
+            state = NMEA_BODY;
+            sum = 0;
+            p->start = pos;
+            s->nfields = 1;
+            s->field[0].pos = pos + 1;
+            pos++;
+            continue;
+        }
+
+        switch (state)
+        {
+        case NMEA_BODY:
+            if (c == ',' || c == '*')
+            {
+                s->field[s->nfields - 1].len = pos - s->field[s->nfields - 1].pos;
+                if (c == '*')
+                {
+                    state = NMEA_CK1;
+                    break;
+                }
+                sum ^= c;
+                if (s->nfields < NMEA_MAX_FIELDS)
+                {
+                    s->field[s->nfields++].pos = pos + 1;
+                }
+                else
+                {
+                    state = NMEA_IDLE;
+                    p->bad++;
+                }
+            }
+            else if (c < 0x20 || c > 0x7E || pos - p->start >= NMEA_MAX_LEN)
+            {
+                state = NMEA_IDLE; // Line ended without "*hh"
+                p->bad++;
+            }
+            else
+            {
+                sum ^= c;
+            }
+            break;
+
+        case NMEA_CK1:
+        case NMEA_CK2:
+            v = hex_digit(c);
+            if (v < 0)
+            {
+                state = NMEA_IDLE;
+                p->bad++;
+            }
+            else if (state == NMEA_CK1)
+            {
+                p->rx_sum = (uint8_t)(v << 4);
+                state = NMEA_CK2;
+            }
+            else
+            {
+                p->rx_sum |= (uint8_t)v;
+                state = NMEA_EOL;
+            }
+            break;
+
+        case NMEA_EOL:
+            if (c == '\r')
+                break;
+            state = NMEA_IDLE;
+            if (c == '\n' && p->rx_sum == sum)
+            {
+                pos++;
+                s->buf = buf;
+                s->mask = mask;
+                s->end = pos;
+                p->good++;
+                p->pos = p->keep = pos;
+                p->state = state;
+                return 1;
+            }
+            p->bad++;
+            break;
+
+        default: // NMEA_IDLE: skip until '$'
+            break;
+        }
+        pos++;
+    }
+
+    p->pos = pos;
+    p->state = state;
+    p->sum = sum;
+    p->keep = (state == NMEA_IDLE) ? pos : p->start;
+    return 0;
+}
+
+/***********************************************************
+ * nmea_is() – sentence type without the talker ("GGA" matches
+ * "GPGGA" and "GNGGA")
+ ***********************************************************/
+int nmea_is(const nmea_sentence_t *s, const char *type)
+{
+    const nmea_slice_t *f = &s->field[0];
+    uint32_t i;
+
+    if (f->len != 5)
+        return 0;
+
+    for (i = 0; i < 3; i++)
+        if (s->buf[(f->pos + 2 + i) & s->mask] != (uint8_t)type[i])
+            return 0;
+
+    return 1;
+}
+
+/***********************************************************
+ * nmea_fixed() – decimal field as an integer x 10^decimals
+ * Extra fraction digits are truncated, missing ones count as 0.
+ * An empty or missing field gives 0.
+ ***********************************************************/
+int32_t nmea_fixed(const nmea_sentence_t *s, uint32_t f, uint32_t decimals)
+{
+    const nmea_slice_t *sl;
+    uint32_t i, frac = 0, value = 0, neg = 0, in_frac = 0;
+    uint8_t c;
+
+    if (f >= s->nfields)
+        return 0;
+
+    sl = &s->field[f];
+    for (i = 0; i < sl->len; i++)
+    {
+        c = s->buf[(sl->pos + i) & s->mask];
+
+        if (c == '-' && i == 0)
+            neg = 1;
+        else if (c == '.')
+            in_frac = 1;
+        else if (c >= '0' && c <= '9' && (!in_frac || frac < decimals))
+        {
+            value = value * 10 + (c - '0');
+            frac += in_frac;
+        }
+    }
+
+    for (; frac < decimals; frac++)
+        value *= 10;
+
+    return neg ? -(int32_t)value : (int32_t)value;
+}
+
+/*** nmea_int() – integer part of a decimal field ***/
+int32_t nmea_int(const nmea_sentence_t *s, uint32_t f)
+{
+    return nmea_fixed(s, f, 0);
+}
+
+/***********************************************************
+ * nmea_coord() – "dddmm.mmmmm" in field f and N/S/E/W in f+1
+ * to degrees x 10^7 (about 1 cm resolution)
+ * minutes x 10^5 / 60 x 100 = minutes x 10^5 x 5 / 3
+ ***********************************************************/
+int32_t nmea_coord(const nmea_sentence_t *s, uint32_t f)
+{
+    uint32_t v = (uint32_t)nmea_fixed(s, f, 5); // dddmm x 10^5
+    uint32_t deg = v / 10000000;
+    uint32_t min_e5 = v % 10000000;
+    int32_t result = (int32_t)(deg * 10000000 + (min_e5 * 5 + 1) / 3);
+    uint8_t hemi;
+
+    if (f + 1 < s->nfields && s->field[f + 1].len)
+    {
+        hemi = s->buf[s->field[f + 1].pos & s->mask];
+        if (hemi == 'S' || hemi == 'W')
+            result = -result;
+    }
+    return result;
+}
+
+/***********************************************************
+ * nmea_time_ms() – "hhmmss.sss" to ms since midnight
+ ***********************************************************/
+int32_t nmea_time_ms(const nmea_sentence_t *s, uint32_t f)
+{
+    uint32_t v = (uint32_t)nmea_fixed(s, f, 3); // hhmmss x 1000
+    uint32_t hh = v / 10000000, mm = (v / 100000) % 100, ss_ms = v % 100000;
+
+    return (int32_t)((hh * 3600 + mm * 60) * 1000 + ss_ms);
+}
+
+/***********************************************************
+ * print_fixed() – signed value with a decimal point
+ ***********************************************************/
+void print_fixed(int32_t v, uint32_t decimals)
+{
+    uint32_t u, div = 1, i;
+
+    if (v < 0)
+    {
+        UART0Tx('-');
+        u = (uint32_t)-v;
+    }
+    else
+    {
+        u = (uint32_t)v;
+    }
+
+    for (i = 0; i < decimals; i++)
+        div *= 10;
+
+    UART0_SendNumber(u / div);
+    if (decimals)
+    {
+        UART0Tx('.');
+        for (u %= div, div /= 10; div; div /= 10)
+            UART0Tx((char)('0' + (u / div) % 10));
+    }
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,602 @@
+/***************************************************************
+ * PROJECT NAME : Three-Phase SVPWM with Field-Oriented Control
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - PWM0 generators 0-2, center-aligned 20 kHz, dead band
+ *          phase A : M0PWM0 / M0PWM1 (PB6 high / PB7 low)
+ *          phase B : M0PWM2 / M0PWM3 (PB4 high / PB5 low)
+ *          phase C : M0PWM4 / M0PWM5 (PE4 high / PE5 low)
+ *      - ADC0 SS1, phase currents ia (PE3, AIN0), ib (PE2, AIN1)
+ *        triggered by PWM0 generator 0 at the counter peak
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 015_02 sets the duty of one channel. A BLDC/PMSM motor needs
+ * three half bridges driven with sinusoidal voltages whose
+ * angle follows the rotor. This demo is the control core for a
+ * three-phase inverter board (e.g. a BOOSTXL-DRV8305 style
+ * power stage with low-side shunts and current amplifiers
+ * centered at 1.65 V).
+ *
+ * PWM timing (80 MHz PWM clock):
+ *   Up/down counters, LOAD = 2000 → 20 kHz. The three
+ *   generators are started together with PWMSYNC and their
+ *   compare values use global update (PWMCTL GLOBALSYNC), so
+ *   all three phases change at the same counter zero. The dead
+ *   band block makes each low-side output the complement of
+ *   its high side with DEAD_TICKS on both edges.
+ *
+ *   High side on while counter < CMPA, i.e. the pulse is
+ *   centered on zero. At the counter peak (LOAD) all low sides
+ *   conduct, so the shunt currents are valid there: generator 0
+ *   triggers ADC0 SS1 at LOAD (mid-PWM sampling).
+ *
+ * Control chain (ADC0SS1_Handler, every 50 us):
+ *   ia, ib → Clarke → (alpha, beta) → Park(theta) → (id, iq)
+ *   PI(id_ref - id) → vd, PI(iq_ref - iq) → vq
+ *   |v| limited to the SVPWM circle, vd first
+ *   (vd, vq) → inverse Park → (valpha, vbeta) → SVPWM → CMPA x3
+ *
+ *   SVPWM is done as min-max zero-sequence injection: the phase
+ *   voltages are shifted by -(max + min) / 2, which gives the
+ *   same switching pattern as the sector method without sector
+ *   tables.
+ *
+ * Fixed point:
+ *   currents  Q15, 32767 = full scale of the current amplifier
+ *   voltages  Q15, 32767 = Vbus / sqrt(3) (inscribed circle of
+ *             the SVPWM hexagon, the linear limit)
+ *   angle     16 bit, 65536 = 360 electrical degrees
+ *   sin/cos   quarter-wave table, linear interpolation
+ *   PI gains  Q12
+ *
+ * Rotor angle: this core has no position sensor input; theta is
+ * integrated from a commanded electrical speed (open-loop I/F
+ * start-up). A QEI or observer angle replaces foc.phase.
+ *
+ * Cycle budget: 80 MHz / 20 kHz = 4000 cycles per period.
+ * foc_step() is benchmarked in 017_QEMU_Target_Tests, which
+ * fails when it takes more than a quarter of that.
+ *
+ * Offsets: after reset the outputs are off and the first 1024
+ * samples give the zero-current ADC code of each amplifier.
+ *
+ * Commands (UART0, end with Enter):
+ *      r         enable the bridge and run
+ *      x         stop (all outputs off)
+ *      q <n>     iq reference, Q15 (torque)
+ *      d <n>     id reference, Q15
+ *      w <hz>    electrical speed, Hz (negative = reverse)
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define PWM_HZ 20000
+#define PWM_LOAD (SYSCLK / PWM_HZ / 2) // up/down count: 2000
+#define DEAD_TICKS 80                  // 1 us
+#define OFFSET_TICKS 1024
+#define SPEED_PER_HZ 214748            // 2^32 / PWM_HZ
+#define VMAX 32767                     // SVPWM linear limit, Q15
+#define INV_SQRT3_Q15 18919
+#define SQRT3_Q14 28378
+#define DUTY_K ((PWM_LOAD * INV_SQRT3_Q15) >> 15) // counts per 1.0 of v
+
+typedef struct
+{
+    int32_t kp, ki; // Q12
+    int32_t integ;  // Q15
+} foc_pi_t;
+
+typedef struct
+{
+    uint32_t phase;         // angle << 16
+    int32_t speed;          // phase step per period
+    int32_t id_ref, iq_ref; // Q15
+    int32_t off_a, off_b;   // zero-current ADC codes
+    int32_t ia, ib, id, iq; // Q15
+    int32_t vd, vq;         // Q15
+    foc_pi_t pi_d, pi_q;
+    uint16_t cmp[3];        // PWM compare values A, B, C
+} foc_t;
+
+// sin(0 .. 90°) in 64 steps, Q15; the last entry is sin(90° + step)
+// so that interpolating at exactly 90° stays in the table
+const int16_t foc_sin_table[66] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962,
+    8739, 9512, 10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446,
+    16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005,
+    22594, 23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245,
+    27683, 28105, 28510, 28898, 29268, 29621, 29956, 30273, 30571, 30852,
+    31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609,
+    32678, 32728, 32757, 32767, 32757};
+
+foc_t foc;
+volatile uint8_t foc_run;
+volatile uint32_t foc_ticks;
+uint32_t off_sum_a, off_sum_b;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void PWM0_Init3Phase(void);
+void ADC0_InitCurrents(void);
+void foc_init(foc_t *f);
+void foc_step(foc_t *f, uint32_t raw_a, uint32_t raw_b);
+void foc_currents(foc_t *f, int32_t ia, int32_t ib, int32_t s, int32_t c);
+void foc_svpwm(foc_t *f, int32_t valpha, int32_t vbeta);
+int32_t foc_sin(uint16_t a);
+int32_t foc_pi(foc_pi_t *pi, int32_t err, int32_t limit);
+uint32_t isqrt32(uint32_t x);
+void command(char *line);
+int32_t parse_signed(char **p);
+void print_signed(int32_t v);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    char line[32];
+    uint32_t len = 0, last = 0;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz system clock, enable clocks
+     ***********************************************************/
+    PLL_Init80MHz();
+    SYSCTL_RCGCGPIO_R |= 0x13; // Ports A, B, E
+    SYSCTL_RCGCPWM_R |= 0x01;
+    SYSCTL_RCGCADC_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x13) != 0x13)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 80 MHz (IBRD 43, FBRD 26)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: Controller, current sampling, PWM (outputs off)
+     ***********************************************************/
+    foc_init(&foc);
+    ADC0_InitCurrents();
+    PWM0_Init3Phase();
+
+    NVIC_EN0_R = 1 << 15; // IRQ 15 = ADC0 SS1
+    __enable_irq();
+
+    UART0_SendString("\r\nFOC core ready, measuring offsets\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – commands and a 2 Hz status line
+     ***********************************************************/
+    while (1)
+    {
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            c = (char)UART0_DR_R;
+            if (c == '\r' || c == '\n')
+            {
+                line[len] = 0;
+                if (len)
+                    command(line);
+                len = 0;
+            }
+            else if (len < sizeof(line) - 1)
+            {
+                line[len++] = c;
+            }
+        }
+
+        if (foc_ticks - last >= PWM_HZ / 2)
+        {
+            last = foc_ticks;
+            UART0_SendString(foc_run ? "run id " : "off id ");
+            print_signed(foc.id);
+            UART0_SendString(" iq ");
+            print_signed(foc.iq);
+            UART0_SendString(" vd ");
+            print_signed(foc.vd);
+            UART0_SendString(" vq ");
+            print_signed(foc.vq);
+            UART0_SendString("\r\n");
+        }
+    }
+}
+
+/***********************************************************
+ * PWM0_Init3Phase() – generators 0-2, up/down 20 kHz,
+ * complementary outputs with dead band, synchronized
+ ***********************************************************/
+void PWM0_Init3Phase(void)
+{
+    SYSCTL_RCC_R &= ~0x00100000; // USEPWMDIV = 0: PWM clock = 80 MHz
+
+    GPIO_PORTB_AFSEL_R |= 0xF0;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0xFFFF0000) | 0x44440000;
+    GPIO_PORTB_DEN_R |= 0xF0;
+    GPIO_PORTE_AFSEL_R |= 0x30;
+    GPIO_PORTE_PCTL_R = (GPIO_PORTE_PCTL_R & ~0x00FF0000) | 0x00440000;
+    GPIO_PORTE_DEN_R |= 0x30;
+
+    PWM0_ENABLE_R = 0x00; // Outputs off until "r"
+
+    PWM0_0_CTL_R = 0x00;
+    PWM0_0_LOAD_R = PWM_LOAD;
+    PWM0_0_CMPA_R = PWM_LOAD / 2;
+    PWM0_0_GENA_R = 0xE0; // CMPA up: low, CMPA down: high
+    PWM0_0_DBCTL_R = 0x01;
+    PWM0_0_DBRISE_R = DEAD_TICKS;
+    PWM0_0_DBFALL_R = DEAD_TICKS;
+    PWM0_0_INTEN_R = 0x0200; // TRCNTLOAD: ADC trigger at the peak
+
+    PWM0_1_CTL_R = 0x00;
+    PWM0_1_LOAD_R = PWM_LOAD;
+    PWM0_1_CMPA_R = PWM_LOAD / 2;
+    PWM0_1_GENA_R = 0xE0;
+    PWM0_1_DBCTL_R = 0x01;
+    PWM0_1_DBRISE_R = DEAD_TICKS;
+    PWM0_1_DBFALL_R = DEAD_TICKS;
+
+    PWM0_2_CTL_R = 0x00;
+    PWM0_2_LOAD_R = PWM_LOAD;
+    PWM0_2_CMPA_R = PWM_LOAD / 2;
+    PWM0_2_GENA_R = 0xE0;
+    PWM0_2_DBCTL_R = 0x01;
+    PWM0_2_DBRISE_R = DEAD_TICKS;
+    PWM0_2_DBFALL_R = DEAD_TICKS;
+
+    // ENABLE, MODE = up/down, CMPAUPD = global
+    PWM0_0_CTL_R = 0x13;
+    PWM0_1_CTL_R = 0x13;
+    PWM0_2_CTL_R = 0x13;
+    PWM0_SYNC_R = 0x07; // Restart all three counters together
+}
+
+/***********************************************************
+ * ADC0_InitCurrents() – SS1: AIN0 (ia), AIN1 (ib),
+ * triggered by PWM0 generator 0
+ ***********************************************************/
+void ADC0_InitCurrents(void)
+{
+    GPIO_PORTE_AFSEL_R |= 0x0C;
+    GPIO_PORTE_DEN_R &= ~0x0C;
+    GPIO_PORTE_AMSEL_R |= 0x0C;
+
+    ADC0_ACTSS_R &= ~0x02;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0x00F0) | 0x0060; // SS1: PWM gen 0
+    ADC0_TSSEL_R &= ~0x30;                          // Gen 0 of PWM0
+    ADC0_SSMUX1_R = 0x10;                           // AIN0, AIN1
+    ADC0_SSCTL1_R = 0x60;                           // END1, IE1
+    ADC0_IM_R |= 0x02;
+    ADC0_ACTSS_R |= 0x02;
+}
+
+/***********************************************************
+ * ADC0SS1_Handler() – control loop at the PWM rate
+ ***********************************************************/
+void ADC0SS1_Handler(void)
+{
+    uint32_t ra = ADC0_SSFIFO1_R & 0xFFF;
+    uint32_t rb = ADC0_SSFIFO1_R & 0xFFF;
+
+    ADC0_ISC_R = 0x02;
+    foc_ticks++;
+
+    if (foc_ticks <= OFFSET_TICKS) // Outputs off: zero current
+    {
+        off_sum_a += ra;
+        off_sum_b += rb;
+        if (foc_ticks == OFFSET_TICKS)
+        {
+            foc.off_a = off_sum_a / OFFSET_TICKS;
+            foc.off_b = off_sum_b / OFFSET_TICKS;
+        }
+        return;
+    }
+
+    if (!foc_run)
+        return;
+
+    foc_step(&foc, ra, rb);
+
+    PWM0_0_CMPA_R = foc.cmp[0];
+    PWM0_1_CMPA_R = foc.cmp[1];
+    PWM0_2_CMPA_R = foc.cmp[2];
+    PWM0_CTL_R = 0x07; // GLOBALSYNC0-2: apply all at the next zero
+}
+
+/*** foc_init() – nominal offsets, gains, zero references ***/
+void foc_init(foc_t *f)
+{
+    f->phase = 0;
+    f->speed = 0;
+    f->id_ref = 0;
+    f->iq_ref = 0;
+    f->off_a = 2048;
+    f->off_b = 2048;
+    f->ia = f->ib = f->id = f->iq = 0;
+    f->vd = f->vq = 0;
+    f->pi_d.kp = 2048; // 0.5
+    f->pi_d.ki = 205;  // 0.05 per period
+    f->pi_d.integ = 0;
+    f->pi_q = f->pi_d;
+    f->cmp[0] = f->cmp[1] = f->cmp[2] = PWM_LOAD / 2;
+}
+
+/***********************************************************
+ * foc_step() – one control period
+ * raw_a, raw_b: 12-bit ADC codes of the phase A/B amplifiers
+ ***********************************************************/
+void foc_step(foc_t *f, uint32_t raw_a, uint32_t raw_b)
+{
+    uint16_t theta = (uint16_t)(f->phase >> 16);
+    int32_t s = foc_sin(theta);
+    int32_t c = foc_sin((uint16_t)(theta + 0x4000));
+    int32_t vq_max;
+
+    foc_currents(f, ((int32_t)raw_a - f->off_a) << 4,
+                 ((int32_t)raw_b - f->off_b) << 4, s, c);
+
+    // d axis first, q gets what is left of the voltage circle
+    f->vd = foc_pi(&f->pi_d, f->id_ref - f->id, VMAX);
+    vq_max = (int32_t)isqrt32((uint32_t)(VMAX * VMAX - f->vd * f->vd));
+    f->vq = foc_pi(&f->pi_q, f->iq_ref - f->iq, vq_max);
+
+    // Inverse Park
+    foc_svpwm(f, ((f->vd * c) >> 15) - ((f->vq * s) >> 15),
+              ((f->vd * s) >> 15) + ((f->vq * c) >> 15));
+
+    f->phase += (uint32_t)f->speed;
+}
+
+/***********************************************************
+ * foc_currents() – Clarke and Park
+ * ia + ib + ic = 0, so ic is not measured:
+ *   alpha = ia, beta = (ia + 2 ib) / sqrt(3)
+ *   id =  alpha cos + beta sin
+ *   iq = -alpha sin + beta cos
+ ***********************************************************/
+void foc_currents(foc_t *f, int32_t ia, int32_t ib, int32_t s, int32_t c)
+{
+    int32_t alpha = ia;
+    int32_t beta = ((ia + 2 * ib) * INV_SQRT3_Q15) >> 15;
+
+    f->ia = ia;
+    f->ib = ib;
+    f->id = ((alpha * c) >> 15) + ((beta * s) >> 15);
+    f->iq = ((beta * c) >> 15) - ((alpha * s) >> 15);
+}
+
+/***********************************************************
+ * foc_svpwm() – (valpha, vbeta) → three compare values
+ *   va = alpha
+ *   vb = (-alpha + sqrt(3) beta) / 2
+ *   vc = (-alpha - sqrt(3) beta) / 2
+ *   shift all by -(max + min) / 2, then
+ *   CMPA = LOAD / 2 + v x LOAD / sqrt(3)   (v in Vbus / sqrt(3))
+ ***********************************************************/
+void foc_svpwm(foc_t *f, int32_t valpha, int32_t vbeta)
+{
+    int32_t b3 = (vbeta * SQRT3_Q14) >> 14;
+    int32_t v[3], vmin, vmax, mid, d;
+    uint32_t i;
+
+    v[0] = valpha;
+    v[1] = (-valpha + b3) >> 1;
+    v[2] = (-valpha - b3) >> 1;
+
+    vmin = vmax = v[0];
+    for (i = 1; i < 3; i++)
+    {
+        vmin = v[i] < vmin ? v[i] : vmin;
+        vmax = v[i] > vmax ? v[i] : vmax;
+    }
+    mid = (vmax + vmin) >> 1;
+
+    for (i = 0; i < 3; i++)
+    {
+        d = PWM_LOAD / 2 + (((v[i] - mid) * DUTY_K) >> 15);
+        d = d < 1 ? 1 : d;
+        d = d > PWM_LOAD - 1 ? PWM_LOAD - 1 : d;
+        f->cmp[i] = (uint16_t)d;
+    }
+}
+
+/***********************************************************
+ * foc_sin() – sin(a) in Q15, a: 65536 = 360°
+ ***********************************************************/
+int32_t foc_sin(uint16_t a)
+{
+    uint32_t p = a & 0x3FFF; // position in the quadrant
+    uint32_t i, f;
+    int32_t s;
+
+    if (a & 0x4000) // 90 - 180°, 270 - 360°: mirrored
+        p = 0x4000 - p;
+
+    i = p >> 8;
+    f = p & 0xFF;
+    s = foc_sin_table[i] + (((foc_sin_table[i + 1] - foc_sin_table[i]) * (int32_t)f) >> 8);
+
+    return (a & 0x8000) ? -s : s;
+}
+
+/***********************************************************
+ * foc_pi() – PI with the integrator clamped to ±limit
+ ***********************************************************/
+int32_t foc_pi(foc_pi_t *pi, int32_t err, int32_t limit)
+{
+    int32_t out;
+
+    pi->integ += (pi->ki * err) >> 12;
+    pi->integ = pi->integ > limit ? limit : pi->integ;
+    pi->integ = pi->integ < -limit ? -limit : pi->integ;
+
+    out = pi->integ + ((pi->kp * err) >> 12);
+    out = out > limit ? limit : out;
+    return out < -limit ? -limit : out;
+}
+
+/*** isqrt32() – integer square root, bit by bit ***/
+uint32_t isqrt32(uint32_t x)
+{
+    uint32_t r = 0, b = 1u << 30;
+
+    while (b > x)
+        b >>= 2;
+    while (b)
+    {
+        if (x >= r + b)
+        {
+            x -= r + b;
+            r = (r >> 1) + b;
+        }
+        else
+        {
+            r >>= 1;
+        }
+        b >>= 2;
+    }
+    return r;
+}
+
+/***********************************************************
+ * command() – r, x, q <n>, d <n>, w <hz>
+ ***********************************************************/
+void command(char *line)
+{
+    char *p = line + 1;
+
+    switch (line[0])
+    {
+    case 'r': // Clear the integrators, then enable the bridge
+        if (foc_ticks < OFFSET_TICKS)
+            break;
+        foc.pi_d.integ = 0;
+        foc.pi_q.integ = 0;
+        foc_run = 1;
+        PWM0_ENABLE_R = 0x3F;
+        break;
+
+    case 'x':
+        PWM0_ENABLE_R = 0x00;
+        foc_run = 0;
+        break;
+
+    case 'q':
+        foc.iq_ref = parse_signed(&p);
+        break;
+
+    case 'd':
+        foc.id_ref = parse_signed(&p);
+        break;
+
+    case 'w':
+        foc.speed = parse_signed(&p) * SPEED_PER_HZ;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*** parse_signed() – skip spaces, read an optional '-' and digits ***/
+int32_t parse_signed(char **p)
+{
+    int32_t n = 0, neg = 0;
+
+    while (**p == ' ')
+        (*p)++;
+    if (**p == '-')
+    {
+        neg = 1;
+        (*p)++;
+    }
+    while (**p >= '0' && **p <= '9')
+        n = n * 10 + (*(*p)++ - '0');
+
+    return neg ? -n : n;
+}
+
+/*** print_signed() – signed decimal ***/
+void print_signed(int32_t v)
+{
+    if (v < 0)
+    {
+        UART0Tx('-');
+        UART0_SendNumber((uint32_t)-v);
+    }
+    else
+    {
+        UART0_SendNumber((uint32_t)v);
+    }
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,474 @@
+/***************************************************************
+ * PROJECT NAME : PWM Audio Playback with IMA-ADPCM Decoding
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - PWM0 generator 0, M0PWM0 on PB6 (156 kHz carrier)
+ *      - Timer0A (8 kHz sample clock, uDMA request)
+ *      - uDMA channel 18 (Timer0A → PWM0_0_CMPA, ping-pong)
+ *      - Timer1 (free-running, CPU load measurement)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 005_Buzzer can only switch PB3 on and off. This demo plays
+ * voice prompts: IMA-ADPCM clips (4 bits per sample) are
+ * stored in flash, decoded into a small ring and played
+ * through a PWM DAC.
+ *
+ * Output stage:
+ *   M0PWM0 (PB6) → RC low-pass (e.g. 1 k / 10 nF, ~16 kHz)
+ *   → small audio amplifier → speaker.
+ *   PWM clock 80 MHz, LOAD = 511: 9-bit duty at 156 kHz,
+ *   far above the audio band, so the RC filter removes it.
+ *
+ * Sample path (no CPU per sample):
+ *   Timer0A times out at 8 kHz and requests uDMA channel 18,
+ *   which copies one word from the ring into PWM0_0_CMPA_R.
+ *   CMPA updates are synchronized to the counter reload, so
+ *   every carrier period uses one complete duty value.
+ *   The ring has two halves of HALF samples in ping-pong mode;
+ *   when one half has been played, the uDMA done interrupt
+ *   (Timer0A vector) refills it while the other half plays.
+ *   That interrupt needs no enable in GPTMIMR on the TM4C123
+ *   (which has no DMA bit there); the timeout interrupt is
+ *   left masked.
+ *
+ * Decoding and mixing (TIMER0A_Handler, once per HALF):
+ *   voice_render() decodes each active voice into acc[] with
+ *   its own volume (Q8), then audio_fill() applies the master
+ *   volume, saturates to 16 bits and converts to the duty:
+ *      duty = (sample + 32768) >> 7      (0 - 511)
+ *   Two voices can play at once, e.g. a prompt over a tone.
+ *
+ * CPU load: Timer1 measures the refill time; the main loop
+ * prints it in permille once a second (about 10 - 20 permille
+ * with both voices active).
+ *
+ * Clip format: IMA-ADPCM, mono, 8 kHz, low nibble first,
+ * predictor 0 and step index 0 at the start (as produced by
+ * any IMA-ADPCM encoder with a zero header).
+ *
+ * Commands (UART0, single keys):
+ *      1 / 2     play the chime on voice 0 / voice 1
+ *      + / -     master volume up / down
+ *      s         stop both voices
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define SAMPLE_HZ 8000
+#define PWM_LOAD 511   // 80 MHz / 512 = 156 kHz carrier
+#define HALF 128       // samples per ping-pong half (16 ms)
+#define NVOICES 2
+#define DMA_CH_TIMER0A 18
+
+typedef struct
+{
+    const uint8_t *data; // 2 samples per byte
+    uint32_t samples;
+} adpcm_clip_t;
+
+typedef struct
+{
+    const adpcm_clip_t *clip; // NULL = idle
+    uint32_t pos;             // next sample
+    int32_t pred;             // decoder state
+    int32_t index;
+    int32_t vol;              // Q8, 256 = 1.0
+} voice_t;
+
+/***********************************************************
+ * IMA-ADPCM TABLES
+ ***********************************************************/
+const int16_t ima_step[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+const int8_t ima_index_adj[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+/***********************************************************
+ * CLIP: 125 ms chime (880 Hz + 1320 Hz, decaying), 8 kHz
+ ***********************************************************/
+const uint8_t chime_data[500] = {
+    0x70, 0x77, 0xFF, 0xFF, 0x14, 0x50, 0x15, 0xED, 0x0A, 0x44, 0x91, 0x9C,
+    0x18, 0x10, 0x18, 0x12, 0xFB, 0x8A, 0x63, 0x81, 0xAB, 0x19, 0x02, 0x18,
+    0x22, 0xFA, 0x9B, 0x73, 0x01, 0xAB, 0x19, 0x01, 0x00, 0x22, 0xE9, 0x9C,
+    0x52, 0x83, 0xCA, 0x09, 0x11, 0x00, 0x31, 0xD8, 0x9D, 0x41, 0x13, 0xCB,
+    0x0A, 0x12, 0x80, 0x32, 0xD0, 0xAE, 0x41, 0x13, 0xCA, 0x0A, 0x11, 0x00,
+    0x21, 0xB1, 0xCF, 0x30, 0x15, 0xB9, 0x8A, 0x11, 0x81, 0x31, 0xB1, 0xCF,
+    0x38, 0x25, 0xA9, 0x9B, 0x11, 0x01, 0x30, 0xA2, 0xCF, 0x39, 0x25, 0xA8,
+    0x9C, 0x11, 0x00, 0x20, 0x92, 0xDD, 0x29, 0x34, 0xA0, 0x9D, 0x10, 0x01,
+    0x28, 0x82, 0xDC, 0x1A, 0x35, 0xA1, 0xAC, 0x28, 0x01, 0x28, 0x02, 0xFB,
+    0x0B, 0x54, 0x91, 0xBB, 0x10, 0x01, 0x10, 0x12, 0xFB, 0x0C, 0x43, 0x82,
+    0xBC, 0x18, 0x11, 0x18, 0x22, 0xFA, 0x9B, 0x73, 0x81, 0xAA, 0x19, 0x01,
+    0x00, 0x22, 0xF8, 0x9B, 0x62, 0x02, 0xBB, 0x09, 0x12, 0x08, 0x32, 0xE8,
+    0x9D, 0x41, 0x04, 0xBA, 0x0A, 0x12, 0x08, 0x32, 0xD0, 0xAE, 0x41, 0x13,
+    0xCA, 0x0A, 0x11, 0x00, 0x21, 0xB1, 0xCF, 0x30, 0x15, 0xB9, 0x8A, 0x11,
+    0x81, 0x31, 0xB1, 0xCF, 0x38, 0x25, 0xA9, 0x9B, 0x11, 0x01, 0x30, 0xA2,
+    0xCF, 0x39, 0x25, 0xA8, 0x9C, 0x11, 0x00, 0x20, 0x92, 0xDD, 0x29, 0x34,
+    0xA0, 0x9D, 0x10, 0x01, 0x28, 0x82, 0xDC, 0x1A, 0x35, 0xA1, 0xAC, 0x28,
+    0x01, 0x28, 0x02, 0xFB, 0x0B, 0x54, 0x91, 0xBB, 0x10, 0x01, 0x10, 0x12,
+    0xFB, 0x0C, 0x43, 0x82, 0xAC, 0x19, 0x11, 0x18, 0x22, 0xFA, 0x9B, 0x63,
+    0x82, 0xCA, 0x08, 0x11, 0x08, 0x22, 0xD9, 0x9D, 0x52, 0x02, 0xBB, 0x09,
+    0x12, 0x18, 0x22, 0xE8, 0x9D, 0x41, 0x04, 0xBA, 0x0A, 0x12, 0x08, 0x22,
+    0xD1, 0xAE, 0x41, 0x13, 0xCA, 0x0A, 0x11, 0x00, 0x21, 0xB1, 0xCF, 0x30,
+    0x15, 0xB9, 0x8A, 0x11, 0x81, 0x31, 0xB1, 0xCF, 0x38, 0x25, 0xA9, 0x9B,
+    0x11, 0x01, 0x30, 0xA2, 0xCF, 0x39, 0x25, 0xA8, 0x9C, 0x11, 0x00, 0x20,
+    0x92, 0xDD, 0x29, 0x34, 0xA0, 0xAC, 0x20, 0x00, 0x20, 0x02, 0xED, 0x09,
+    0x44, 0x90, 0xAB, 0x10, 0x01, 0x28, 0x02, 0xFB, 0x0B, 0x54, 0x91, 0xBB,
+    0x10, 0x01, 0x10, 0x12, 0xFB, 0x0C, 0x43, 0x82, 0xBC, 0x18, 0x11, 0x18,
+    0x22, 0xFA, 0x9B, 0x63, 0x82, 0xCA, 0x08, 0x11, 0x18, 0x21, 0xD9, 0x9D,
+    0x52, 0x02, 0xBB, 0x09, 0x12, 0x18, 0x22, 0xE8, 0x9D, 0x41, 0x04, 0xBA,
+    0x0A, 0x12, 0x08, 0x22, 0xD1, 0xAE, 0x41, 0x13, 0xCA, 0x0A, 0x11, 0x00,
+    0x21, 0xB1, 0xCF, 0x30, 0x15, 0xB9, 0x8A, 0x11, 0x81, 0x31, 0xA1, 0xCF,
+    0x38, 0x34, 0xB9, 0x9C, 0x21, 0x00, 0x20, 0x92, 0xCF, 0x28, 0x34, 0xB8,
+    0x9C, 0x11, 0x81, 0x11, 0x93, 0xCE, 0x19, 0x35, 0xA0, 0x9C, 0x10, 0x81,
+    0x20, 0x02, 0xDD, 0x1A, 0x44, 0x90, 0xAB, 0x28, 0x01, 0x10, 0x03, 0xFC,
+    0x0A, 0x34, 0xA2, 0xAC, 0x18, 0x02, 0x18, 0x13, 0xFB, 0x0C, 0x43, 0x92,
+    0xCB, 0x18, 0x01, 0x10, 0x22, 0xFA, 0x8C, 0x52, 0x82, 0xAB, 0x09, 0x02,
+    0x00, 0x23, 0xF9, 0x9C, 0x52, 0x02, 0xBB, 0x09, 0x12, 0x18, 0x22, 0xE8,
+    0x9D, 0x41, 0x04, 0xBA, 0x0A, 0x12, 0x08, 0x32, 0xD0, 0xAE, 0x41, 0x13,
+    0xCA, 0x0A, 0x11, 0x00, 0x21, 0xB1, 0xCF, 0x30, 0x15, 0xB9, 0x8A, 0x11,
+    0x81, 0x31, 0xA1, 0xCF, 0x38, 0x15, 0xB8, 0x8B, 0x11, 0x81, 0x31, 0xA2,
+    0xCF, 0x39, 0x25, 0xA8, 0x9C, 0x11, 0x00, 0x20, 0x82, 0xCE, 0x29, 0x34,
+    0xA0, 0x9D, 0x10, 0x01, 0x28, 0x82, 0xDC, 0x1A,
+};
+
+const adpcm_clip_t chime = {chime_data, 1000};
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+uint32_t pwm_ring[2][HALF]; // duty values, ping-pong halves
+voice_t voice[NVOICES];
+int32_t master_vol = 256;   // Q8
+volatile uint32_t halves;   // halves refilled so far
+volatile uint32_t busy_ticks, total_ticks;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void audio_init(void);
+void audio_dma_half(uint32_t n);
+void audio_fill(uint32_t *out, uint32_t n);
+void voice_play(voice_t *v, const adpcm_clip_t *clip, int32_t vol);
+void voice_render(voice_t *v, int32_t *acc, uint32_t n);
+int32_t adpcm_decode(voice_t *v, uint32_t code);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    uint32_t last = 0;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz system clock, enable clocks
+     ***********************************************************/
+    PLL_Init80MHz();
+    SYSCTL_RCGCGPIO_R |= 0x03; // Ports A, B
+    SYSCTL_RCGCPWM_R |= 0x01;
+    SYSCTL_RCGCTIMER_R |= 0x03;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x03) != 0x03)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 80 MHz (IBRD 43, FBRD 26)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: PWM DAC, sample clock, uDMA ring
+     ***********************************************************/
+    audio_init();
+    UART0_SendString("\r\nAudio ready: 1/2 play, +/- volume, s stop\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – keys and CPU load once a second
+     ***********************************************************/
+    while (1)
+    {
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            c = (char)UART0_DR_R;
+            __disable_irq(); // voice_t is shared with the refill
+            if (c == '1' || c == '2')
+                voice_play(&voice[c - '1'], &chime, c == '1' ? 256 : 160);
+            else if (c == '+' && master_vol < 512)
+                master_vol += 32;
+            else if (c == '-' && master_vol > 0)
+                master_vol -= 32;
+            else if (c == 's')
+                voice[0].clip = voice[1].clip = 0;
+            __enable_irq();
+        }
+
+        if (halves - last >= SAMPLE_HZ / HALF)
+        {
+            last = halves;
+            UART0_SendString("cpu ");
+            UART0_SendNumber(busy_ticks * 1000 / (total_ticks ? total_ticks : 1));
+            UART0_SendString(" permille, volume ");
+            UART0_SendNumber((uint32_t)master_vol);
+            UART0_SendString("/256\r\n");
+            busy_ticks = total_ticks = 0;
+        }
+    }
+}
+
+/***********************************************************
+ * audio_init() – M0PWM0 on PB6, Timer0A at SAMPLE_HZ feeding
+ * uDMA channel 18 into PWM0_0_CMPA_R
+ ***********************************************************/
+void audio_init(void)
+{
+    SYSCTL_RCC_R &= ~0x00100000; // USEPWMDIV = 0: PWM clock = 80 MHz
+
+    GPIO_PORTB_AFSEL_R |= 0x40;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0x0F000000) | 0x04000000;
+    GPIO_PORTB_DEN_R |= 0x40;
+
+    PWM0_0_CTL_R = 0x00;      // Down count, CMPA updated at reload
+    PWM0_0_LOAD_R = PWM_LOAD;
+    PWM0_0_CMPA_R = PWM_LOAD / 2; // Silence = 50 % duty
+    PWM0_0_GENA_R = 0x8C;     // High at LOAD, low at CMPA down
+    PWM0_0_CTL_R = 0x01;
+    PWM0_ENABLE_R |= 0x01;
+
+    // Ring starts silent
+    audio_fill(pwm_ring[0], HALF);
+    audio_fill(pwm_ring[1], HALF);
+
+    // Timer1: free-running, CPU load reference
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;
+    TIMER1_TAMR_R = 0x02;
+    TIMER1_TAILR_R = 0xFFFFFFFF;
+    TIMER1_CTL_R = 0x01;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02;                      // Periodic
+    TIMER0_TAILR_R = SYSCLK / SAMPLE_HZ - 1;
+    TIMER0_IMR_R = 0x00;                       // 8 kHz timeouts: uDMA requests only
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0x00000F00; // CH18 → Timer0A
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_TIMER0A;
+    audio_dma_half(0);
+    audio_dma_half(1);
+    UDMA_ALTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_ENASET_R = 1 << DMA_CH_TIMER0A;
+
+    NVIC_EN0_R = 1 << 19; // IRQ 19 = Timer0A
+    __enable_irq();
+
+    TIMER0_CTL_R = 0x01;
+}
+
+/***********************************************************
+ * audio_dma_half() – half n: even → primary, odd → alternate
+ ***********************************************************/
+void audio_dma_half(uint32_t n)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_TIMER0A + ((n & 1) ? 32 : 0)];
+
+    e->src_end = (uint32_t)(uintptr_t)&pwm_ring[n & 1][HALF - 1];
+    e->dst_end = (uint32_t)(uintptr_t)&PWM0_0_CMPA_R;
+    e->ctl = (3u << 30)           // DSTINC: none
+             | (2u << 28)         // DSTSIZE: word
+             | (2u << 26)         // SRCINC: word
+             | (2u << 24)         // SRCSIZE: word
+             | (0u << 14)         // ARBSIZE: 1 per timeout
+             | ((HALF - 1) << 4)  // XFERSIZE
+             | 0x3;               // Ping-pong
+}
+
+/***********************************************************
+ * TIMER0A_Handler() – one half played: refill it, re-arm
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    uint32_t n = halves;
+    uint32_t t0 = TIMER1_TAR_R;
+    static uint32_t last_t0;
+
+    TIMER0_ICR_R = 0x01; // TATOCINT
+    UDMA_CHIS_R = 1 << DMA_CH_TIMER0A;
+
+    audio_fill(pwm_ring[n & 1], HALF);
+    audio_dma_half(n + 2); // Same half, same structure
+
+    busy_ticks += t0 - TIMER1_TAR_R; // down counter
+    total_ticks += last_t0 - t0;
+    last_t0 = t0;
+    halves = n + 1;
+}
+
+/***********************************************************
+ * audio_fill() – mix all voices into n duty values
+ ***********************************************************/
+void audio_fill(uint32_t *out, uint32_t n)
+{
+    int32_t acc[HALF];
+    int32_t s;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+        acc[i] = 0;
+    for (i = 0; i < NVOICES; i++)
+        voice_render(&voice[i], acc, n);
+
+    for (i = 0; i < n; i++)
+    {
+        s = (acc[i] >> 8) * master_vol >> 8;
+        s = s > 32767 ? 32767 : s;
+        s = s < -32768 ? -32768 : s;
+        out[i] = (uint32_t)(PWM_LOAD - ((s + 32768) >> 7)); // high time = duty
+    }
+}
+
+/*** voice_play() – start clip on voice v from its first sample ***/
+void voice_play(voice_t *v, const adpcm_clip_t *clip, int32_t vol)
+{
+    v->pos = 0;
+    v->pred = 0;
+    v->index = 0;
+    v->vol = vol;
+    v->clip = clip;
+}
+
+/***********************************************************
+ * voice_render() – decode up to n samples of v, add them
+ * to acc[] scaled by the voice volume (acc is Q8)
+ ***********************************************************/
+void voice_render(voice_t *v, int32_t *acc, uint32_t n)
+{
+    const uint8_t *d;
+    uint32_t pos, end, i;
+
+    if (!v->clip)
+        return;
+
+    d = v->clip->data;
+    pos = v->pos;
+    end = v->clip->samples - pos < n ? v->clip->samples : pos + n;
+
+    for (i = 0; pos < end; i++, pos++)
+        acc[i] += adpcm_decode(v, (d[pos >> 1] >> ((pos & 1) << 2)) & 0x0F) * v->vol;
+
+    v->pos = pos;
+    if (pos >= v->clip->samples)
+        v->clip = 0;
+}
+
+/***********************************************************
+ * adpcm_decode() – one IMA-ADPCM nibble → 16-bit sample
+ ***********************************************************/
+int32_t adpcm_decode(voice_t *v, uint32_t code)
+{
+    int32_t step = ima_step[v->index];
+    int32_t diff = step >> 3;
+
+    if (code & 4)
+        diff += step;
+    if (code & 2)
+        diff += step >> 1;
+    if (code & 1)
+        diff += step >> 2;
+
+    v->pred += (code & 8) ? -diff : diff;
+    v->pred = v->pred > 32767 ? 32767 : v->pred;
+    v->pred = v->pred < -32768 ? -32768 : v->pred;
+
+    v->index += ima_index_adj[code & 7];
+    v->index = v->index < 0 ? 0 : v->index;
+    v->index = v->index > 88 ? 88 : v->index;
+
+    return v->pred;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
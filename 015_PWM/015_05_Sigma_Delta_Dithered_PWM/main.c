@@ -0,0 +1,345 @@
+/***************************************************************
+ * PROJECT NAME : Sigma-Delta Dithered PWM (24-bit LED Dimming)
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - PWM1 generator 3, M1PWM7 on PF3 (green LED), 78 kHz
+ *      - Timer0A (one uDMA request per PWM period)
+ *      - uDMA channel 18 (Timer0A → PWM1_3_CMPB, ping-pong)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 015_01 dims the LED with LOAD = 0xFFFF: 16 bits, but only a
+ * 1.2 kHz carrier at 80 MHz, and the lowest steps (1/65536,
+ * 2/65536, ...) are still visible as jumps. Here the carrier
+ * is fast (LOAD = 1023, 78 kHz) and the duty value carries 14
+ * extra fractional bits:
+ *
+ *      duty = q x 2^14 + f      (24 bits, 0 - 1022 x 2^14)
+ *
+ * A first-order sigma-delta modulator turns it into one
+ * integer compare value per PWM period:
+ *
+ *      acc = (acc mod 2^14) + duty
+ *      CMPB = acc >> 14
+ *
+ * CMPB alternates between q and q + 1 so that the average over
+ * 2^14 periods is exactly duty / 2^14; the error is pushed to
+ * high frequencies where neither the LED nor the eye follows.
+ * 1 LSB of the 24-bit value is a single one-tick pulse every
+ * 16384 periods.
+ *
+ * Per-period update without CPU:
+ *   Timer0A runs with the same 80 MHz clock and the same 1024
+ *   cycle period as the PWM counter, and requests uDMA channel
+ *   18 on every timeout; each request copies one value of the
+ *   ring into PWM1_3_CMPB_R. CMPB is latched when the counter
+ *   reaches zero, and the timer is started right after the
+ *   generator, so each write lands early in a period and takes
+ *   effect at its end: one value per period, no skips.
+ *   The ring is two halves of HALF values (ping-pong). The uDMA
+ *   done interrupt (Timer0A vector) fills the played half with
+ *   the next HALF modulator outputs: 256 values every 3.3 ms,
+ *   about 1 % of the CPU. On the TM4C123 this done signal is
+ *   not gated by GPTMIMR, which stays 0.
+ *
+ * Output polarity: GENB drives the pin low at zero and high at
+ * CMPB (down count), so the LED is on for exactly CMPB ticks of
+ * the period and fully off for CMPB = 0. CMPB must stay below
+ * LOAD: at CMPB = LOAD the compare coincides with the load
+ * event, the load action wins and the pin stays low for the
+ * whole period. DUTY_MAX is therefore (LOAD - 1) x 2^14, and
+ * the modulator never outputs more than LOAD - 1.
+ *
+ * Commands (UART0, single keys):
+ *      f         start / stop an exponential fade (about 14 s
+ *                from 1 LSB to full scale and back)
+ *      n         dither on / off (off = fraction dropped, the
+ *                plain 10-bit steps for comparison)
+ *      0 - 9     fixed level, 2^(2 x key) LSB (0 = 1 LSB)
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define SYSCLK 80000000
+#define PWM_LOAD 1023             // 80 MHz / 1024 = 78.1 kHz
+#define SD_FRAC 14                // fractional duty bits
+#define SD_MASK ((1u << SD_FRAC) - 1)
+#define DUTY_MAX ((uint32_t)(PWM_LOAD - 1) << SD_FRAC) // CMPB < LOAD
+#define HALF 256                  // values per ping-pong half
+#define DMA_CH_TIMER0A 18
+
+/***********************************************************
+ * uDMA CONTROL TABLE (primary 0-31, alternate 32-63)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[64] __attribute__((aligned(1024)));
+
+uint32_t cmp_ring[2][HALF];    // CMPB values, ping-pong halves
+volatile uint32_t duty;        // 24-bit target
+volatile uint32_t dither_mask = SD_MASK; // 0 = dithering off
+uint32_t sd_acc;               // modulator error, < 2^14
+volatile uint32_t halves;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void dither_init(void);
+void dither_dma_half(uint32_t n);
+void sd_fill(uint32_t *out, uint32_t n, uint32_t d);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    uint32_t last = 0, d;
+    int fade = 0, up = 1;
+    char c;
+
+    /***********************************************************
+     * STEP 1: 80 MHz system clock, enable clocks
+     ***********************************************************/
+    PLL_Init80MHz();
+    SYSCTL_RCGCGPIO_R |= 0x21; // Ports A, F
+    SYSCTL_RCGCPWM_R |= 0x02;
+    SYSCTL_RCGCTIMER_R |= 0x01;
+    SYSCTL_RCGCDMA_R |= 0x01;
+    SYSCTL_RCGCUART_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x21) != 0x21)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 80 MHz (IBRD 43, FBRD 26)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: PWM, per-period uDMA update
+     ***********************************************************/
+    duty = 1;
+    dither_init();
+    UART0_SendString("\r\nDithered PWM: f fade, n dither, 0-9 level\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – keys, fade step every 4 halves
+     ***********************************************************/
+    while (1)
+    {
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            c = (char)UART0_DR_R;
+            if (c == 'f')
+            {
+                fade = !fade;
+            }
+            else if (c == 'n')
+            {
+                dither_mask = dither_mask ? 0 : SD_MASK;
+                UART0_SendString(dither_mask ? "dither on\r\n" : "dither off\r\n");
+            }
+            else if (c >= '0' && c <= '9')
+            {
+                fade = 0;
+                duty = 1u << (2 * (c - '0'));
+                UART0_SendString("duty ");
+                UART0_SendNumber(duty);
+                UART0_SendString("\r\n");
+            }
+        }
+
+        // Exponential steps (1/64) look even to the eye
+        if (fade && halves - last >= 4)
+        {
+            last = halves;
+            d = duty;
+            if (up)
+            {
+                d += (d >> 6) + 1;
+                if (d >= DUTY_MAX)
+                {
+                    d = DUTY_MAX;
+                    up = 0;
+                }
+            }
+            else
+            {
+                d -= (d >> 6) + 1;
+                if (d <= 1 || d > DUTY_MAX)
+                {
+                    d = 1;
+                    up = 1;
+                }
+            }
+            duty = d;
+        }
+    }
+}
+
+/***********************************************************
+ * dither_init() – M1PWM7 on PF3, Timer0A at the PWM period
+ * feeding uDMA channel 18 into PWM1_3_CMPB_R
+ ***********************************************************/
+void dither_init(void)
+{
+    SYSCTL_RCC_R &= ~0x00100000; // USEPWMDIV = 0: PWM clock = 80 MHz
+
+    GPIO_PORTF_AFSEL_R |= 0x08;
+    GPIO_PORTF_PCTL_R = (GPIO_PORTF_PCTL_R & ~0x0000F000) | 0x00005000;
+    GPIO_PORTF_DEN_R |= 0x08;
+
+    sd_fill(cmp_ring[0], HALF, duty);
+    sd_fill(cmp_ring[1], HALF, duty);
+
+    PWM1_3_CTL_R = 0x00;    // Down count, CMPB latched at zero
+    PWM1_3_LOAD_R = PWM_LOAD;
+    PWM1_3_CMPB_R = cmp_ring[0][0];
+    PWM1_3_GENB_R = 0xC02;  // Low at zero, high at CMPB down
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02;   // Periodic
+    TIMER0_TAILR_R = PWM_LOAD; // 1024 cycles, same as the PWM
+    TIMER0_IMR_R = 0x00;    // No IRQ per PWM period
+
+    UDMA_CFG_R = 0x01;
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP2_R &= ~0x00000F00; // CH18 → Timer0A
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_TIMER0A;
+    dither_dma_half(0);
+    dither_dma_half(1);
+    UDMA_ALTCLR_R = 1 << DMA_CH_TIMER0A;
+    UDMA_ENASET_R = 1 << DMA_CH_TIMER0A;
+
+    NVIC_EN0_R = 1 << 19; // IRQ 19 = Timer0A
+
+    // Start both counters back to back: fixed phase from here on
+    __disable_irq();
+    PWM1_3_CTL_R = 0x01;
+    TIMER0_CTL_R = 0x01;
+    __enable_irq();
+    PWM1_ENABLE_R |= 0x80;
+}
+
+/***********************************************************
+ * dither_dma_half() – half n: even → primary, odd → alternate
+ ***********************************************************/
+void dither_dma_half(uint32_t n)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_TIMER0A + ((n & 1) ? 32 : 0)];
+
+    e->src_end = (uint32_t)(uintptr_t)&cmp_ring[n & 1][HALF - 1];
+    e->dst_end = (uint32_t)(uintptr_t)&PWM1_3_CMPB_R;
+    e->ctl = (3u << 30)           // DSTINC: none
+             | (2u << 28)         // DSTSIZE: word
+             | (2u << 26)         // SRCINC: word
+             | (2u << 24)         // SRCSIZE: word
+             | (0u << 14)         // ARBSIZE: 1 per timeout
+             | ((HALF - 1) << 4)  // XFERSIZE
+             | 0x3;               // Ping-pong
+}
+
+/***********************************************************
+ * TIMER0A_Handler() – one half played: refill it, re-arm
+ ***********************************************************/
+void TIMER0A_Handler(void)
+{
+    uint32_t n = halves;
+
+    TIMER0_ICR_R = 0x01; // TATOCINT
+    UDMA_CHIS_R = 1 << DMA_CH_TIMER0A;
+
+    sd_fill(cmp_ring[n & 1], HALF, duty & (dither_mask | ~SD_MASK));
+    dither_dma_half(n + 2); // Same half, same structure
+    halves = n + 1;
+}
+
+/***********************************************************
+ * sd_fill() – n first-order sigma-delta outputs for duty d
+ * One add, one shift and one mask per value, no branches.
+ ***********************************************************/
+void sd_fill(uint32_t *out, uint32_t n, uint32_t d)
+{
+    uint32_t acc = sd_acc;
+
+    while (n--)
+    {
+        acc += d;
+        *out++ = acc >> SD_FRAC;
+        acc &= SD_MASK;
+    }
+    sd_acc = acc;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal, 400 MHz PLL / 5
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,513 @@
+/***************************************************************
+ * PROJECT NAME : Runtime Performance Counters with UART Shell
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - ADC0 Sample Sequencer 0 (SS0), Timer0A trigger, PD3 (AIN4)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *      - 74HC595 shift register (PF2 = SDATA, PF3 = SCLK, PE5 = STK)
+ *      - PWM Module 1, Generator 2, Output B (M1PWM5) on PF1
+ *      - SysTick (1 ms time base)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * This program adds always-on operational counters to the
+ * drivers used in the other demos:
+ *
+ *   ADC   → samples produced, samples dropped (ring full or
+ *           hardware FIFO overflow)
+ *   UART  → bytes received, bytes sent, receive overruns
+ *   595   → bytes shifted by shift_out1() (the ADC level as an
+ *           8-step bar, sent only when it changes)
+ *   PWM   → compare register updates
+ *   CPU   → interrupt counts and idle loop passes
+ *
+ * Every counter is one word in the perf_counter[] table and is
+ * incremented with PERF_INC(). Cortex-M4 has no instruction that
+ * increments memory directly, so this is the shortest possible
+ * sequence: load / add / store on a fixed address (no function
+ * call, no locking). Each counter has exactly ONE writer (either
+ * one ISR or the main loop), so no increment can be lost and no
+ * interrupt masking is needed. The shell never writes the live
+ * counters: "perf reset" only moves a baseline that is
+ * subtracted when printing.
+ *
+ * A small line shell runs on UART0 (use any terminal program):
+ *
+ *   perf          → print all counters (since the last reset)
+ *   perf diff     → print change since the last "perf diff"
+ *   perf reset    → restart all counters from zero (baseline)
+ *   perf tlm on   → stream binary telemetry frames every second
+ *   perf tlm off  → stop telemetry
+ *
+ * Telemetry frame (little endian, values since the last reset):
+ *   0xA5 0x5A | count (1 byte) | count x uint32 counters | checksum
+ *   checksum = 8-bit sum of all bytes after the two sync bytes
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+/***********************************************************
+ * PERFORMANCE COUNTER REGISTRY
+ ***********************************************************/
+enum
+{
+    PERF_ISR_ADC0SS0,   // ADC0 SS0 interrupts
+    PERF_ISR_UART0,     // UART0 interrupts
+    PERF_ISR_SYSTICK,   // SysTick interrupts (ms)
+    PERF_ADC_SAMPLES,   // ADC samples stored in ring
+    PERF_ADC_DROPPED,   // ADC samples lost
+    PERF_UART_RX_BYTES, // bytes read from UART0 DR
+    PERF_UART_TX_BYTES, // bytes written to UART0 DR
+    PERF_UART_OVERRUNS, // receive overruns (hardware or ring)
+    PERF_LCD_BYTES,     // bytes shifted into the 74HC595
+    PERF_PWM_UPDATES,   // writes to PWM compare register
+    PERF_IDLE_LOOPS,    // main loop passes with nothing to do
+    PERF_COUNT
+};
+
+static const char *const perf_name[PERF_COUNT] = {
+    "isr_adc0ss0",
+    "isr_uart0",
+    "isr_systick",
+    "adc_samples",
+    "adc_dropped",
+    "uart_rx_bytes",
+    "uart_tx_bytes",
+    "uart_overruns",
+    "lcd_bytes",
+    "pwm_updates",
+    "idle_loops",
+};
+
+volatile uint32_t perf_counter[PERF_COUNT]; // live counters
+uint32_t perf_baseline[PERF_COUNT];         // values at last "perf reset"
+uint32_t perf_snapshot[PERF_COUNT];         // values at last "perf diff"
+
+#define PERF_INC(id) (perf_counter[(id)]++)
+
+/***********************************************************
+ * RING BUFFERS (power-of-two size, one producer / one consumer)
+ ***********************************************************/
+#define ADC_RING_SIZE 64
+#define UART_RING_SIZE 64
+
+volatile uint16_t adc_ring[ADC_RING_SIZE];
+volatile uint32_t adc_head, adc_tail;
+
+volatile uint8_t uart_rx_ring[UART_RING_SIZE];
+volatile uint32_t uart_rx_head, uart_rx_tail;
+
+volatile uint32_t ms_ticks; // incremented by SysTick
+
+// Function prototypes
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+int UART0_Read(char *c);
+void shift_out1(unsigned char byte);
+void shell_execute(char *line);
+void perf_print(int diff);
+void perf_telemetry(void);
+int str_equal(const char *a, const char *b);
+
+unsigned char tlm_enabled = 0;
+
+int main(void)
+{
+    char line[32];
+    unsigned int len = 0;
+    char c;
+    uint32_t last_tlm = 0;
+    uint16_t sample;
+    unsigned char bar, shown = 0;
+
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO A (UART0), D (ADC), E (STK), F (595 + PWM)
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x39;  // Port A, D, E, F
+    SYSCTL_RCGCUART_R |= 0x01;  // UART0
+    SYSCTL_RCGCADC_R |= 0x01;   // ADC0
+    SYSCTL_RCGCTIMER_R |= 0x01; // Timer0
+    SYSCTL_RCGCPWM_R |= 0x02;   // PWM Module 1
+    while ((SYSCTL_PRGPIO_R & 0x39) != 0x39)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1, FIFO on, RX interrupts
+     * IBRD = 16 MHz / (16 x 115200) = 8.680 → 8
+     * FBRD = 0.680 x 64 + 0.5 = 44
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70; // 8-bit, FIFO enable
+    UART0_CC_R = 0x00;
+    UART0_IFLS_R = 0x10;  // RX interrupt at 1/2 full
+    UART0_IM_R = 0x450;   // OEIM (bit 10), RTIM (bit 6), RXIM (bit 4)
+    UART0_CTL_R = 0x301;  // UARTEN, TXE, RXE
+
+    /***********************************************************
+     * STEP 3: 74HC595 pins – PF2 = SDATA, PF3 = SCLK, PE5 = STK
+     ***********************************************************/
+    GPIO_PORTE_DIR_R |= 0x20;
+    GPIO_PORTE_DEN_R |= 0x20;
+    GPIO_PORTF_DIR_R |= 0x0C;
+    GPIO_PORTF_DEN_R |= 0x0C;
+    shift_out1(shown); // Bar off
+
+    /***********************************************************
+     * STEP 4: PWM1 Generator 2 Output B (M1PWM5) on PF1
+     ***********************************************************/
+    GPIO_PORTF_AFSEL_R |= 0x02;
+    GPIO_PORTF_PCTL_R = (GPIO_PORTF_PCTL_R & ~0x000000F0) | 0x00000050;
+    GPIO_PORTF_DEN_R |= 0x02;
+
+    PWM1_2_CTL_R = 0x00;
+    PWM1_2_GENB_R = 0x0000080C; // HIGH on load, LOW on CMPB down
+    PWM1_2_LOAD_R = 4095;       // Same range as the ADC
+    PWM1_2_CMPB_R = 0;
+    PWM1_2_CTL_R = 0x01;
+    PWM1_ENABLE_R |= 0x20; // M1PWM5
+
+    /***********************************************************
+     * STEP 5: ADC0 SS0 on AIN4 (PD3), triggered by Timer0A at 1 kHz
+     ***********************************************************/
+    GPIO_PORTD_AFSEL_R |= 0x08;
+    GPIO_PORTD_DEN_R &= ~0x08;
+    GPIO_PORTD_AMSEL_R |= 0x08;
+
+    ADC0_ACTSS_R &= ~0x01;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0x000F) | 0x0005; // SS0 trigger = timer
+    ADC0_SSMUX0_R = 0x04;
+    ADC0_SSCTL0_R = 0x06; // END0, IE0
+    ADC0_IM_R |= 0x01;
+    ADC0_ACTSS_R |= 0x01;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;         // 32-bit
+    TIMER0_TAMR_R = 0x02;        // Periodic
+    TIMER0_TAILR_R = 16000 - 1;  // 1 kHz at 16 MHz
+    TIMER0_CTL_R = 0x21;         // TAOTE (ADC trigger) + TAEN
+
+    /***********************************************************
+     * STEP 6: SysTick 1 ms, then enable interrupts
+     * IRQ 5 = UART0, IRQ 14 = ADC0 SS0
+     ***********************************************************/
+    NVIC_ST_CTRL_R = 0;
+    NVIC_ST_RELOAD_R = 16000 - 1;
+    NVIC_ST_CURRENT_R = 0;
+    NVIC_ST_CTRL_R = 0x07; // core clock, interrupt, enable
+
+    NVIC_EN0_R = (1 << 5) | (1 << 14);
+    __enable_irq();
+
+    UART0_SendString("\r\nperf shell ready\r\n> ");
+
+    /***********************************************************
+     * STEP 7: Main loop – consume samples, run shell, telemetry
+     ***********************************************************/
+    while (1)
+    {
+        int busy = 0;
+
+        // ADC ring → PWM duty (same closed loop as 015_02)
+        while (adc_tail != adc_head)
+        {
+            sample = adc_ring[adc_tail & (ADC_RING_SIZE - 1)];
+            adc_tail++;
+            PWM1_2_CMPB_R = sample;
+            PERF_INC(PERF_PWM_UPDATES);
+            busy = 1;
+        }
+
+        // Newest sample as a bar on the 595: 0 - 8 outputs high
+        if (busy)
+        {
+            bar = (unsigned char)((1u << (sample * 9 / 4096)) - 1);
+            if (bar != shown)
+            {
+                shift_out1(bar);
+                shown = bar;
+            }
+        }
+
+        // Shell input
+        while (UART0_Read(&c))
+        {
+            busy = 1;
+            if (c == '\r' || c == '\n')
+            {
+                line[len] = 0;
+                UART0_SendString("\r\n");
+                if (len)
+                    shell_execute(line);
+                len = 0;
+                UART0_SendString("> ");
+            }
+            else if (len < sizeof(line) - 1)
+            {
+                line[len++] = c;
+                UART0Tx(c); // Echo
+            }
+        }
+
+        // Telemetry once per second
+        if (tlm_enabled && (ms_ticks - last_tlm) >= 1000)
+        {
+            last_tlm = ms_ticks;
+            perf_telemetry();
+            busy = 1;
+        }
+
+        if (!busy)
+            PERF_INC(PERF_IDLE_LOOPS);
+    }
+}
+
+/***********************************************************
+ * SysTick_Handler() – 1 ms time base
+ ***********************************************************/
+void SysTick_Handler(void)
+{
+    PERF_INC(PERF_ISR_SYSTICK);
+    ms_ticks++;
+}
+
+/***********************************************************
+ * ADC0SS0_Handler() – one sample per Timer0A trigger
+ ***********************************************************/
+void ADC0SS0_Handler(void)
+{
+    uint32_t value;
+
+    PERF_INC(PERF_ISR_ADC0SS0);
+
+    value = ADC0_SSFIFO0_R; // Hot path: FIFO read
+    ADC0_ISC_R = 0x01;
+
+    if (ADC0_OSTAT_R & 0x01) // Hardware FIFO overflowed
+    {
+        ADC0_OSTAT_R = 0x01;
+        PERF_INC(PERF_ADC_DROPPED);
+    }
+
+    if ((adc_head - adc_tail) < ADC_RING_SIZE)
+    {
+        adc_ring[adc_head & (ADC_RING_SIZE - 1)] = (uint16_t)value;
+        adc_head++;
+        PERF_INC(PERF_ADC_SAMPLES);
+    }
+    else
+    {
+        PERF_INC(PERF_ADC_DROPPED);
+    }
+}
+
+/***********************************************************
+ * UART0_Handler() – drain RX FIFO into the ring buffer
+ * DR bit 11 (OE) flags a hardware overrun.
+ ***********************************************************/
+void UART0_Handler(void)
+{
+    uint32_t data;
+
+    PERF_INC(PERF_ISR_UART0);
+
+    while ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+    {
+        data = UART0_DR_R; // Hot path: DR access
+        PERF_INC(PERF_UART_RX_BYTES);
+
+        if (data & 0x800)
+            PERF_INC(PERF_UART_OVERRUNS);
+
+        if ((uart_rx_head - uart_rx_tail) < UART_RING_SIZE)
+        {
+            uart_rx_ring[uart_rx_head & (UART_RING_SIZE - 1)] = (uint8_t)data;
+            uart_rx_head++;
+        }
+        else
+        {
+            PERF_INC(PERF_UART_OVERRUNS); // Software ring full
+        }
+    }
+
+    UART0_ICR_R = 0x450;
+}
+
+/***********************************************************
+ * UART0_Read() – non-blocking read from the RX ring
+ * Returns 1 and stores the byte in *c, or 0 if empty.
+ ***********************************************************/
+int UART0_Read(char *c)
+{
+    if (uart_rx_tail == uart_rx_head)
+        return 0;
+
+    *c = (char)uart_rx_ring[uart_rx_tail & (UART_RING_SIZE - 1)];
+    uart_rx_tail++;
+    return 1;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c; // Hot path: DR access
+    PERF_INC(PERF_UART_TX_BYTES);
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
+
+/***********************************************************
+ * shift_out1() – 8 bits LSB first into the 74HC595
+ * Same wiring and timing as 004_LCD, plus a byte counter.
+ ***********************************************************/
+void shift_out1(unsigned char byte)
+{
+    unsigned char j;
+
+    GPIO_PORTE_DATA_R &= ~0x20; // STK = 0
+
+    for (j = 0; j < 8; j++)
+    {
+        GPIO_PORTF_DATA_R &= ~0x0C; // SCLK = 0, SDATA = 0
+
+        if (byte & (1 << j))
+            GPIO_PORTF_DATA_R |= 0x04; // SDATA = 1
+
+        GPIO_PORTF_DATA_R |= 0x08; // SCLK = 1
+    }
+
+    GPIO_PORTE_DATA_R |= 0x20; // STK = 1
+    PERF_INC(PERF_LCD_BYTES);
+}
+
+/***********************************************************
+ * perf_print() – print counters, or deltas when diff = 1
+ * Each value is copied once so the printout is consistent
+ * even while ISRs keep counting.
+ ***********************************************************/
+void perf_print(int diff)
+{
+    uint32_t now[PERF_COUNT];
+    int i;
+
+    for (i = 0; i < PERF_COUNT; i++)
+        now[i] = perf_counter[i];
+
+    for (i = 0; i < PERF_COUNT; i++)
+    {
+        UART0_SendString(perf_name[i]);
+        UART0_SendString(diff ? " +" : " ");
+        UART0_SendNumber(now[i] - (diff ? perf_snapshot[i] : perf_baseline[i]));
+        UART0_SendString("\r\n");
+    }
+
+    if (diff)
+    {
+        for (i = 0; i < PERF_COUNT; i++)
+            perf_snapshot[i] = now[i];
+    }
+}
+
+/***********************************************************
+ * perf_telemetry() – one binary frame on UART0
+ ***********************************************************/
+void perf_telemetry(void)
+{
+    uint8_t sum = PERF_COUNT;
+    uint32_t value;
+    int i, b;
+
+    UART0Tx((char)0xA5);
+    UART0Tx((char)0x5A);
+    UART0Tx(PERF_COUNT);
+
+    for (i = 0; i < PERF_COUNT; i++)
+    {
+        value = perf_counter[i] - perf_baseline[i];
+        for (b = 0; b < 4; b++)
+        {
+            UART0Tx((char)(value & 0xFF));
+            sum += value & 0xFF;
+            value >>= 8;
+        }
+    }
+
+    UART0Tx((char)sum);
+}
+
+/***********************************************************
+ * shell_execute() – decode one command line
+ ***********************************************************/
+void shell_execute(char *line)
+{
+    int i;
+
+    if (str_equal(line, "perf"))
+        perf_print(0);
+    else if (str_equal(line, "perf diff"))
+        perf_print(1);
+    else if (str_equal(line, "perf reset"))
+    {
+        // Read-only on the live counters: their ISR stays the only writer
+        for (i = 0; i < PERF_COUNT; i++)
+        {
+            perf_baseline[i] = perf_counter[i];
+            perf_snapshot[i] = perf_baseline[i];
+        }
+    }
+    else if (str_equal(line, "perf tlm on"))
+        tlm_enabled = 1;
+    else if (str_equal(line, "perf tlm off"))
+        tlm_enabled = 0;
+    else
+        UART0_SendString("usage: perf [diff|reset|tlm on|tlm off]\r\n");
+}
+
+int str_equal(const char *a, const char *b)
+{
+    while (*a && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
@@ -0,0 +1,1456 @@
+/***************************************************************
+ * PROJECT NAME : QEMU Target Integration Tests
+ * TARGET       : QEMU mps2-an386 (Cortex-M4F), no board needed
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * This program runs the REAL demo driver code as ARM Thumb-2
+ * instructions inside QEMU:
+ *
+ *   - The demo sources are compiled unchanged (see wrap_*.c,
+ *     wrap_019.cpp for the C++ HAL)
+ *     against shim/tm4c123gh6pm.h, which turns every peripheral
+ *     register into a RAM variable.
+ *   - Each test preloads the shim registers, calls a driver
+ *     function and checks what the driver wrote.
+ *   - Results are printed with ARM semihosting, and the exit
+ *     status of QEMU is 0 only if every test passed.
+ *   - Benchmarks time each driver hot path with SysTick. QEMU is
+ *     started with "-icount shift=0" (one instruction = one ns of
+ *     virtual time), and a calibration loop of known length turns
+ *     SysTick ticks into executed instructions.
+ *
+ * Build and run (needs arm-none-eabi-gcc and qemu-system-arm):
+ *      make -C 017_QEMU_Target_Tests test
+ *
+ * The same tests also build for the host ("make host-test");
+ * semihosting then maps to stdio and the benchmarks are skipped.
+ *
+ * NOTE :
+ * Instruction counts are exact for QEMU but are NOT cycle counts
+ * on the TM4C123GH6PM (flash wait states and pipeline refills are
+ * not modelled). Use them to compare two versions of a driver.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#ifdef __arm__
+/* Real SysTick registers of the emulated core (not shimmed) */
+#define SYST_CSR (*((volatile uint32_t *)0xE000E010))
+#define SYST_RVR (*((volatile uint32_t *)0xE000E014))
+#define SYST_CVR (*((volatile uint32_t *)0xE000E018))
+#else
+#include <stdio.h>
+#include <stdlib.h>
+static volatile uint32_t SYST_CSR, SYST_RVR, SYST_CVR; // never counts
+#endif
+
+/* Drivers under test (from the wrapped demo sources) */
+void seg7_shift_out1(unsigned char data_byte);
+void lcd_shift_out1(unsigned char byte);
+void LCD_command(unsigned char command);
+void LCD_putc(unsigned char ascii);
+extern unsigned char PP2;
+unsigned char key_scan(unsigned int volatile rec_val);
+void bus_add_slave(uint8_t addr);
+int bus_next_slave(void);
+void bus_reply(int i, uint32_t len);
+void bus_timeout(int i);
+uint32_t bus_utilization_pm(void);
+extern uint32_t bus_slave_count, bus_cursor;
+extern uint8_t bus_backoff;
+extern volatile uint32_t bus_rounds, bus_chars_total, bus_chars_payload;
+void mdrop_test_reset(uint32_t n);
+void mdrop_test_start(void);
+void mdrop_test_rx(uint32_t c);
+void mdrop_test_reply(uint8_t dst, uint8_t src, const char *s, int bad_crc);
+void mdrop_test_timeout(void);
+int mdrop_test_current(void);
+uint32_t mdrop_test_slave(int i, int field);
+uint32_t nmea_replay(const char *log, uint32_t n, uint32_t ring_size,
+                     uint32_t chunk, int32_t out[6], uint32_t *bad);
+void foc_closed_loop(uint16_t theta, int32_t id_ref, int32_t iq_ref,
+                     uint32_t steps, int32_t out[2]);
+int32_t foc_park_max_error(int32_t amp);
+void foc_svpwm_at(int32_t mag, uint16_t theta, uint16_t cmp[3]);
+void foc_bench_init(void);
+void foc_bench_step(void);
+int32_t audio_roundtrip_error(int32_t amp);
+uint32_t audio_mix_range(int32_t vol, uint32_t *lo, uint32_t *hi);
+uint32_t audio_silence(void);
+void audio_bench_half(void);
+uint32_t sd_period_sum(uint32_t d, uint32_t *pulses);
+void sd_bench_half(void);
+uint32_t pg_run(const uint8_t *const *data, const uint16_t *len,
+                const uint8_t *mask, uint32_t n, int loop,
+                uint8_t *out, uint32_t ticks);
+uint32_t pg_test_rate(uint32_t hz);
+void la_start(void);
+void la_feed(const uint8_t *s);
+uint32_t la_drain(uint8_t *out, uint32_t max);
+void la_finish(void);
+uint32_t la_decode(const uint8_t *b, uint32_t n, uint8_t *out,
+                   uint32_t max, uint32_t *lost);
+void la_trace_595(uint8_t *s, uint32_t n, uint32_t hold);
+void la_bench_half(void);
+extern uint32_t la_lost;
+uint32_t fc_count_error(uint32_t hz, uint32_t gate_us, uint32_t gates,
+                        uint32_t start, uint32_t *res, uint32_t *err,
+                        uint32_t *readings);
+uint64_t fc_period_mhz(uint32_t periods, uint64_t ticks, uint32_t *res,
+                       uint32_t *err);
+uint64_t fc_test_gate(uint32_t back, uint32_t *res);
+uint32_t fc_test_listed(void);
+void fc_gate(uint32_t us);
+uint32_t fc_edges(uint32_t t0, uint32_t dt, uint32_t *n);
+uint8_t fc_range(uint8_t method, uint64_t mhz);
+void fc_bench_block(void);
+void bus_test_reset(void);
+int bus_test_adc(uint16_t ladder, uint16_t pot);
+int bus_test_button(uint8_t pressed);
+int bus_test_line(const char *s);
+int bus_test_queued(const char *s);
+int bus_test_topic(const char *name);
+uint32_t bus_test_free(int topic);
+uint32_t bus_test_perf(int topic, int field);
+uint16_t bus_test_latest_pot(void);
+int bus_test_order(void);
+int bus_dispatch(void);
+void bus_bench_round(void);
+int vtor_shift_same(unsigned char byte, uint32_t *pins);
+uint32_t vtor_control(uint16_t adc);
+int vtor_relocate_check(uint32_t irq, void (*handler)(void));
+void bench_isr_ram(void);
+uint32_t hal_test_write(uint32_t old);
+uint32_t hal_test_modify(uint32_t old);
+uint32_t hal_test_field(uint32_t ris);
+uint32_t hal_test_leds(uint32_t value);
+void hal_test_delay(int ms);
+uint32_t ws_test_lut(uint8_t v);
+int ws_test_encode(uint8_t r, uint8_t g, uint8_t b, uint8_t out[9]);
+void ws_init(void);
+void iox_init(void);
+void iox_test_reset(void);
+uint32_t iox_test_refresh(uint16_t pins, uint32_t n);
+uint32_t iox_test_event(void);
+extern volatile uint16_t iox_out, iox_in, iox_pressed;
+extern volatile uint32_t input_dropped;
+void kp_test_reset(void);
+uint32_t kp_test_run(uint16_t held, uint32_t ms);
+uint32_t kp_test_event(void);
+int kp_test_idle(void);
+extern volatile uint32_t wakeups, scans;
+uint32_t suart_test_tx(const char *s, uint32_t n, uint32_t *t,
+                       uint8_t *level, uint32_t max, uint32_t *matches);
+uint32_t suart_test_rx(uint16_t frame, uint32_t bit, uint32_t latency,
+                       char *c, uint32_t *errors);
+void ab_test_reset(void);
+uint32_t ab_test_edge(uint32_t t, int level);
+uint32_t ab_test_detected(void);
+uint32_t ab_test_sync(uint32_t baud, uint32_t t0);
+uint32_t ab_test_divisor(void);
+void dmarx_test_reset(void);
+void dmarx_test_frame(const uint8_t *s, uint32_t n, int late);
+int dmarx_test_get(uint8_t *out, uint32_t *spans);
+int dmarx_test_release(void);
+uint32_t dmarx_test_count(int field);
+uint16_t mb_crc16(const uint8_t *p, uint32_t n);
+uint32_t mb_test_request(const uint8_t *req, uint32_t len, uint8_t *rsp,
+                         uint32_t cmpb, uint32_t pf1);
+uint32_t mb_test_outputs(void);
+void scope_test_trigger(uint8_t type, uint16_t level, uint16_t hyst,
+                        uint16_t lo, uint16_t hi);
+int scope_scan(const uint16_t *s, uint32_t first, uint32_t count, uint32_t index);
+uint8_t scope_test_pack(const uint16_t *v, uint32_t n, uint32_t pos, uint8_t *out);
+void adapt_test_reset(uint32_t t);
+uint32_t adapt_test_now(uint32_t t);
+uint32_t adapt_test_sample(uint32_t t, uint16_t x);
+void cal_defaults(void);
+void cal_apply(const uint16_t *in, int32_t *out, uint32_t frames);
+int cal_test_points(uint32_t ch, int32_t code0, int32_t uv0, int32_t code1,
+                    int32_t uv1, int32_t *gain, int32_t *bias);
+
+/* Semihosting */
+void semihost_write(const char *s);
+void semihost_exit(int status);
+void print_number(uint32_t n);
+
+static int failures;
+
+#define CHECK(cond)                                 \
+    do                                              \
+    {                                               \
+        if (!(cond))                                \
+        {                                           \
+            semihost_write("  FAIL line ");         \
+            print_number(__LINE__);                 \
+            semihost_write(": " #cond "\n");        \
+            failures++;                             \
+        }                                           \
+    } while (0)
+
+/***********************************************************
+ * TESTS
+ ***********************************************************/
+
+/* 74HC595 (003): latch ends HIGH, last clock edge HIGH and the
+ * data pin carries bit 7 because the byte goes out LSB first. */
+void test_seg7_shift_out(void)
+{
+    tm4c_shim_reset();
+    seg7_shift_out1(0x80);
+    CHECK(GPIO_PORTC_DATA_R == 0x10);
+    CHECK(GPIO_PORTF_DATA_R == 0x0C);
+
+    tm4c_shim_reset();
+    seg7_shift_out1(0x7F);
+    CHECK(GPIO_PORTC_DATA_R == 0x10);
+    CHECK(GPIO_PORTF_DATA_R == 0x08);
+}
+
+/* LCD (004): EN is dropped after each nibble and RS follows
+ * command / data mode. Bit 7 = RS, bit 5 = EN. */
+void test_lcd_nibbles(void)
+{
+    tm4c_shim_reset();
+    PP2 = 0;
+    LCD_command(0x28);
+    CHECK((PP2 & 0x20) == 0); // EN low
+    CHECK((PP2 & 0x80) == 0); // RS = command
+    CHECK(GPIO_PORTE_DATA_R == 0x20);
+
+    // 0x28 remapped = 0x41 → low nibble 0x1
+    CHECK((PP2 & 0x0F) == 0x01);
+
+    LCD_putc('A'); // 0x41 remapped = 0x28 → low nibble 0x8
+    CHECK((PP2 & 0x80) == 0x80); // RS = data
+    CHECK((PP2 & 0x20) == 0);
+    CHECK((PP2 & 0x0F) == 0x08);
+}
+
+/* Analog keypad (011_02): every key window and the noise value */
+void test_key_scan(void)
+{
+    static const struct
+    {
+        unsigned int adc;
+        unsigned char key;
+    } cases[] = {
+        {0xB70, '0'}, {0xB20, '1'}, {0xAE0, '2'}, {0xA90, '3'},
+        {0xA70, '4'}, {0xA00, '5'}, {0x970, '6'}, {0x920, '7'},
+        {0x8B0, '8'}, {0x800, '9'}, {0x730, 'A'}, {0x650, 'B'},
+        {0x5A0, 'C'}, {0x410, 'D'}, {0x200, 'E'}, {0x000, 'F'},
+        {0xFFF, 'G'},
+    };
+    unsigned int i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        CHECK(key_scan(cases[i].adc) == cases[i].key);
+}
+
+/* RS-485 scheduler (014_07): 32 simulated slaves, the ones at
+ * addresses 5, 13, 21 and 29 are offline and the others answer
+ * with 0 - 32 payload bytes. Bus utilization must beat plain
+ * round robin once offline slaves back off. Then reply frames go
+ * through UART1_Handler: good, bad CRC, wrong source, another
+ * node's frame, a timeout, and a frame before the first poll. */
+void test_bus_utilization(void)
+{
+    uint32_t pass, n, seed, util[2];
+    int i;
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        bus_slave_count = bus_cursor = bus_rounds = 0;
+        bus_chars_total = bus_chars_payload = 0;
+        bus_backoff = (uint8_t)pass;
+        for (n = 1; n <= 32; n++)
+            bus_add_slave((uint8_t)n);
+
+        seed = 1;
+        for (n = 0; n < 20000; n++)
+        {
+            i = bus_next_slave();
+            if ((i + 1) % 8 == 5)
+            {
+                bus_timeout(i);
+            }
+            else
+            {
+                seed = seed * 1103515245 + 12345;
+                bus_reply(i, (seed >> 16) % 33);
+            }
+        }
+        util[pass] = bus_utilization_pm();
+
+        semihost_write(pass ? "  backoff: " : "  round robin: ");
+        print_number(util[pass]);
+        semihost_write(" permille, ");
+        print_number(bus_rounds);
+        semihost_write(" rounds\n");
+    }
+
+    CHECK(util[1] > util[0]);
+    CHECK(util[1] >= 650);
+
+    // A reply before the first poll: no token out, nothing counted
+    mdrop_test_reset(4);
+    mdrop_test_reply(0, 1, "7", 0);
+    CHECK(mdrop_test_current() == -1);
+    CHECK(mdrop_test_slave(0, 0) == 0 && bus_chars_total == 0);
+
+    // Good reply: counted, token passed on at once
+    mdrop_test_start();
+    CHECK(mdrop_test_current() == 0);
+    mdrop_test_reply(0, 1, "42", 0);
+    CHECK(mdrop_test_slave(0, 1) == 1 && mdrop_test_slave(0, 3) == 2);
+    CHECK(mdrop_test_current() == 1);
+
+    // Bad CRC, then a wrong source: both count as timeouts
+    mdrop_test_reply(0, 2, "42", 1);
+    CHECK(mdrop_test_slave(1, 2) == 1 && mdrop_test_slave(1, 1) == 0);
+    CHECK(mdrop_test_current() == 2);
+    mdrop_test_reply(0, 9, "42", 0);
+    CHECK(mdrop_test_slave(2, 2) == 1 && mdrop_test_current() == 3);
+
+    // Another node's frame never reaches the master's CPU
+    mdrop_test_reply(5, 4, "42", 0);
+    CHECK(mdrop_test_slave(3, 0) == 0 && mdrop_test_current() == 3);
+
+    // Silence: the timer takes the token back, the round wraps
+    mdrop_test_timeout();
+    CHECK(mdrop_test_slave(3, 2) == 1 && mdrop_test_current() == 0);
+    CHECK(bus_rounds == 1);
+
+    // 2 payload chars of 9 + 3 x 6 character times
+    CHECK(bus_chars_total == 27 && bus_utilization_pm() == 74);
+}
+
+/* Recorded GPS log: 7 valid sentences, line noise, one sentence
+ * with a wrong checksum and one cut off by a new '$'. */
+static const char nmea_log[] =
+    "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"
+    "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+    "\x00\xFF noise $GPGSA,A,3,04,05,,09,12\r\n"
+    "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n"
+    "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n"
+    "$GPGSV,2,2,08,18,12,050,30,*00\r\n"
+    "$GNGGA,235959.50,3352.12874,S,15112.49210,E,2,12,0.72,39.8,M,22.1,M,1.0,0000*45\r\n"
+    "$GNRMC,235959.50,A,33$GNRMC,235959.50,A,3352.12874,S,15112.49210,E,0.15,271.3,181026,,,D*64\r\n"
+    "$GPVTG,084.4,T,,M,022.4,N,041.5,K,A*01\r\n";
+
+#define NMEA_LOG_LEN (sizeof(nmea_log) - 1)
+
+/* NMEA parser (014_08): same sentences and values whether the
+ * log is parsed in place or trickles through a wrapping ring. */
+void test_nmea_parser(void)
+{
+    static const uint32_t rings[] = {0, 128, 256};
+    int32_t out[6];
+    uint32_t r, good, bad;
+
+    for (r = 0; r < sizeof(rings) / sizeof(rings[0]); r++)
+    {
+        good = nmea_replay(nmea_log, NMEA_LOG_LEN, rings[r], 7, out, &bad);
+        CHECK(good == 7);
+        CHECK(bad == 3);
+        CHECK(out[0] == 86399500);   // 23:59:59.50
+        CHECK(out[1] == -338688123); // 33 52.12874' S
+        CHECK(out[2] == 1512082017); // 151 12.49210' E
+        CHECK(out[3] == 12);
+        CHECK(out[4] == 398);        // 39.8 m
+        CHECK(out[5] == 15);         // 0.15 kn
+    }
+
+    // First GGA + RMC only: stop after the second line
+    for (r = 0, good = 0; good < 2; r++)
+        good += (nmea_log[r] == '\n');
+    nmea_replay(nmea_log, r, 0, 0, out, &bad);
+    CHECK(out[0] == 45319000);
+    CHECK(out[1] == 481173000);
+    CHECK(out[2] == 115166667);
+    CHECK(out[4] == 5454);
+    CHECK(out[5] == 2240);
+}
+
+/* FOC core (015_03): Clarke/Park of balanced currents gives a
+ * constant id, SVPWM stays centered inside one PWM period, and
+ * the current loops settle on a locked-rotor R-L model. */
+void test_foc(void)
+{
+    int32_t out[2], lo, hi;
+    uint16_t cmp[3];
+    uint32_t k;
+    int span_ok = 1, center_ok = 1;
+
+    CHECK(foc_park_max_error(16000) < 160); // 1 %
+
+    foc_svpwm_at(0, 0, cmp);
+    CHECK(cmp[0] == 1000 && cmp[1] == 1000 && cmp[2] == 1000);
+
+    for (k = 0; k < 256; k++)
+    {
+        foc_svpwm_at(32767, (uint16_t)(k << 8), cmp);
+        lo = cmp[0] < cmp[1] ? cmp[0] : cmp[1];
+        lo = cmp[2] < lo ? cmp[2] : lo;
+        hi = cmp[0] > cmp[1] ? cmp[0] : cmp[1];
+        hi = cmp[2] > hi ? cmp[2] : hi;
+        span_ok &= (hi - lo <= 2000);
+        center_ok &= (hi + lo >= 1997 && hi + lo <= 2003);
+    }
+    CHECK(span_ok);
+    CHECK(center_ok);
+    foc_svpwm_at(32767, 0x1555, cmp); // 30°: touches the hexagon edge
+    CHECK(cmp[0] - cmp[2] >= 1990);
+
+    foc_closed_loop(0x2345, 0, 8000, 2000, out);
+    CHECK(out[0] > -80 && out[0] < 80);
+    CHECK(out[1] > 8000 - 80 && out[1] < 8000 + 80);
+    foc_closed_loop(0xC000, -4000, -6000, 2000, out);
+    CHECK(out[0] > -4000 - 80 && out[0] < -4000 + 80);
+    CHECK(out[1] > -6000 - 80 && out[1] < -6000 + 80);
+}
+
+/* PWM audio (015_04): the decoder reproduces what a reference
+ * IMA encoder was given, silence is 50 % duty, and two loud
+ * voices saturate inside the PWM range instead of wrapping. */
+void test_audio(void)
+{
+    uint32_t lo, hi;
+
+    CHECK(audio_roundtrip_error(16000) < 16000 / 8);
+    CHECK(audio_roundtrip_error(2000) < 2000 / 8);
+    CHECK(audio_silence() == 255);
+
+    CHECK(audio_mix_range(256, &lo, &hi) == 8); // 1000 samples
+    CHECK(lo > 0 && hi < 511);
+    audio_mix_range(512, &lo, &hi);
+    CHECK(lo == 0 && hi == 511);
+    CHECK(audio_silence() == 255);
+}
+
+/* Dithered PWM (015_05): over 2^14 periods the on-time equals
+ * the 24-bit duty exactly, using only the two nearest compare
+ * values; 1 LSB is one single-tick pulse, and full scale
+ * (DUTY_MAX) never reaches CMPB = LOAD (1023). */
+void test_sigma_delta(void)
+{
+    static const uint32_t duties[] = {0, 1, 2, 16383, 16384, 0x123456,
+                                      (1022u << 14) - 1, 1022u << 14};
+    uint32_t k, pulses;
+
+    for (k = 0; k < sizeof(duties) / sizeof(duties[0]); k++)
+        CHECK(sd_period_sum(duties[k], &pulses) == duties[k]);
+
+    sd_period_sum(1, &pulses);
+    CHECK(pulses == 1);
+    sd_period_sum(16384 + 8192, &pulses); // 1.5 ticks: on every period
+    CHECK(pulses == 16384);
+}
+
+/* Pattern generator (007_02): the scatter-gather task list
+ * plays the segments through their pin masks in order, loops
+ * back to the first one, or stops after the last one. Task
+ * copies hold the pins for one tick (worst case). Segments of
+ * 0 or over 1024 bytes are refused; the rate clamps at 5 MHz. */
+void test_pattern_generator(void)
+{
+    static const uint8_t step[4] = {0x01, 0x02, 0x04, 0x08};
+    static const uint8_t pulse[2] = {0x10, 0x00};
+    static const uint8_t *const data[2] = {step, pulse};
+    static const uint16_t len[2] = {4, 2};
+    static const uint8_t mask[2] = {0x0F, 0x30};
+    // copy (holds), step x 4, copy, pulse x 2, copy, reload
+    static const uint8_t period[10] = {0x08, 0x01, 0x02, 0x04, 0x08,
+                                       0x08, 0x18, 0x08, 0x08, 0x08};
+    static uint8_t long_seg[1025];
+    const uint8_t *big_data[1];
+    uint16_t seg_len[2];
+    uint8_t out[40];
+    uint32_t i, n;
+    int ok = 1;
+
+    n = pg_run(data, len, mask, 2, 1, out, 40);
+    CHECK(n == 40);
+    CHECK(out[0] == 0x00); // nothing driven yet
+    for (i = 1; i < n; i++)
+        ok &= (out[i] == period[i % 10]);
+    CHECK(ok);
+
+    n = pg_run(data, len, mask, 2, 0, out, 40);
+    CHECK(n == 8);
+    CHECK(out[n - 1] == 0x08);
+
+    // XFERSIZE holds 1 - 1024 items
+    seg_len[0] = 4;
+    seg_len[1] = 0;
+    CHECK(pg_run(data, seg_len, mask, 2, 0, out, 40) == 0);
+    big_data[0] = long_seg;
+    seg_len[0] = 1025;
+    CHECK(pg_run(big_data, seg_len, mask, 1, 0, out, 40) == 0);
+    seg_len[0] = 1024;
+    CHECK(pg_run(big_data, seg_len, mask, 1, 0, out, 40) == 40);
+
+    CHECK(pg_test_rate(1000) == 79999);
+    CHECK(pg_test_rate(5000000) == 15);
+    CHECK(pg_test_rate(6000000) == 15);
+    CHECK(pg_test_rate(80000000) == 15);
+    CHECK(pg_test_rate(0xFFFFFFFF) == 15); // not the slowest rate
+    CHECK(pg_test_rate(0) == 0xFFFFFFFF);
+    pg_test_rate(1000);
+}
+
+/* Logic analyzer (007_03): the run-length stream decodes back
+ * to the samples for a 74HC595 bus, an idle run across halves
+ * and every-sample changes; a full ring drops whole halves and
+ * reports them as lost. */
+void test_logic_analyzer(void)
+{
+    static uint8_t bus[1024], flat[1024], worst[1024];
+    static uint8_t stream[16384], out[8 * 1024];
+    static const uint8_t *const fed[8] = {bus, flat, worst, worst,
+                                          worst, worst, worst, bus};
+    uint32_t i, k, n = 0, got, lost;
+    int ok = 1;
+
+    la_trace_595(bus, 1024, 4);
+    for (i = 0; i < 1024; i++)
+    {
+        flat[i] = bus[1023];
+        worst[i] = (uint8_t)(i & 1 ? 0x55 : 0xAA);
+    }
+
+    la_start();
+    n += la_drain(stream + n, sizeof(stream) - n);
+    CHECK(n == 10); // header
+    la_feed(bus);
+    n += la_drain(stream + n, sizeof(stream) - n);
+    la_feed(flat); // the bus is idle: the run goes on, no bytes
+    got = la_drain(stream + n, sizeof(stream) - n);
+    CHECK(got == 0);
+    la_feed(worst);
+    n += la_drain(stream + n, sizeof(stream) - n);
+
+    // No UART progress: three worst-case halves fit, the fourth is lost
+    for (i = 0; i < 4; i++)
+        la_feed(worst);
+    n += la_drain(stream + n, sizeof(stream) - n);
+    la_feed(bus);
+    la_finish();
+    n += la_drain(stream + n, sizeof(stream) - n);
+    CHECK(la_lost == 1024);
+
+    got = la_decode(stream, n, out, sizeof(out), &lost);
+    CHECK(got == 8 * 1024);
+    CHECK(lost == 1024);
+    for (k = 0; k < 8; k++)
+        for (i = 0; i < 1024; i++)
+            ok &= (out[k * 1024 + i] == (k == 6 ? 0xEE : fed[k][i]));
+    CHECK(ok);
+}
+
+#define FC_TEST_LOG 256 // FC_LOG
+
+/* Frequency counter (007_04): the count method is exact to one
+ * edge across a counter wrap and with 1 s gates, each gate's
+ * own reading is kept but none from before a gate change, the
+ * period method resolves millihertz,
+ * and the range switch has 40 / 50 kHz hysteresis. */
+void test_frequency_counter(void)
+{
+    uint32_t res, err, readings, n;
+    uint64_t gate;
+
+    // 12.345678 MHz, 512 gates of 1 ms, counter wraps on the way
+    CHECK(fc_count_error(12345678, 1000, 512, 0xFFFF0000, &res, &err,
+                         &readings) <= res);
+    CHECK(res == 1953);                 // one edge in 0.512 s
+    CHECK(err == res + 617283);         // + 50 ppm of f
+    CHECK(readings == 512);
+
+    // Per-gate readings: 12345 or 12346 edges in each 1 ms gate
+    gate = fc_test_gate(0, &res);
+    CHECK((gate == 12345000000ull || gate == 12346000000ull) && res == 1000000);
+    CHECK(fc_test_gate(FC_TEST_LOG - 64 - 1, &res) != 0);
+    CHECK(fc_test_gate(FC_TEST_LOG - 64, &res) == 0); // refilled next block
+
+    // 1 s gates: 64 gates = 5.12e9 ticks, 1.28e9 edges at 20 MHz
+    CHECK(fc_count_error(20000000, 1000000, 64, 0, &res, &err, &readings) <= res);
+    CHECK(res == 15 && err == res + 1000000);
+    CHECK(fc_count_error(20000000, 100, 64, 0, &res, &err, &readings) <= res);
+    CHECK(readings == 64);
+
+    // "d" lists the last 16 gates, none right after a gate change
+    CHECK(fc_test_listed() == 16);
+    fc_gate(1000000);
+    CHECK(fc_test_listed() == 0);
+
+    // 1 kHz, 1000 periods timed over 1 s: one tick = 1 mHz
+    CHECK(fc_period_mhz(1000, 80000000, &res, &err) == 1000000);
+    CHECK(res == 1 && err == 51);
+    CHECK(fc_period_mhz(3200000, 5120000000ull, &res, &err) == 50000000); // 64 s
+    CHECK(fc_edges(0xFFFFF000, 80000, &n) == 80000); // time base wraps
+    CHECK(n == 1);
+
+    // 0 = count, 1 = period; 40 kHz / 50 kHz hysteresis
+    CHECK(fc_range(0, 39999999) == 1);
+    CHECK(fc_range(0, 45000000) == 0);
+    CHECK(fc_range(1, 45000000) == 1);
+    CHECK(fc_range(1, 50000001) == 0);
+}
+
+/* 024: pool drops, delivery order, latency, shell lines in reused blocks */
+void test_event_bus(void)
+{
+    int adc = bus_test_topic("adc"), key = bus_test_topic("key");
+    int button = bus_test_topic("button"), shell = bus_test_topic("shell");
+    uint32_t i;
+
+    bus_test_reset();
+    CHECK(bus_test_order());
+
+    // Pool of 8: the ninth publish is a counted drop
+    for (i = 0; i < 8; i++)
+        CHECK(bus_test_adc(0xFFF, (uint16_t)i));
+    CHECK(!bus_test_adc(0xFFF, 8));
+    CHECK(bus_test_perf(adc, 0) == 8 && bus_test_perf(adc, 1) == 1);
+    CHECK(bus_test_free(adc) == 0);
+
+    // All delivered; trend_on_adc keeps only the newest block
+    while (bus_dispatch())
+        ;
+    CHECK(bus_test_perf(adc, 2) == 8);
+    CHECK(bus_test_free(adc) == 7);
+    CHECK(bus_test_latest_pot() == 7);
+
+    // A key on the ladder becomes one "key" message (a subscriber publishes)
+    CHECK(bus_test_adc(0xB70, 0));
+    CHECK(bus_test_adc(0xB70, 0)); // still held: no second press
+    while (bus_dispatch())
+        ;
+    CHECK(bus_test_perf(key, 0) == 1 && bus_test_perf(key, 2) == 1);
+    CHECK(bus_test_free(key) == 4);
+
+    // Topic priority: "adc" before an older "button"
+    CHECK(bus_test_button(1));
+    CHECK(bus_test_adc(0xFFF, 0));
+    CHECK(bus_dispatch());
+    CHECK(bus_test_perf(adc, 2) == 11 && bus_test_perf(button, 2) == 0);
+    CHECK(bus_dispatch());
+    CHECK(bus_test_perf(button, 2) == 1);
+
+    // Latency: published at 1600, dispatched at 0 = 100 us at 16 MHz
+    bus_test_reset();
+    TIMER1_TAR_R = 1600;
+    CHECK(bus_test_line("perf bus"));
+    TIMER1_TAR_R = 0;
+    CHECK(bus_dispatch());
+    CHECK(bus_test_perf(shell, 3) == 100 && bus_test_perf(shell, 4) == 100);
+    CHECK(bus_test_free(shell) == 2);
+
+    // Pool of 2: the third line reuses the first block, which must
+    // not keep the length of its old line
+    bus_test_reset();
+    CHECK(bus_test_line("perf"));
+    CHECK(bus_test_queued("perf"));
+    CHECK(bus_dispatch());
+    CHECK(bus_test_line("adc"));
+    CHECK(bus_test_queued("adc"));
+    CHECK(bus_dispatch());
+    CHECK(bus_test_line("perf"));
+    CHECK(bus_test_queued("perf"));
+    CHECK(bus_dispatch());
+    CHECK(bus_test_queued(0));
+    CHECK(bus_test_free(shell) == 2);
+}
+
+/* RAM functions (018): the SRAM copies leave the same pins and
+ * duty as the flash ones, and the relocated vector table is a
+ * 1 KB aligned copy with only the installed handler changed. */
+void test_ram_functions(void)
+{
+    uint32_t pins;
+
+    CHECK(vtor_shift_same(0xA5, &pins));
+    CHECK(pins == 0x200C); // latch high, clock high, data = bit 7
+    CHECK(vtor_shift_same(0x7F, &pins));
+    CHECK(pins == 0x2008);
+
+    CHECK(vtor_control(0) == 0);
+    CHECK(vtor_control(2048) == 1536);
+    CHECK(vtor_control(0xFFFF) == 0x0EFF); // clamped to LOAD
+
+    CHECK(vtor_relocate_check(0, bench_isr_ram));
+    CHECK(vtor_relocate_check(138, bench_isr_ram)); // last vector
+}
+
+/* C++ HAL (019): write<> replaces the register, modify<> keeps
+ * the other bits, fields read shifted down, and a pin group is
+ * one store to its masked data address. */
+void test_cpp_hal(void)
+{
+    tm4c_shim_reset();
+    CHECK(hal_test_write(0xFFFFFFFF) == 0x02);
+    CHECK(hal_test_modify(0x100) == 0x101);
+    CHECK(hal_test_field(0x02) == 0);
+    CHECK(hal_test_field(0x03) == 1);
+
+    CHECK(hal_test_leds(0x08) == (0x08 << 16 | 0x08));
+    CHECK(GPIO_PORTF_DIR_R == 0x0E && GPIO_PORTF_DEN_R == 0x0E);
+    CHECK(GPIO_PORTF_DATA_R == 0); // no read-modify-write
+
+    // Same Timer1 setup as 007_01
+    tm4c_shim_reset();
+    hal_test_delay(3);
+    CHECK(SYSCTL_RCGCTIMER_R == 0x02);
+    CHECK(TIMER1_CFG_R == 4 && TIMER1_TAMR_R == 2);
+    CHECK(TIMER1_TAILR_R == 15999);
+    CHECK(TIMER1_CTL_R == 1 && TIMER1_ICR_R == 1);
+}
+
+/* WS2812 (020): every LUT entry is the byte MSB first as 3-bit
+ * symbols (0 = 100, 1 = 110), pixels go out G, R, B, and the
+ * SSI runs in SPH = 1 mode so bytes follow without a gap. */
+void test_ws2812(void)
+{
+    static const uint8_t grb[9] = {0x92, 0x49, 0x24,  // G = 0x00
+                                   0xDB, 0x6D, 0xB6,  // R = 0xFF
+                                   0xD2, 0x49, 0x26}; // B = 0x81
+    uint8_t out[9];
+    uint32_t v, n, w;
+    int ok = 1;
+
+    for (v = 0; v < 256; v++)
+    {
+        w = ws_test_lut((uint8_t)v);
+        ok &= (w >> 24) == 0;
+        for (n = 0; n < 8; n++)
+            ok &= ((w >> (3 * n)) & 7) == ((v >> n) & 1 ? 6u : 4u);
+    }
+    CHECK(ok);
+
+    CHECK(ws_test_encode(0xFF, 0x00, 0x81, out));
+    for (n = 0, ok = 1; n < 9; n++)
+        ok &= out[n] == grb[n];
+    CHECK(ok);
+
+    tm4c_shim_reset();
+    ws_init();
+    CHECK(SSI0_CR0_R == ((2 << 8) | 0x80 | 0x07)); // SCR 2, SPH 1, 8-bit
+    CHECK(SSI0_CPSR_R == 2 && SSI0_CR1_R == 0x02);
+}
+
+/* I/O expander (022): one 16-bit mode 0 frame per refresh,
+ * inputs inverted from the RX frame, the latch pulse left HIGH,
+ * and a button must hold 4 debounce samples (5 refreshes each)
+ * before it becomes one press event. */
+void test_io_expander(void)
+{
+    uint32_t n, ev;
+
+    tm4c_shim_reset();
+    iox_init();
+    CHECK(SSI2_CR0_R == 0x0F && SSI2_CPSR_R == 4);
+    CHECK(SSI2_DR_R == 0);          // first frame clears the outputs
+    CHECK(GPIO_PORTB_DATA_R & 0x20); // latch idle HIGH
+
+    iox_test_reset();
+    iox_out = 0x8001;
+    iox_test_refresh(0xFFF7, 1); // input 3 pulled LOW
+    CHECK(iox_in == 0x0008);
+    CHECK(SSI2_DR_R == 0x8001); // next frame = outputs
+    CHECK(GPIO_PORTB_DATA_R & 0x20);
+    SSI2_SR_R = 0; // no frame received: last snapshot kept
+    SSI2_DR_R = 0;
+    iox_test_refresh(0xFFFF, 0);
+    CHECK(iox_in == 0x0008);
+
+    // A 15 ms glitch is three samples, one short: no event
+    iox_test_reset();
+    CHECK(iox_test_refresh(0xFFFF, 10) == 0);
+    CHECK(iox_test_refresh(0xFFF7, 15) == 0);
+    CHECK(iox_test_refresh(0xFFFF, 40) == 0);
+    CHECK(iox_pressed == 0);
+
+    // Held: exactly one press after 16 - 20 ms, then one release
+    for (n = 0; iox_test_refresh(0xFFF7, 1) == 0 && n < 40; n++)
+        ;
+    CHECK(n >= 15 && n < 20);
+    ev = iox_test_event();
+    CHECK((ev & 0xFFFF) == (3 | 1 << 8)); // 1 = press
+    CHECK(iox_test_refresh(0xFFF7, 100) == 0);
+    CHECK(iox_test_refresh(0xFFFF, 25) == 1);
+    ev = iox_test_event();
+    CHECK((ev & 0xFFFF) == 3);
+    CHECK(iox_test_event() == 0xFFFFFFFF);
+
+    // 16 buttons at once: all debounced together, lowest code first
+    CHECK(iox_test_refresh(0x0000, 25) == 16);
+    CHECK(iox_pressed == 0xFFFF);
+    CHECK((iox_test_event() & 0xFFFF) == (0 | 1 << 8));
+    CHECK(iox_test_refresh(0xFFFF, 25) == 1); // queue full: 15 dropped
+    CHECK(input_dropped == 15);
+}
+
+/* Matrix keypad (023): a column edge wakes the scanner, a key
+ * is row * 4 + column and must hold 4 scans (16 ms) to become an
+ * event, held keys are independent (n-key rollover), and the
+ * scanner sleeps again after IDLE_SCANS empty scans. */
+void test_keypad(void)
+{
+    uint32_t n;
+
+    kp_test_reset();
+    CHECK(kp_test_idle());
+    CHECK(kp_test_run(0, 10) == 0 && wakeups == 0);
+
+    // '8' = row 2, column 1 = code 9; a one-scan bounce is ignored
+    CHECK(kp_test_run(1u << 9, 4) == 0);
+    CHECK(wakeups == 1 && !kp_test_idle());
+    CHECK(kp_test_run(0, 4) == 0);
+    for (n = 1; kp_test_run(1u << 9, 1) == 0 && n < 40; n++)
+        ;
+    CHECK(n > 12 && n <= 20);
+    CHECK(kp_test_event() == ('8' | 1 << 8 | 1 << 16)); // press, keypad
+
+    // Corners held together: both reported, '1' (code 0) first
+    CHECK(kp_test_run(1u << 9 | 1u << 0 | 1u << 15, 20) == 2);
+    CHECK(kp_test_event() == ('1' | 1 << 8 | 1 << 16));
+    CHECK(kp_test_event() == ('D' | 1 << 8 | 1 << 16));
+    CHECK(kp_test_run(1u << 0 | 1u << 15, 20) == 1); // '8' released
+    CHECK(kp_test_event() == ('8' | 1 << 16));
+
+    // One scan's events come in code order: '0' is code 13
+    CHECK(kp_test_run(1u << 13, 20) == 3);
+    CHECK(kp_test_event() == ('1' | 1 << 16));
+    CHECK(kp_test_event() == ('0' | 1 << 8 | 1 << 16));
+    CHECK(kp_test_event() == ('D' | 1 << 16));
+
+    // All released, then IDLE after 8 empty scans
+    CHECK(kp_test_run(0, 20) == 1);
+    CHECK(kp_test_event() == ('0' | 1 << 16));
+    CHECK(!kp_test_idle());
+    n = scans;
+    CHECK(kp_test_run(0, 40) == 0);
+    CHECK(kp_test_idle());
+    CHECK(wakeups == 1 && scans - n <= 8);
+    CHECK(kp_test_event() == 0);
+}
+
+/* Software UART (014_03) at 115200 baud, 80 MHz: 694 clocks
+ * per bit. TX edges sit exactly on the bit grid, characters go
+ * back to back with one match interrupt per bit, and RX samples
+ * from the captured edge, so ISR latency and a 3 % baud error on
+ * the sender still give the right byte. */
+void test_soft_uart(void)
+{
+    static const uint8_t bytes[2] = {0x55, 0xA5};
+    uint32_t t[32], matches, n, i, k, bit, errors;
+    uint8_t level[32], seq[20], prev = 1;
+    char c[4];
+    int ok = 1;
+
+    for (k = 0; k < 20; k++) // start, 8 data LSB first, stop
+    {
+        bit = k % 10;
+        seq[k] = bit == 0 ? 0 : bit == 9 ? 1 : (bytes[k / 10] >> (bit - 1)) & 1;
+    }
+    for (k = 0, i = 0; k < 20; prev = seq[k++])
+        i += seq[k] != prev;
+
+    n = suart_test_tx("\x55\xA5", 2, t, level, 32, &matches);
+    CHECK(n == i);
+    CHECK(matches == 21); // 20 bits + the idle check after the stop bit
+    for (k = 0; k < n; k++)
+        ok &= (t[k] - t[0]) % 694 == 0 && (t[k] - t[0]) / 694 < 20 &&
+              level[k] == seq[(t[k] - t[0]) / 694];
+    CHECK(ok);
+
+    // 0xA5 framed: start 0, data, stop 1
+    CHECK(suart_test_rx(0x200 | 0xA5 << 1, 694, 0, c, &errors) == 1);
+    CHECK(c[0] == (char)0xA5 && errors == 0);
+    CHECK(suart_test_rx(0x200 | 0xA5 << 1, 694, 300, c, &errors) == 1);
+    CHECK(c[0] == (char)0xA5);
+    CHECK(suart_test_rx(0x200 | 0x3C << 1, 715, 100, c, &errors) == 1);
+    CHECK(c[0] == 0x3C);
+    CHECK(suart_test_rx(0x200 | 0x3C << 1, 673, 100, c, &errors) == 1);
+    CHECK(c[0] == 0x3C);
+
+    // Stop bit LOW: framing error; start bit HIGH at mid-bit: glitch
+    CHECK(suart_test_rx(0xA5 << 1, 694, 0, c, &errors) == 0);
+    CHECK(errors == 1);
+    CHECK(suart_test_rx(0x3FF, 694, 0, c, &errors) == 0);
+    CHECK(errors == 0);
+}
+
+/* Auto-baud (014_04) at 80 MHz: the ten edges of 'U' give the
+ * UART1 divisor, also across the 24-bit capture wrap. A rate
+ * within 2 % of a standard one gets that rate's exact divisor,
+ * others keep the measured one, and an edge that breaks the bit
+ * timing restarts detection without touching UART1. */
+void test_autobaud(void)
+{
+    static const struct
+    {
+        uint32_t baud, detected, divisor; // divisor = IBRD << 6 | FBRD
+    } cases[] = {
+        {9600, 9600, 520 << 6 | 53},
+        {115200, 115200, 43 << 6 | 26},
+        {230400, 230400, 21 << 6 | 45},
+        {9744, 9600, 520 << 6 | 53},  // 1.5 % fast: snapped
+        {9888, 9888, 505 << 6 | 42},  // 3 % fast: measured
+        {100000, 100000, 50 << 6 | 0}, // not a standard rate
+    };
+    unsigned int i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        ab_test_reset();
+        CHECK(ab_test_sync(cases[i].baud, i & 1 ? 0x000100 : 0x800000) ==
+              cases[i].detected);
+        CHECK(ab_test_divisor() == cases[i].divisor);
+    }
+
+    // Idle line: a rising edge is not a start bit
+    ab_test_reset();
+    CHECK(ab_test_edge(0x800000, 1) == 0);
+
+    // 'U' at 9600 whose fourth edge comes a bit late: not one rate
+    CHECK(ab_test_edge(0x800000, 0) == 1);
+    CHECK(ab_test_edge(0x800000 - 8333, 1) == 2);
+    CHECK(ab_test_edge(0x800000 - 16667, 0) == 3);
+    CHECK(ab_test_edge(0x800000 - 33333, 1) == 0);
+    CHECK(ab_test_detected() == 0 && ab_test_divisor() == 0);
+
+    // The next clean 'U' is detected
+    CHECK(ab_test_sync(115200, 0x700000) == 115200);
+    CHECK(ab_test_divisor() == (43 << 6 | 26));
+}
+
+/* uDMA RX (014_05): byte stream for the frames below */
+static uint8_t dmarx_byte(uint32_t i)
+{
+    return (uint8_t)(i * 7 + 1);
+}
+
+/* Sends n stream bytes from *pos as one frame */
+static void dmarx_send(uint32_t *pos, uint32_t n, int late)
+{
+    static uint8_t buf[1024];
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+        buf[i] = dmarx_byte(*pos + i);
+    dmarx_test_frame(buf, n, late);
+    *pos += n;
+}
+
+/* 1 if the oldest frame is n stream bytes from pos */
+static int dmarx_check(uint32_t pos, uint32_t n, uint32_t *spans)
+{
+    static uint8_t out[1024];
+    uint32_t i;
+    int ok = dmarx_test_get(out, spans) == (int)n;
+
+    for (i = 0; ok && i < n; i++)
+        ok = out[i] == dmarx_byte(pos + i);
+    return ok;
+}
+
+/* uDMA RX (014_05): frames come back in place across the ring
+ * end, a ring-end completion racing the receive timeout is
+ * counted once, frames uDMA overwrote are skipped (also when it
+ * happens while the parser holds one), and a full frame queue
+ * makes a frame join the next one. */
+void test_dma_rx(void)
+{
+    uint32_t pos = 0, start, n, k, spans, wraps = 0;
+    int ok = 1;
+
+    dmarx_test_reset();
+    for (k = 0; k < 40; k++)
+    {
+        n = (k * 37) % 61 + 1;
+        start = pos;
+        dmarx_send(&pos, n, 0);
+        ok &= dmarx_check(start, n, &spans);
+        ok &= dmarx_test_release();
+        wraps += spans == 2;
+    }
+    CHECK(ok);
+    CHECK(wraps == 1 && dmarx_test_count(0) == pos);
+    CHECK(dmarx_test_count(1) == 0 && dmarx_test_count(2) == 0);
+
+    // Last burst fills the ring; its completion comes after RT
+    dmarx_test_reset();
+    pos = 0;
+    dmarx_send(&pos, 1020, 0);
+    CHECK(dmarx_check(0, 1020, &spans) && dmarx_test_release());
+    dmarx_send(&pos, 8, 1);
+    CHECK(dmarx_test_count(0) == 1028);
+    CHECK(dmarx_check(1020, 8, &spans) && spans == 2);
+    CHECK(dmarx_test_release());
+    dmarx_send(&pos, 20, 0);
+    CHECK(dmarx_test_count(3) == 1048);
+    CHECK(dmarx_check(1028, 20, &spans) && dmarx_test_release());
+
+    // 1200 bytes unreleased: the first frame is gone
+    dmarx_test_reset();
+    pos = 0;
+    for (k = 0; k < 3; k++)
+        dmarx_send(&pos, 400, 0);
+    CHECK(dmarx_check(400, 400, &spans));
+    CHECK(dmarx_test_count(2) == 1);
+    dmarx_send(&pos, 700, 0); // overruns the frame being read
+    CHECK(!dmarx_test_release());
+    CHECK(dmarx_test_count(2) == 2);
+    CHECK(dmarx_check(1200, 700, &spans)); // 800 - 1199 skipped
+    CHECK(dmarx_test_release() && dmarx_test_count(2) == 3);
+
+    // 17 frames, 16 queue entries: the 17th joins the 18th
+    dmarx_test_reset();
+    pos = 0;
+    for (k = 0; k < 17; k++)
+        dmarx_send(&pos, 3, 0);
+    CHECK(dmarx_test_count(1) == 1);
+    for (k = 0, ok = 1; k < 16; k++)
+        ok &= dmarx_check(k * 3, 3, &spans) && dmarx_test_release();
+    CHECK(ok);
+    CHECK(dmarx_test_get(0, &spans) == -1);
+    dmarx_send(&pos, 3, 0);
+    CHECK(dmarx_check(48, 6, &spans) && dmarx_test_release());
+}
+
+/* Modbus CRC-16 one bit at a time (reflected 0xA001) */
+static uint16_t crc16_bitwise(const uint8_t *p, uint32_t n)
+{
+    uint16_t crc = 0xFFFF;
+    int k;
+
+    while (n--)
+        for (crc ^= *p++, k = 0; k < 8; k++)
+            crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+    return crc;
+}
+
+/* Modbus slave (014_06): the table CRC matches the spec example
+ * and the bitwise CRC, and mb_execute() answers each function,
+ * checking the function code before the length (01 before 03),
+ * then the address (02) and the values (03). */
+void test_modbus(void)
+{
+    static const uint8_t spec[8] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x0A, 0xC5, 0xCD};
+    static const uint8_t rd_hold[6] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x02};
+    static const uint8_t rd_input[6] = {0x01, 0x04, 0x00, 0x00, 0x00, 0x01};
+    static const uint8_t wr_ok[6] = {0x01, 0x06, 0x00, 0x00, 0x06, 0x3F};
+    static const uint8_t wr_big[6] = {0x01, 0x06, 0x00, 0x00, 0x06, 0x40};
+    static const uint8_t wr_addr[6] = {0x01, 0x06, 0x00, 0x02, 0x00, 0x01};
+    static const uint8_t wr_multi[11] = {0x01, 0x10, 0x00, 0x00, 0x00, 0x02,
+                                         0x04, 0x00, 0x64, 0x00, 0x02};
+    static const uint8_t unknown[2] = {0x01, 0x2B};
+    uint8_t buf[64], rsp[64];
+    uint32_t i, n;
+    int ok = 1;
+
+    CHECK(mb_crc16(spec, 6) == 0xCDC5);
+    CHECK(mb_crc16(spec, 8) == 0); // frame including its CRC
+    for (i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t)(i * 29 + 3);
+    for (n = 0; n <= sizeof(buf); n += 7)
+        ok &= mb_crc16(buf, n) == crc16_bitwise(buf, n);
+    CHECK(ok);
+
+    n = mb_test_request(rd_hold, 6, rsp, 800, 1);
+    CHECK(n == 7 && rsp[1] == 0x03 && rsp[2] == 4);
+    CHECK(rsp[3] == 0x03 && rsp[4] == 0x20 && rsp[5] == 0 && rsp[6] == 1);
+    n = mb_test_request(rd_input, 6, rsp, 0, 0);
+    CHECK(n == 5 && rsp[3] == 0x0A && rsp[4] == 0xBC);
+
+    // Write single: echo, field written; PWM_LOAD + 1 is refused
+    CHECK(mb_test_request(wr_ok, 6, rsp, 0, 1) == 6 && rsp[4] == 0x06 && rsp[5] == 0x3F);
+    CHECK(mb_test_outputs() == (0x10000 | 1599));
+    CHECK(mb_test_request(wr_big, 6, rsp, 7, 0) == 3 && rsp[1] == 0x86 && rsp[2] == 0x03);
+    CHECK(mb_test_outputs() == 7);
+    CHECK(mb_test_request(wr_addr, 6, rsp, 0, 0) == 3 && rsp[2] == 0x02);
+
+    // Write multiple: PF1 = 2 is out of range, so nothing is written
+    CHECK(mb_test_request(wr_multi, 11, rsp, 9, 0) == 3 && rsp[1] == 0x90 && rsp[2] == 0x03);
+    CHECK(mb_test_outputs() == 9);
+    buf[0] = 0;
+    for (i = 0; i < 10; i++)
+        buf[i] = wr_multi[i];
+    buf[10] = 0x01;
+    CHECK(mb_test_request(buf, 11, rsp, 9, 0) == 6 && rsp[5] == 0x02);
+    CHECK(mb_test_outputs() == (0x10000 | 100));
+
+    // Short frames: unknown function → 01, known function → 03
+    CHECK(mb_test_request(unknown, 2, rsp, 0, 0) == 3 && rsp[1] == 0xAB && rsp[2] == 0x01);
+    CHECK(mb_test_request(rd_hold, 4, rsp, 0, 0) == 3 && rsp[1] == 0x83 && rsp[2] == 0x03);
+}
+
+#define SCOPE_TEST_RING 2048 // SCOPE_BLOCK x SCOPE_BLOCKS
+
+/* Oscilloscope (011_04): each trigger type fires on the right
+ * sample, the edge hysteresis carries over between blocks, and
+ * 12-bit packing (two samples in 3 bytes) unpacks to the ring
+ * contents across the ring end with a matching XOR. */
+void test_scope(void)
+{
+    static const uint16_t blk1[8] = {2000, 1990, 2100, 2040, 1980, 1900, 1950, 2010};
+    static const uint16_t blk2[8] = {2030, 2047, 2048, 2300, 100, 0, 4095, 3000};
+    uint16_t v[64], a, b;
+    uint8_t out[96], sum = 0, pack;
+    uint32_t i;
+    int ok = 1;
+
+    // Level: first sample >= level, samples before `first` ignored
+    scope_test_trigger(0, 2048, 64, 0, 0);
+    CHECK(scope_scan(blk2, 0, 8, 100) == 102);
+    CHECK(scope_scan(blk2, 3, 8, 100) == 103);
+    CHECK(scope_scan(blk1, 0, 8, 0) == 2);
+
+    // Rising edge: 2100 does not count until the signal went
+    // below level - hyst (1980 < 1984); the state survives the
+    // block, so the trigger is the first >= 2048 in the next one
+    scope_test_trigger(1, 2048, 64, 0, 0);
+    CHECK(scope_scan(blk1, 0, 8, 0) == -1);
+    CHECK(scope_scan(blk2, 0, 8, 8) == 10);
+
+    // Falling edge: primed above level + hyst (2300 > 2112)
+    scope_test_trigger(2, 2048, 64, 0, 0);
+    CHECK(scope_scan(blk2, 0, 8, 8) == 12);
+
+    // Window: first sample outside [1950, 2050]
+    scope_test_trigger(3, 0, 0, 1950, 2050);
+    CHECK(scope_scan(blk1, 0, 8, 40) == 42);
+    CHECK(scope_scan(blk1, 3, 8, 40) == 45);
+    scope_test_trigger(3, 0, 0, 0, 4095);
+    CHECK(scope_scan(blk2, 0, 8, 0) == -1);
+
+    // Packing: a = p0 | (p1 & 15) << 8, b = p1 >> 4 | p2 << 4
+    for (i = 0; i < 64; i++)
+        v[i] = (uint16_t)((i * 0x9E5 + 0x123) & 0xFFF);
+    v[0] = 0xABC;
+    v[1] = 0x123;
+    pack = scope_test_pack(v, 64, SCOPE_TEST_RING - 10, out); // wraps
+    CHECK(out[0] == 0xBC && out[1] == 0x3A && out[2] == 0x12);
+    for (i = 0; i < 64; i += 2)
+    {
+        a = (uint16_t)(out[i * 3 / 2] | (out[i * 3 / 2 + 1] & 0x0F) << 8);
+        b = (uint16_t)(out[i * 3 / 2 + 1] >> 4 | out[i * 3 / 2 + 2] << 4);
+        ok &= a == v[i] && b == v[i + 1];
+    }
+    for (i = 0; i < 96; i++)
+        sum ^= out[i];
+    CHECK(ok);
+    CHECK(pack == sum);
+}
+
+/* Adaptive sampler (011_05): the ms clock keeps counting when
+ * the 32-bit Timer1 wraps (every 268 s at 16 MHz), and a burst
+ * that spans the wrap still holds for HOLD_MS before going idle. */
+void test_adaptive_rate(void)
+{
+    uint32_t t, ms, i, ok = 1;
+
+    // 50 ms steps from 0 to 600 s: two timer wraps
+    adapt_test_reset(0);
+    for (ms = 50; ms <= 600000; ms += 50)
+        ok &= adapt_test_now(ms * 16000u) == ms;
+    CHECK(ok);
+
+    // Enter burst 100 ms before the wrap, then stay quiet
+    t = 0u - 100 * 16000u;
+    adapt_test_reset(t);
+    for (i = 0; i < 2; i++, t += 1600000) // 10 Hz: 100 ms apart
+        adapt_test_sample(t, 1000);
+    CHECK(adapt_test_sample(t, 1100) == 1); // activity 100 → BURST
+    for (i = 0; i < 499; i++) // 1 kHz, 1 ms apart, across the wrap
+    {
+        t += 16000;
+        ok &= adapt_test_sample(t, 1100) == 1;
+    }
+    CHECK(ok);
+    t += 16000;
+    CHECK(adapt_test_sample(t, 1100) == 0); // 500 ms quiet → IDLE
+}
+
+/* Differential calibration (011_06): the nominal scale puts
+ * mid-scale at 0 uV, a two-point fit maps both points back to
+ * their uV on its own channel only, and points too close or a
+ * scale that overflows int32 leave the coefficients alone. */
+void test_calibration(void)
+{
+    static const uint16_t in[6] = {2048, 2048, 0, 2668, 4095, 4095};
+    int32_t out[6], gain, bias, g1, b1;
+
+    cal_defaults();
+    cal_apply(in, out, 3);
+    CHECK(out[0] == 0 && out[1] == 0);
+    CHECK(out[2] == -3300000 && out[4] == 3298388); // 1611.328 uV per code
+
+    // ch1: 2048 = 0 uV, 2668 = 1 V → 1612.903 uV per code
+    CHECK(cal_test_points(1, 2048 << 8, 0, 2668 << 8, 1000000, &g1, &b1) == 1);
+    CHECK(g1 == 105703225 && b1 == -3303225);
+    cal_apply(in, out, 3);
+    CHECK(out[0] == 0 && out[1] == 0);
+    CHECK(out[3] >= 999999 && out[3] <= 1000001);
+    CHECK(out[2] == -3300000 && out[4] == 3298388); // ch0 unchanged
+
+    // 63 codes apart: refused
+    CHECK(cal_test_points(1, 2000 << 8, 0, 2063 << 8, 100000, &gain, &bias) == 0);
+    CHECK(gain == g1 && bias == b1);
+
+    // Gain above INT32_MAX (4e9 uV over 64 codes)
+    CHECK(cal_test_points(1, 0, -2000000000, 64 << 8, 2000000000, &gain, &bias) == -1);
+    CHECK(gain == g1 && bias == b1);
+
+    // Gain and bias fit, but code 4095 would read 2.231e9 uV
+    CHECK(cal_test_points(1, 0, 2100000000, 64 << 8, 2102048000, &gain, &bias) == -1);
+    CHECK(gain == g1 && bias == b1);
+    CHECK(cal_test_points(1, 0, 2000000000, 64 << 8, 2002048000, &gain, &bias) == 1);
+    CHECK(gain == 32000 << 16 && bias == 2000000000);
+
+    cal_defaults();
+}
+
+/***********************************************************
+ * BENCHMARKS
+ ***********************************************************/
+#define BENCH_REPEAT 1000
+
+static uint32_t cal_ticks;     // SysTick ticks for the calibration loop
+static uint32_t cal_instr;     // instructions in the calibration loop
+
+static uint32_t systick_elapsed(uint32_t start)
+{
+    return (start - SYST_CVR) & 0x00FFFFFF; // 24-bit down counter
+}
+
+/* 2 instructions per pass (subs + bne) */
+static void calibrate(void)
+{
+    uint32_t start, n = 100000;
+
+    cal_instr = 2 * n;
+    start = SYST_CVR;
+#ifdef __arm__
+    __asm volatile("1: subs %0, %0, #1\n bne 1b" : "+r"(n));
+#endif
+    cal_ticks = systick_elapsed(start);
+}
+
+static uint32_t bench_report(const char *name, uint32_t ticks)
+{
+    uint64_t instr = (uint64_t)ticks * cal_instr / cal_ticks;
+
+    semihost_write("  ");
+    semihost_write(name);
+    semihost_write(": ");
+    print_number((uint32_t)(instr / BENCH_REPEAT));
+    semihost_write(" instr/call\n");
+    return (uint32_t)(instr / BENCH_REPEAT);
+}
+
+#define BENCH(name, call)                          \
+    do                                             \
+    {                                              \
+        uint32_t i_, start_ = SYST_CVR;            \
+        for (i_ = 0; i_ < BENCH_REPEAT; i_++)      \
+            call;                                  \
+        bench_report(name, systick_elapsed(start_)); \
+    } while (0)
+
+/* Hard real-time paths: fail when a call exceeds its budget */
+#define BENCH_BUDGET(name, budget, call)                                \
+    do                                                                  \
+    {                                                                   \
+        uint32_t i_, start_ = SYST_CVR;                                 \
+        for (i_ = 0; i_ < BENCH_REPEAT; i_++)                           \
+            call;                                                       \
+        CHECK(bench_report(name, systick_elapsed(start_)) <= (budget)); \
+    } while (0)
+
+/* Parsers: bytes handled per 1000 instructions */
+static void bench_bytes_report(const char *name, uint32_t bytes, uint32_t ticks)
+{
+    uint64_t instr = (uint64_t)ticks * cal_instr / cal_ticks;
+
+    bench_report(name, ticks);
+    semihost_write("    ");
+    print_number((uint32_t)((uint64_t)bytes * BENCH_REPEAT * 1000 / (instr ? instr : 1)));
+    semihost_write(" bytes/1000 instr\n");
+}
+
+#define BENCH_BYTES(name, bytes, call)                      \
+    do                                                      \
+    {                                                       \
+        uint32_t i_, start_ = SYST_CVR;                     \
+        for (i_ = 0; i_ < BENCH_REPEAT; i_++)               \
+            call;                                           \
+        bench_bytes_report(name, bytes, systick_elapsed(start_)); \
+    } while (0)
+
+void run_benchmarks(void)
+{
+    int32_t out[6];
+    uint32_t bad;
+
+    SYST_RVR = 0x00FFFFFF;
+    SYST_CVR = 0;
+    SYST_CSR = 0x05; // processor clock, no interrupt, enable
+
+    calibrate();
+    if (cal_ticks == 0)
+    {
+        semihost_write("  SysTick not running, benchmarks skipped\n");
+        return;
+    }
+
+    BENCH("seg7_shift_out1", seg7_shift_out1(0xA5));
+    BENCH("lcd_shift_out1", lcd_shift_out1(0xA5));
+    BENCH("LCD_command", LCD_command(0x28));
+    BENCH("LCD_putc", LCD_putc('A'));
+    BENCH("key_scan (worst case)", key_scan(0xFFF));
+    BENCH_BYTES("nmea_replay (recorded log)", NMEA_LOG_LEN,
+                nmea_replay(nmea_log, NMEA_LOG_LEN, 0, 0, out, &bad));
+
+    // 20 kHz at 80 MHz = 4000 cycles; the ISR may take a quarter
+    foc_bench_init();
+    BENCH_BUDGET("foc_step (20 kHz loop, budget 1000)", 1000, foc_bench_step());
+
+    // 128 samples = 16 ms = 1.28 M cycles at 80 MHz; 2 % = 25600
+    BENCH_BUDGET("audio_fill (2 voices, 128 samples, budget 25600)", 25600,
+                 audio_bench_half());
+
+    // 256 PWM periods = 262144 cycles; 1 % = 2621
+    BENCH_BUDGET("sd_fill (256 periods, budget 2621)", 2621, sd_bench_half());
+
+    // 1024 samples at 2 MHz = 40960 cycles; the compressor may take
+    // half, also when every sample changes (2048 stream bytes)
+    BENCH_BUDGET("la_compress (1024 changes, budget 20480)", 20480,
+                 la_bench_half());
+
+    // 64 gates of 100 us = 512000 cycles; 1 % = 5120
+    BENCH_BUDGET("fc_gate_block (64 gates, budget 5120)", 5120,
+                 fc_bench_block());
+
+    bus_test_reset();
+    BENCH("bus publish + dispatch (adc, 3 subscribers)", bus_bench_round());
+}
+
+int main(void)
+{
+    semihost_write("test_seg7_shift_out\n");
+    test_seg7_shift_out();
+    semihost_write("test_lcd_nibbles\n");
+    test_lcd_nibbles();
+    semihost_write("test_key_scan\n");
+    test_key_scan();
+    semihost_write("test_bus_utilization\n");
+    test_bus_utilization();
+    semihost_write("test_nmea_parser\n");
+    test_nmea_parser();
+    semihost_write("test_foc\n");
+    test_foc();
+    semihost_write("test_audio\n");
+    test_audio();
+    semihost_write("test_sigma_delta\n");
+    test_sigma_delta();
+    semihost_write("test_pattern_generator\n");
+    test_pattern_generator();
+    semihost_write("test_logic_analyzer\n");
+    test_logic_analyzer();
+    semihost_write("test_frequency_counter\n");
+    test_frequency_counter();
+    semihost_write("test_event_bus\n");
+    test_event_bus();
+    semihost_write("test_ram_functions\n");
+    test_ram_functions();
+    semihost_write("test_cpp_hal\n");
+    test_cpp_hal();
+    semihost_write("test_ws2812\n");
+    test_ws2812();
+    semihost_write("test_io_expander\n");
+    test_io_expander();
+    semihost_write("test_keypad\n");
+    test_keypad();
+    semihost_write("test_soft_uart\n");
+    test_soft_uart();
+    semihost_write("test_autobaud\n");
+    test_autobaud();
+    semihost_write("test_dma_rx\n");
+    test_dma_rx();
+    semihost_write("test_modbus\n");
+    test_modbus();
+    semihost_write("test_scope\n");
+    test_scope();
+    semihost_write("test_adaptive_rate\n");
+    test_adaptive_rate();
+    semihost_write("test_calibration\n");
+    test_calibration();
+
+    semihost_write("benchmarks\n");
+    run_benchmarks();
+
+    semihost_write(failures ? "FAIL\n" : "PASS\n");
+    return failures ? 1 : 0;
+}
+
+/***********************************************************
+ * SEMIHOSTING (BKPT 0xAB, operation in r0, argument in r1)
+ ***********************************************************/
+#ifdef __arm__
+static uint32_t semihost_call(uint32_t op, const void *arg)
+{
+    register uint32_t r0 __asm("r0") = op;
+    register const void *r1 __asm("r1") = arg;
+
+    __asm volatile("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+
+void semihost_write(const char *s)
+{
+    semihost_call(0x04, s); // SYS_WRITE0
+}
+
+void semihost_exit(int status)
+{
+    // SYS_EXIT with ADP_Stopped_ApplicationExit (0x20026) means
+    // success; any other reason makes QEMU exit with status 1.
+    semihost_call(0x18, (const void *)(status ? 0x20023 : 0x20026));
+    while (1)
+        ;
+}
+#else
+void semihost_write(const char *s)
+{
+    fputs(s, stdout);
+}
+
+void semihost_exit(int status)
+{
+    exit(status);
+}
+#endif
+
+void print_number(uint32_t n)
+{
+    char buf[11];
+    int i = 10;
+
+    buf[i] = 0;
+    do
+    {
+        buf[--i] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    semihost_write(&buf[i]);
+}
@@ -0,0 +1,33 @@
+/***************************************************************
+ * FILE NAME : shim_regs.c
+ *
+ * DESCRIPTION :
+ * Storage for the test shim registers declared in the shim
+ * tm4c123gh6pm.h. One word of RAM per register.
+ ***************************************************************/
+
+#include "tm4c123gh6pm.h"
+
+#define TM4C_SHIM_DEFINE(name) volatile uint32_t name;
+TM4C_SHIM_REGISTERS(TM4C_SHIM_DEFINE)
+#undef TM4C_SHIM_DEFINE
+
+#define TM4C_SHIM_DEFINE_BITS(port) volatile uint32_t GPIO_PORT##port##_DATA_BITS_R[256];
+TM4C_SHIM_GPIO_PORTS(TM4C_SHIM_DEFINE_BITS)
+#undef TM4C_SHIM_DEFINE_BITS
+
+void tm4c_shim_reset(void)
+{
+    int i;
+
+#define TM4C_SHIM_CLEAR(name) name = 0;
+    TM4C_SHIM_REGISTERS(TM4C_SHIM_CLEAR)
+#undef TM4C_SHIM_CLEAR
+
+    for (i = 0; i < 256; i++)
+    {
+#define TM4C_SHIM_CLEAR_BITS(port) GPIO_PORT##port##_DATA_BITS_R[i] = 0;
+        TM4C_SHIM_GPIO_PORTS(TM4C_SHIM_CLEAR_BITS)
+#undef TM4C_SHIM_CLEAR_BITS
+    }
+}
@@ -0,0 +1,764 @@
+/***************************************************************
+ * FILE NAME : tm4c123gh6pm.h  (TEST SHIM)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Drop-in replacement for the Keil/TivaWare device header used
+ * when the demo drivers are built for QEMU or for the host.
+ *
+ * Every register the demos use becomes an ordinary global
+ * variable with the SAME name, e.g.
+ *
+ *      extern volatile uint32_t GPIO_PORTF_DATA_R;
+ *
+ * so driver code such as "GPIO_PORTF_DATA_R |= 0x08;" compiles
+ * unchanged, but reads and writes go to RAM instead of real
+ * peripherals. A test can preload status registers (for example
+ * UART0_FR_R = 0 so "TX FIFO not full") and inspect what the
+ * driver wrote afterwards.
+ *
+ * To add a register, append one X(...) line to the list below;
+ * shim_regs.c defines the storage from the same list.
+ ***************************************************************/
+
+#ifndef TM4C123GH6PM_SHIM_H
+#define TM4C123GH6PM_SHIM_H
+
+#include <stdint.h>
+
+#define TM4C_SHIM 1
+
+#define TM4C_SHIM_REGISTERS(X) \
+    /* System control */       \
+    X(SYSCTL_RIS_R)            \
+    X(SYSCTL_RCC_R)            \
+    X(SYSCTL_RCC2_R)           \
+    X(SYSCTL_RCGCGPIO_R)       \
+    X(SYSCTL_RCGCTIMER_R)      \
+    X(SYSCTL_RCGCUART_R)       \
+    X(SYSCTL_RCGCADC_R)        \
+    X(SYSCTL_RCGCPWM_R)        \
+    X(SYSCTL_RCGCSSI_R)        \
+    X(SYSCTL_RCGCDMA_R)        \
+    X(SYSCTL_PRGPIO_R)         \
+    X(SYSCTL_RCGCWTIMER_R)     \
+    X(SYSCTL_RCGCEEPROM_R)     \
+    X(SYSCTL_PREEPROM_R)       \
+    X(SYSCTL_PRUART_R)         \
+    X(SYSCTL_PRTIMER_R)        \
+    X(SYSCTL_PRWTIMER_R)       \
+    X(SYSCTL_PRSSI_R)          \
+    X(SYSCTL_PRADC_R)          \
+    X(SYSCTL_PRPWM_R)          \
+    X(SYSCTL_SREEPROM_R)       \
+    X(SYSCTL_GPIOHBCTL_R)      \
+    /* NVIC and SysTick */     \
+    X(NVIC_EN0_R)              \
+    X(NVIC_VTABLE_R)           \
+    X(NVIC_SW_TRIG_R)          \
+    X(NVIC_ST_CTRL_R)          \
+    X(NVIC_ST_RELOAD_R)        \
+    X(NVIC_ST_CURRENT_R)       \
+    X(NVIC_EN1_R)              \
+    X(NVIC_EN2_R)              \
+    X(NVIC_EN3_R)              \
+    X(NVIC_EN4_R)              \
+    X(NVIC_DIS0_R)             \
+    X(NVIC_DIS1_R)             \
+    X(NVIC_DIS2_R)             \
+    X(NVIC_DIS3_R)             \
+    X(NVIC_DIS4_R)             \
+    /* GPIO Port A */          \
+    X(GPIO_PORTA_DATA_R)       \
+    X(GPIO_PORTA_DIR_R)        \
+    X(GPIO_PORTA_AFSEL_R)      \
+    X(GPIO_PORTA_DEN_R)        \
+    X(GPIO_PORTA_PCTL_R)       \
+    X(GPIO_PORTA_IS_R)         \
+    X(GPIO_PORTA_IBE_R)        \
+    X(GPIO_PORTA_IEV_R)        \
+    X(GPIO_PORTA_IM_R)         \
+    X(GPIO_PORTA_RIS_R)        \
+    X(GPIO_PORTA_MIS_R)        \
+    X(GPIO_PORTA_ICR_R)        \
+    X(GPIO_PORTA_DR2R_R)       \
+    X(GPIO_PORTA_DR4R_R)       \
+    X(GPIO_PORTA_DR8R_R)       \
+    X(GPIO_PORTA_ODR_R)        \
+    X(GPIO_PORTA_PUR_R)        \
+    X(GPIO_PORTA_PDR_R)        \
+    X(GPIO_PORTA_SLR_R)        \
+    X(GPIO_PORTA_LOCK_R)       \
+    X(GPIO_PORTA_CR_R)         \
+    X(GPIO_PORTA_AMSEL_R)      \
+    X(GPIO_PORTA_ADCCTL_R)     \
+    X(GPIO_PORTA_DMACTL_R)     \
+    /* GPIO Port B */          \
+    X(GPIO_PORTB_DATA_R)       \
+    X(GPIO_PORTB_DIR_R)        \
+    X(GPIO_PORTB_AFSEL_R)      \
+    X(GPIO_PORTB_DEN_R)        \
+    X(GPIO_PORTB_PCTL_R)       \
+    X(GPIO_PORTB_IS_R)         \
+    X(GPIO_PORTB_IBE_R)        \
+    X(GPIO_PORTB_IEV_R)        \
+    X(GPIO_PORTB_IM_R)         \
+    X(GPIO_PORTB_RIS_R)        \
+    X(GPIO_PORTB_MIS_R)        \
+    X(GPIO_PORTB_ICR_R)        \
+    X(GPIO_PORTB_DR2R_R)       \
+    X(GPIO_PORTB_DR4R_R)       \
+    X(GPIO_PORTB_DR8R_R)       \
+    X(GPIO_PORTB_ODR_R)        \
+    X(GPIO_PORTB_PUR_R)        \
+    X(GPIO_PORTB_PDR_R)        \
+    X(GPIO_PORTB_SLR_R)        \
+    X(GPIO_PORTB_LOCK_R)       \
+    X(GPIO_PORTB_CR_R)         \
+    X(GPIO_PORTB_AMSEL_R)      \
+    X(GPIO_PORTB_ADCCTL_R)     \
+    X(GPIO_PORTB_DMACTL_R)     \
+    X(GPIO_PORTB_AHB_DIR_R)    \
+    X(GPIO_PORTB_AHB_DEN_R)    \
+    /* GPIO Port C */          \
+    X(GPIO_PORTC_DATA_R)       \
+    X(GPIO_PORTC_DIR_R)        \
+    X(GPIO_PORTC_AFSEL_R)      \
+    X(GPIO_PORTC_DEN_R)        \
+    X(GPIO_PORTC_PCTL_R)       \
+    X(GPIO_PORTC_IS_R)         \
+    X(GPIO_PORTC_IBE_R)        \
+    X(GPIO_PORTC_IEV_R)        \
+    X(GPIO_PORTC_IM_R)         \
+    X(GPIO_PORTC_RIS_R)        \
+    X(GPIO_PORTC_MIS_R)        \
+    X(GPIO_PORTC_ICR_R)        \
+    X(GPIO_PORTC_DR2R_R)       \
+    X(GPIO_PORTC_DR4R_R)       \
+    X(GPIO_PORTC_DR8R_R)       \
+    X(GPIO_PORTC_ODR_R)        \
+    X(GPIO_PORTC_PUR_R)        \
+    X(GPIO_PORTC_PDR_R)        \
+    X(GPIO_PORTC_SLR_R)        \
+    X(GPIO_PORTC_LOCK_R)       \
+    X(GPIO_PORTC_CR_R)         \
+    X(GPIO_PORTC_AMSEL_R)      \
+    X(GPIO_PORTC_ADCCTL_R)     \
+    X(GPIO_PORTC_DMACTL_R)     \
+    /* GPIO Port D */          \
+    X(GPIO_PORTD_DATA_R)       \
+    X(GPIO_PORTD_DIR_R)        \
+    X(GPIO_PORTD_AFSEL_R)      \
+    X(GPIO_PORTD_DEN_R)        \
+    X(GPIO_PORTD_AMSEL_R)      \
+    X(GPIO_PORTD_PCTL_R)       \
+    X(GPIO_PORTD_IS_R)         \
+    X(GPIO_PORTD_IBE_R)        \
+    X(GPIO_PORTD_IEV_R)        \
+    X(GPIO_PORTD_IM_R)         \
+    X(GPIO_PORTD_RIS_R)        \
+    X(GPIO_PORTD_MIS_R)        \
+    X(GPIO_PORTD_ICR_R)        \
+    X(GPIO_PORTD_DR2R_R)       \
+    X(GPIO_PORTD_DR4R_R)       \
+    X(GPIO_PORTD_DR8R_R)       \
+    X(GPIO_PORTD_ODR_R)        \
+    X(GPIO_PORTD_PUR_R)        \
+    X(GPIO_PORTD_PDR_R)        \
+    X(GPIO_PORTD_SLR_R)        \
+    X(GPIO_PORTD_LOCK_R)       \
+    X(GPIO_PORTD_CR_R)         \
+    X(GPIO_PORTD_ADCCTL_R)     \
+    X(GPIO_PORTD_DMACTL_R)     \
+    /* GPIO Port E */          \
+    X(GPIO_PORTE_DATA_R)       \
+    X(GPIO_PORTE_DIR_R)        \
+    X(GPIO_PORTE_AFSEL_R)      \
+    X(GPIO_PORTE_DEN_R)        \
+    X(GPIO_PORTE_AMSEL_R)      \
+    X(GPIO_PORTE_PCTL_R)       \
+    X(GPIO_PORTE_IS_R)         \
+    X(GPIO_PORTE_IBE_R)        \
+    X(GPIO_PORTE_IEV_R)        \
+    X(GPIO_PORTE_IM_R)         \
+    X(GPIO_PORTE_RIS_R)        \
+    X(GPIO_PORTE_MIS_R)        \
+    X(GPIO_PORTE_ICR_R)        \
+    X(GPIO_PORTE_DR2R_R)       \
+    X(GPIO_PORTE_DR4R_R)       \
+    X(GPIO_PORTE_DR8R_R)       \
+    X(GPIO_PORTE_ODR_R)        \
+    X(GPIO_PORTE_PUR_R)        \
+    X(GPIO_PORTE_PDR_R)        \
+    X(GPIO_PORTE_SLR_R)        \
+    X(GPIO_PORTE_LOCK_R)       \
+    X(GPIO_PORTE_CR_R)         \
+    X(GPIO_PORTE_ADCCTL_R)     \
+    X(GPIO_PORTE_DMACTL_R)     \
+    /* GPIO Port F */          \
+    X(GPIO_PORTF_DATA_R)       \
+    X(GPIO_PORTF_DIR_R)        \
+    X(GPIO_PORTF_AFSEL_R)      \
+    X(GPIO_PORTF_PUR_R)        \
+    X(GPIO_PORTF_DEN_R)        \
+    X(GPIO_PORTF_PCTL_R)       \
+    X(GPIO_PORTF_IS_R)         \
+    X(GPIO_PORTF_IBE_R)        \
+    X(GPIO_PORTF_IEV_R)        \
+    X(GPIO_PORTF_IM_R)         \
+    X(GPIO_PORTF_RIS_R)        \
+    X(GPIO_PORTF_MIS_R)        \
+    X(GPIO_PORTF_ICR_R)        \
+    X(GPIO_PORTF_DR2R_R)       \
+    X(GPIO_PORTF_DR4R_R)       \
+    X(GPIO_PORTF_DR8R_R)       \
+    X(GPIO_PORTF_ODR_R)        \
+    X(GPIO_PORTF_PDR_R)        \
+    X(GPIO_PORTF_SLR_R)        \
+    X(GPIO_PORTF_LOCK_R)       \
+    X(GPIO_PORTF_CR_R)         \
+    X(GPIO_PORTF_AMSEL_R)      \
+    X(GPIO_PORTF_ADCCTL_R)     \
+    X(GPIO_PORTF_DMACTL_R)     \
+    /* Timer0 - Timer5 */      \
+    X(TIMER0_CFG_R)            \
+    X(TIMER0_TAMR_R)           \
+    X(TIMER0_CTL_R)            \
+    X(TIMER0_TAILR_R)          \
+    X(TIMER1_CFG_R)            \
+    X(TIMER1_TAMR_R)           \
+    X(TIMER1_CTL_R)            \
+    X(TIMER1_RIS_R)            \
+    X(TIMER1_ICR_R)            \
+    X(TIMER1_TAILR_R)          \
+    X(TIMER0_TBMR_R)           \
+    X(TIMER0_IMR_R)            \
+    X(TIMER0_RIS_R)            \
+    X(TIMER0_MIS_R)            \
+    X(TIMER0_ICR_R)            \
+    X(TIMER0_TBILR_R)          \
+    X(TIMER0_TAMATCHR_R)       \
+    X(TIMER0_TBMATCHR_R)       \
+    X(TIMER0_TAPR_R)           \
+    X(TIMER0_TBPR_R)           \
+    X(TIMER0_TAR_R)            \
+    X(TIMER0_TBR_R)            \
+    X(TIMER0_TAV_R)            \
+    X(TIMER0_TBV_R)            \
+    X(TIMER1_TBMR_R)           \
+    X(TIMER1_IMR_R)            \
+    X(TIMER1_MIS_R)            \
+    X(TIMER1_TBILR_R)          \
+    X(TIMER1_TAMATCHR_R)       \
+    X(TIMER1_TBMATCHR_R)       \
+    X(TIMER1_TAPR_R)           \
+    X(TIMER1_TBPR_R)           \
+    X(TIMER1_TAR_R)            \
+    X(TIMER1_TBR_R)            \
+    X(TIMER1_TAV_R)            \
+    X(TIMER1_TBV_R)            \
+    X(TIMER2_CFG_R)            \
+    X(TIMER2_TAMR_R)           \
+    X(TIMER2_TBMR_R)           \
+    X(TIMER2_CTL_R)            \
+    X(TIMER2_IMR_R)            \
+    X(TIMER2_RIS_R)            \
+    X(TIMER2_MIS_R)            \
+    X(TIMER2_ICR_R)            \
+    X(TIMER2_TAILR_R)          \
+    X(TIMER2_TBILR_R)          \
+    X(TIMER2_TAMATCHR_R)       \
+    X(TIMER2_TBMATCHR_R)       \
+    X(TIMER2_TAPR_R)           \
+    X(TIMER2_TBPR_R)           \
+    X(TIMER2_TAR_R)            \
+    X(TIMER2_TBR_R)            \
+    X(TIMER2_TAV_R)            \
+    X(TIMER2_TBV_R)            \
+    X(TIMER3_CFG_R)            \
+    X(TIMER3_TAMR_R)           \
+    X(TIMER3_TBMR_R)           \
+    X(TIMER3_CTL_R)            \
+    X(TIMER3_IMR_R)            \
+    X(TIMER3_RIS_R)            \
+    X(TIMER3_MIS_R)            \
+    X(TIMER3_ICR_R)            \
+    X(TIMER3_TAILR_R)          \
+    X(TIMER3_TBILR_R)          \
+    X(TIMER3_TAMATCHR_R)       \
+    X(TIMER3_TBMATCHR_R)       \
+    X(TIMER3_TAPR_R)           \
+    X(TIMER3_TBPR_R)           \
+    X(TIMER3_TAR_R)            \
+    X(TIMER3_TBR_R)            \
+    X(TIMER3_TAV_R)            \
+    X(TIMER3_TBV_R)            \
+    X(TIMER4_CFG_R)            \
+    X(TIMER4_TAMR_R)           \
+    X(TIMER4_TBMR_R)           \
+    X(TIMER4_CTL_R)            \
+    X(TIMER4_IMR_R)            \
+    X(TIMER4_RIS_R)            \
+    X(TIMER4_MIS_R)            \
+    X(TIMER4_ICR_R)            \
+    X(TIMER4_TAILR_R)          \
+    X(TIMER4_TBILR_R)          \
+    X(TIMER4_TAMATCHR_R)       \
+    X(TIMER4_TBMATCHR_R)       \
+    X(TIMER4_TAPR_R)           \
+    X(TIMER4_TBPR_R)           \
+    X(TIMER4_TAR_R)            \
+    X(TIMER4_TBR_R)            \
+    X(TIMER4_TAV_R)            \
+    X(TIMER4_TBV_R)            \
+    X(TIMER5_CFG_R)            \
+    X(TIMER5_TAMR_R)           \
+    X(TIMER5_TBMR_R)           \
+    X(TIMER5_CTL_R)            \
+    X(TIMER5_IMR_R)            \
+    X(TIMER5_RIS_R)            \
+    X(TIMER5_MIS_R)            \
+    X(TIMER5_ICR_R)            \
+    X(TIMER5_TAILR_R)          \
+    X(TIMER5_TBILR_R)          \
+    X(TIMER5_TAMATCHR_R)       \
+    X(TIMER5_TBMATCHR_R)       \
+    X(TIMER5_TAPR_R)           \
+    X(TIMER5_TBPR_R)           \
+    X(TIMER5_TAR_R)            \
+    X(TIMER5_TBR_R)            \
+    X(TIMER5_TAV_R)            \
+    X(TIMER5_TBV_R)            \
+    /* ADC0 */                 \
+    X(ADC0_ACTSS_R)            \
+    X(ADC0_RIS_R)              \
+    X(ADC0_IM_R)               \
+    X(ADC0_ISC_R)              \
+    X(ADC0_OSTAT_R)            \
+    X(ADC0_EMUX_R)             \
+    X(ADC0_PSSI_R)             \
+    X(ADC0_SSMUX0_R)           \
+    X(ADC0_SSCTL0_R)           \
+    X(ADC0_SSFIFO0_R)          \
+    X(ADC0_SSMUX1_R)           \
+    X(ADC0_SSCTL1_R)           \
+    X(ADC0_SSFIFO1_R)          \
+    X(ADC0_SSMUX2_R)           \
+    X(ADC0_SSCTL2_R)           \
+    X(ADC0_SSFIFO2_R)          \
+    X(ADC0_SSMUX3_R)           \
+    X(ADC0_SSCTL3_R)           \
+    X(ADC0_SSFIFO3_R)          \
+    X(ADC0_TSSEL_R)            \
+    /* UART0 - UART7 */        \
+    X(UART0_DR_R)              \
+    X(UART0_FR_R)              \
+    X(UART0_IBRD_R)            \
+    X(UART0_FBRD_R)            \
+    X(UART0_LCRH_R)            \
+    X(UART0_CTL_R)             \
+    X(UART0_IFLS_R)            \
+    X(UART0_IM_R)              \
+    X(UART0_ICR_R)             \
+    X(UART0_CC_R)              \
+    X(UART1_DR_R)              \
+    X(UART1_FR_R)              \
+    X(UART1_IBRD_R)            \
+    X(UART1_FBRD_R)            \
+    X(UART1_LCRH_R)            \
+    X(UART1_CTL_R)             \
+    X(UART1_CC_R)              \
+    X(UART0_RSR_R)             \
+    X(UART0_ECR_R)             \
+    X(UART0_ILPR_R)            \
+    X(UART0_RIS_R)             \
+    X(UART0_MIS_R)             \
+    X(UART0_DMACTL_R)          \
+    X(UART0_9BITADDR_R)        \
+    X(UART0_9BITAMASK_R)       \
+    X(UART1_RSR_R)             \
+    X(UART1_ECR_R)             \
+    X(UART1_ILPR_R)            \
+    X(UART1_IFLS_R)            \
+    X(UART1_IM_R)              \
+    X(UART1_RIS_R)             \
+    X(UART1_MIS_R)             \
+    X(UART1_ICR_R)             \
+    X(UART1_DMACTL_R)          \
+    X(UART1_9BITADDR_R)        \
+    X(UART1_9BITAMASK_R)       \
+    X(UART2_DR_R)              \
+    X(UART2_RSR_R)             \
+    X(UART2_ECR_R)             \
+    X(UART2_FR_R)              \
+    X(UART2_ILPR_R)            \
+    X(UART2_IBRD_R)            \
+    X(UART2_FBRD_R)            \
+    X(UART2_LCRH_R)            \
+    X(UART2_CTL_R)             \
+    X(UART2_IFLS_R)            \
+    X(UART2_IM_R)              \
+    X(UART2_RIS_R)             \
+    X(UART2_MIS_R)             \
+    X(UART2_ICR_R)             \
+    X(UART2_DMACTL_R)          \
+    X(UART2_9BITADDR_R)        \
+    X(UART2_9BITAMASK_R)       \
+    X(UART2_CC_R)              \
+    X(UART3_DR_R)              \
+    X(UART3_RSR_R)             \
+    X(UART3_ECR_R)             \
+    X(UART3_FR_R)              \
+    X(UART3_ILPR_R)            \
+    X(UART3_IBRD_R)            \
+    X(UART3_FBRD_R)            \
+    X(UART3_LCRH_R)            \
+    X(UART3_CTL_R)             \
+    X(UART3_IFLS_R)            \
+    X(UART3_IM_R)              \
+    X(UART3_RIS_R)             \
+    X(UART3_MIS_R)             \
+    X(UART3_ICR_R)             \
+    X(UART3_DMACTL_R)          \
+    X(UART3_9BITADDR_R)        \
+    X(UART3_9BITAMASK_R)       \
+    X(UART3_CC_R)              \
+    X(UART4_DR_R)              \
+    X(UART4_RSR_R)             \
+    X(UART4_ECR_R)             \
+    X(UART4_FR_R)              \
+    X(UART4_ILPR_R)            \
+    X(UART4_IBRD_R)            \
+    X(UART4_FBRD_R)            \
+    X(UART4_LCRH_R)            \
+    X(UART4_CTL_R)             \
+    X(UART4_IFLS_R)            \
+    X(UART4_IM_R)              \
+    X(UART4_RIS_R)             \
+    X(UART4_MIS_R)             \
+    X(UART4_ICR_R)             \
+    X(UART4_DMACTL_R)          \
+    X(UART4_9BITADDR_R)        \
+    X(UART4_9BITAMASK_R)       \
+    X(UART4_CC_R)              \
+    X(UART5_DR_R)              \
+    X(UART5_RSR_R)             \
+    X(UART5_ECR_R)             \
+    X(UART5_FR_R)              \
+    X(UART5_ILPR_R)            \
+    X(UART5_IBRD_R)            \
+    X(UART5_FBRD_R)            \
+    X(UART5_LCRH_R)            \
+    X(UART5_CTL_R)             \
+    X(UART5_IFLS_R)            \
+    X(UART5_IM_R)              \
+    X(UART5_RIS_R)             \
+    X(UART5_MIS_R)             \
+    X(UART5_ICR_R)             \
+    X(UART5_DMACTL_R)          \
+    X(UART5_9BITADDR_R)        \
+    X(UART5_9BITAMASK_R)       \
+    X(UART5_CC_R)              \
+    X(UART6_DR_R)              \
+    X(UART6_RSR_R)             \
+    X(UART6_ECR_R)             \
+    X(UART6_FR_R)              \
+    X(UART6_ILPR_R)            \
+    X(UART6_IBRD_R)            \
+    X(UART6_FBRD_R)            \
+    X(UART6_LCRH_R)            \
+    X(UART6_CTL_R)             \
+    X(UART6_IFLS_R)            \
+    X(UART6_IM_R)              \
+    X(UART6_RIS_R)             \
+    X(UART6_MIS_R)             \
+    X(UART6_ICR_R)             \
+    X(UART6_DMACTL_R)          \
+    X(UART6_9BITADDR_R)        \
+    X(UART6_9BITAMASK_R)       \
+    X(UART6_CC_R)              \
+    X(UART7_DR_R)              \
+    X(UART7_RSR_R)             \
+    X(UART7_ECR_R)             \
+    X(UART7_FR_R)              \
+    X(UART7_ILPR_R)            \
+    X(UART7_IBRD_R)            \
+    X(UART7_FBRD_R)            \
+    X(UART7_LCRH_R)            \
+    X(UART7_CTL_R)             \
+    X(UART7_IFLS_R)            \
+    X(UART7_IM_R)              \
+    X(UART7_RIS_R)             \
+    X(UART7_MIS_R)             \
+    X(UART7_ICR_R)             \
+    X(UART7_DMACTL_R)          \
+    X(UART7_9BITADDR_R)        \
+    X(UART7_9BITAMASK_R)       \
+    X(UART7_CC_R)              \
+    /* SSI0 - SSI3 */          \
+    X(SSI0_CR0_R)              \
+    X(SSI0_CR1_R)              \
+    X(SSI0_DR_R)               \
+    X(SSI0_SR_R)               \
+    X(SSI0_CPSR_R)             \
+    X(SSI0_IM_R)               \
+    X(SSI0_RIS_R)              \
+    X(SSI0_MIS_R)              \
+    X(SSI0_ICR_R)              \
+    X(SSI0_DMACTL_R)           \
+    X(SSI0_CC_R)               \
+    X(SSI1_CR0_R)              \
+    X(SSI1_CR1_R)              \
+    X(SSI1_DR_R)               \
+    X(SSI1_SR_R)               \
+    X(SSI1_CPSR_R)             \
+    X(SSI1_IM_R)               \
+    X(SSI1_RIS_R)              \
+    X(SSI1_MIS_R)              \
+    X(SSI1_ICR_R)              \
+    X(SSI1_DMACTL_R)           \
+    X(SSI1_CC_R)               \
+    X(SSI2_CR0_R)              \
+    X(SSI2_CR1_R)              \
+    X(SSI2_DR_R)               \
+    X(SSI2_SR_R)               \
+    X(SSI2_CPSR_R)             \
+    X(SSI2_IM_R)               \
+    X(SSI2_RIS_R)              \
+    X(SSI2_MIS_R)              \
+    X(SSI2_ICR_R)              \
+    X(SSI2_DMACTL_R)           \
+    X(SSI2_CC_R)               \
+    X(SSI3_CR0_R)              \
+    X(SSI3_CR1_R)              \
+    X(SSI3_DR_R)               \
+    X(SSI3_SR_R)               \
+    X(SSI3_CPSR_R)             \
+    X(SSI3_IM_R)               \
+    X(SSI3_RIS_R)              \
+    X(SSI3_MIS_R)              \
+    X(SSI3_ICR_R)              \
+    X(SSI3_DMACTL_R)           \
+    X(SSI3_CC_R)               \
+    /* uDMA */                 \
+    X(UDMA_STAT_R)             \
+    X(UDMA_CFG_R)              \
+    X(UDMA_CTLBASE_R)          \
+    X(UDMA_ALTBASE_R)          \
+    X(UDMA_WAITSTAT_R)         \
+    X(UDMA_SWREQ_R)            \
+    X(UDMA_USEBURSTSET_R)      \
+    X(UDMA_USEBURSTCLR_R)      \
+    X(UDMA_REQMASKSET_R)       \
+    X(UDMA_REQMASKCLR_R)       \
+    X(UDMA_ENASET_R)           \
+    X(UDMA_ENACLR_R)           \
+    X(UDMA_ALTSET_R)           \
+    X(UDMA_ALTCLR_R)           \
+    X(UDMA_PRIOSET_R)          \
+    X(UDMA_PRIOCLR_R)          \
+    X(UDMA_ERRCLR_R)           \
+    X(UDMA_CHASGN_R)           \
+    X(UDMA_CHIS_R)             \
+    X(UDMA_CHMAP0_R)           \
+    X(UDMA_CHMAP1_R)           \
+    X(UDMA_CHMAP2_R)           \
+    X(UDMA_CHMAP3_R)           \
+    /* WTimer0 - WTimer5 */    \
+    X(WTIMER0_CFG_R)           \
+    X(WTIMER0_TAMR_R)          \
+    X(WTIMER0_TBMR_R)          \
+    X(WTIMER0_CTL_R)           \
+    X(WTIMER0_IMR_R)           \
+    X(WTIMER0_RIS_R)           \
+    X(WTIMER0_MIS_R)           \
+    X(WTIMER0_ICR_R)           \
+    X(WTIMER0_TAILR_R)         \
+    X(WTIMER0_TBILR_R)         \
+    X(WTIMER0_TAMATCHR_R)      \
+    X(WTIMER0_TBMATCHR_R)      \
+    X(WTIMER0_TAPR_R)          \
+    X(WTIMER0_TBPR_R)          \
+    X(WTIMER0_TAPMR_R)         \
+    X(WTIMER0_TAR_R)           \
+    X(WTIMER0_TBR_R)           \
+    X(WTIMER0_TAV_R)           \
+    X(WTIMER0_TBV_R)           \
+    X(WTIMER1_CFG_R)           \
+    X(WTIMER1_TAMR_R)          \
+    X(WTIMER1_TBMR_R)          \
+    X(WTIMER1_CTL_R)           \
+    X(WTIMER1_IMR_R)           \
+    X(WTIMER1_RIS_R)           \
+    X(WTIMER1_MIS_R)           \
+    X(WTIMER1_ICR_R)           \
+    X(WTIMER1_TAILR_R)         \
+    X(WTIMER1_TBILR_R)         \
+    X(WTIMER1_TAMATCHR_R)      \
+    X(WTIMER1_TBMATCHR_R)      \
+    X(WTIMER1_TAPR_R)          \
+    X(WTIMER1_TBPR_R)          \
+    X(WTIMER1_TAR_R)           \
+    X(WTIMER1_TBR_R)           \
+    X(WTIMER1_TAV_R)           \
+    X(WTIMER1_TBV_R)           \
+    X(WTIMER2_CFG_R)           \
+    X(WTIMER2_TAMR_R)          \
+    X(WTIMER2_TBMR_R)          \
+    X(WTIMER2_CTL_R)           \
+    X(WTIMER2_IMR_R)           \
+    X(WTIMER2_RIS_R)           \
+    X(WTIMER2_MIS_R)           \
+    X(WTIMER2_ICR_R)           \
+    X(WTIMER2_TAILR_R)         \
+    X(WTIMER2_TBILR_R)         \
+    X(WTIMER2_TAMATCHR_R)      \
+    X(WTIMER2_TBMATCHR_R)      \
+    X(WTIMER2_TAPR_R)          \
+    X(WTIMER2_TBPR_R)          \
+    X(WTIMER2_TAR_R)           \
+    X(WTIMER2_TBR_R)           \
+    X(WTIMER2_TAV_R)           \
+    X(WTIMER2_TBV_R)           \
+    X(WTIMER3_CFG_R)           \
+    X(WTIMER3_TAMR_R)          \
+    X(WTIMER3_TBMR_R)          \
+    X(WTIMER3_CTL_R)           \
+    X(WTIMER3_IMR_R)           \
+    X(WTIMER3_RIS_R)           \
+    X(WTIMER3_MIS_R)           \
+    X(WTIMER3_ICR_R)           \
+    X(WTIMER3_TAILR_R)         \
+    X(WTIMER3_TBILR_R)         \
+    X(WTIMER3_TAMATCHR_R)      \
+    X(WTIMER3_TBMATCHR_R)      \
+    X(WTIMER3_TAPR_R)          \
+    X(WTIMER3_TBPR_R)          \
+    X(WTIMER3_TAR_R)           \
+    X(WTIMER3_TBR_R)           \
+    X(WTIMER3_TAV_R)           \
+    X(WTIMER3_TBV_R)           \
+    X(WTIMER4_CFG_R)           \
+    X(WTIMER4_TAMR_R)          \
+    X(WTIMER4_TBMR_R)          \
+    X(WTIMER4_CTL_R)           \
+    X(WTIMER4_IMR_R)           \
+    X(WTIMER4_RIS_R)           \
+    X(WTIMER4_MIS_R)           \
+    X(WTIMER4_ICR_R)           \
+    X(WTIMER4_TAILR_R)         \
+    X(WTIMER4_TBILR_R)         \
+    X(WTIMER4_TAMATCHR_R)      \
+    X(WTIMER4_TBMATCHR_R)      \
+    X(WTIMER4_TAPR_R)          \
+    X(WTIMER4_TBPR_R)          \
+    X(WTIMER4_TAR_R)           \
+    X(WTIMER4_TBR_R)           \
+    X(WTIMER4_TAV_R)           \
+    X(WTIMER4_TBV_R)           \
+    X(WTIMER5_CFG_R)           \
+    X(WTIMER5_TAMR_R)          \
+    X(WTIMER5_TBMR_R)          \
+    X(WTIMER5_CTL_R)           \
+    X(WTIMER5_IMR_R)           \
+    X(WTIMER5_RIS_R)           \
+    X(WTIMER5_MIS_R)           \
+    X(WTIMER5_ICR_R)           \
+    X(WTIMER5_TAILR_R)         \
+    X(WTIMER5_TBILR_R)         \
+    X(WTIMER5_TAMATCHR_R)      \
+    X(WTIMER5_TBMATCHR_R)      \
+    X(WTIMER5_TAPR_R)          \
+    X(WTIMER5_TBPR_R)          \
+    X(WTIMER5_TAR_R)           \
+    X(WTIMER5_TBR_R)           \
+    X(WTIMER5_TAV_R)           \
+    X(WTIMER5_TBV_R)           \
+    /* EEPROM */               \
+    X(EEPROM_EESIZE_R)         \
+    X(EEPROM_EEBLOCK_R)        \
+    X(EEPROM_EEOFFSET_R)       \
+    X(EEPROM_EERDWR_R)         \
+    X(EEPROM_EERDWRINC_R)      \
+    X(EEPROM_EEDONE_R)         \
+    X(EEPROM_EESUPP_R)         \
+    X(EEPROM_EEUNLOCK_R)       \
+    X(EEPROM_EEPROT_R)         \
+    X(EEPROM_EEPASS0_R)        \
+    X(EEPROM_EEINT_R)          \
+    X(EEPROM_EEHIDE_R)         \
+    X(EEPROM_EEDBGME_R)        \
+    X(EEPROM_PP_R)             \
+    /* PWM0 */                 \
+    X(PWM0_CTL_R)              \
+    X(PWM0_SYNC_R)             \
+    X(PWM0_ENABLE_R)           \
+    X(PWM0_0_CTL_R)            \
+    X(PWM0_0_INTEN_R)          \
+    X(PWM0_0_LOAD_R)           \
+    X(PWM0_0_CMPA_R)           \
+    X(PWM0_0_GENA_R)           \
+    X(PWM0_0_DBCTL_R)          \
+    X(PWM0_0_DBRISE_R)         \
+    X(PWM0_0_DBFALL_R)         \
+    X(PWM0_1_CTL_R)            \
+    X(PWM0_1_LOAD_R)           \
+    X(PWM0_1_CMPA_R)           \
+    X(PWM0_1_GENA_R)           \
+    X(PWM0_1_DBCTL_R)          \
+    X(PWM0_1_DBRISE_R)         \
+    X(PWM0_1_DBFALL_R)         \
+    X(PWM0_2_CTL_R)            \
+    X(PWM0_2_LOAD_R)           \
+    X(PWM0_2_CMPA_R)           \
+    X(PWM0_2_GENA_R)           \
+    X(PWM0_2_DBCTL_R)          \
+    X(PWM0_2_DBRISE_R)         \
+    X(PWM0_2_DBFALL_R)         \
+    /* PWM1 */                 \
+    X(PWM1_ENABLE_R)           \
+    X(PWM1_2_CTL_R)            \
+    X(PWM1_2_LOAD_R)           \
+    X(PWM1_2_CMPB_R)           \
+    X(PWM1_2_GENB_R)           \
+    X(PWM1_3_CTL_R)            \
+    X(PWM1_3_LOAD_R)           \
+    X(PWM1_3_CMPA_R)           \
+    X(PWM1_3_GENB_R)           \
+    X(PWM1_3_CMPB_R)           \
+    X(PWM1_3_GENA_R)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TM4C_SHIM_DECLARE(name) extern volatile uint32_t name;
+TM4C_SHIM_REGISTERS(TM4C_SHIM_DECLARE)
+#undef TM4C_SHIM_DECLARE
+
+/*
+ * GPIO masked data windows (DATA_BITS[mask]), also for the AHB
+ * aperture of port B. These are separate RAM arrays: a write
+ * here does NOT show up in GPIO_PORTx_DATA_R.
+ */
+#define TM4C_SHIM_GPIO_PORTS(X) X(A) X(B) X(C) X(D) X(E) X(F) X(B_AHB)
+#define TM4C_SHIM_DECLARE_BITS(port) extern volatile uint32_t GPIO_PORT##port##_DATA_BITS_R[256];
+TM4C_SHIM_GPIO_PORTS(TM4C_SHIM_DECLARE_BITS)
+#undef TM4C_SHIM_DECLARE_BITS
+
+/* Clears every shim register (call before each test) */
+void tm4c_shim_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * Core intrinsics used by the interrupt-driven demos. Keil provides
+ * them as compiler built-ins; under the shim they do nothing.
+ */
+static inline void __enable_irq(void) {}
+static inline void __disable_irq(void) {}
+static inline void __WFI(void) {}
+
+#endif
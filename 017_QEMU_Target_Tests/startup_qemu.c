@@ -0,0 +1,65 @@
+/***************************************************************
+ * FILE NAME : startup_qemu.c
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Minimal Cortex-M4 startup for the QEMU "mps2-an386" board.
+ *
+ *   - Vector table with the initial stack pointer and the core
+ *     exception handlers (no device interrupts are needed: all
+ *     TM4C peripherals are replaced by the RAM test shim).
+ *   - Reset_Handler copies .data, clears .bss, enables the FPU
+ *     (the drivers are compiled for the M4F hard-float ABI like
+ *     the real TM4C123GH6PM) and calls main().
+ *   - Any fault ends the run through semihosting with FAIL.
+ ***************************************************************/
+
+#include <stdint.h>
+
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss, _estack;
+
+int main(void);
+void semihost_exit(int status);
+
+void Reset_Handler(void);
+void Fault_Handler(void);
+
+__attribute__((section(".isr_vector"), used))
+void (*const vector_table[16])(void) = {
+    (void (*)(void))&_estack, // Initial stack pointer
+    Reset_Handler,            // Reset
+    Fault_Handler,            // NMI
+    Fault_Handler,            // HardFault
+    Fault_Handler,            // MemManage
+    Fault_Handler,            // BusFault
+    Fault_Handler,            // UsageFault
+    0, 0, 0, 0,               // Reserved
+    Fault_Handler,            // SVCall
+    Fault_Handler,            // Debug monitor
+    0,                        // Reserved
+    Fault_Handler,            // PendSV
+    Fault_Handler,            // SysTick (not enabled)
+};
+
+void Reset_Handler(void)
+{
+    uint32_t *src = &_sidata;
+    uint32_t *dst;
+
+    for (dst = &_sdata; dst < &_edata;)
+        *dst++ = *src++;
+
+    for (dst = &_sbss; dst < &_ebss;)
+        *dst++ = 0;
+
+    // CPACR: full access to CP10 and CP11 (FPU)
+    *(volatile uint32_t *)0xE000ED88 |= (0xF << 20);
+    __asm volatile("dsb\n isb");
+
+    semihost_exit(main());
+}
+
+void Fault_Handler(void)
+{
+    semihost_exit(1);
+}
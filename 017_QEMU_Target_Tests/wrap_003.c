@@ -0,0 +1,11 @@
+/*
+ * Builds 003_7_Segment_LED_Display against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main seg7_main
+#define delayMs seg7_delayMs
+#define shift_out1 seg7_shift_out1
+#define a seg7_table
+#define T seg7_T
+#include "../003_7_Segment_LED_Display/main.c"
@@ -0,0 +1,9 @@
+/*
+ * Builds 004_LCD against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main lcd_main
+#define delayMs lcd_delayMs
+#define shift_out1 lcd_shift_out1
+#include "../004_LCD/main.c"
@@ -0,0 +1,145 @@
+/*
+ * Builds 007_02 (uDMA GPIO pattern generator) against the test
+ * shim. Symbols shared with other demos are renamed so several
+ * demos can be linked into one test image.
+ */
+#define main pg_main
+#define PLL_Init80MHz pg_PLL_Init80MHz
+#define UART0Tx pg_UART0Tx
+#define UART0_SendString pg_UART0_SendString
+#define UART0_SendNumber pg_UART0_SendNumber
+#define dma_table pg_dma_table
+#define TIMER0A_Handler pg_TIMER0A_Handler
+#define command pg_command
+#include "../007_Timers/007_02_uDMA_GPIO_Pattern_Generator/main.c"
+
+/*
+ * Minimal model of uDMA channel 18 in peripheral scatter-gather
+ * mode, one request per call of pg_tick(). It follows the control
+ * words exactly as the hardware reads them (end pointers, sizes,
+ * increments, XFERSIZE, mode), so a wrong field in pg_build()
+ * shows up as a wrong pin sequence. Worst case timing: a task
+ * copy by the primary structure uses a request of its own.
+ * The control words hold 32-bit addresses; on a 64-bit host they
+ * are mapped back through the table of known buffers below.
+ */
+static struct
+{
+    uint8_t *base;
+    uint32_t size;
+} pg_regions[8];
+static uint32_t pg_nregions, pg_alt, pg_out;
+
+static void pg_region(void *base, uint32_t size)
+{
+    pg_regions[pg_nregions].base = (uint8_t *)base;
+    pg_regions[pg_nregions].size = size;
+    pg_nregions++;
+}
+
+static uint8_t *pg_addr(uint32_t a)
+{
+    uint32_t i, b;
+
+    for (i = 0; i < pg_nregions; i++)
+    {
+        b = (uint32_t)(uintptr_t)pg_regions[i].base;
+        if (a >= b && a - b < pg_regions[i].size)
+            return pg_regions[i].base + (a - b);
+    }
+    return 0;
+}
+
+/* One request: returns 0 once the channel has stopped */
+static int pg_tick(void)
+{
+    dma_entry_t *e = &dma_table[DMA_CH_TIMER0A + (pg_alt ? 32 : 0)];
+    uint32_t ctl = e->ctl, mode = ctl & 7, n = ((ctl >> 4) & 0x3FF) + 1;
+    uint32_t size = 1u << ((ctl >> 24) & 3);
+    uint32_t sinc = ((ctl >> 26) & 3) == 3 ? 0 : 1u << ((ctl >> 26) & 3);
+    uint32_t dinc = ((ctl >> 30) & 3) == 3 ? 0 : 1u << ((ctl >> 30) & 3);
+    uint32_t arb = 1u << ((ctl >> 14) & 0xF), k, v, mask;
+    uint8_t *src, *dst;
+
+    if (mode == 0)
+        return 0;
+
+    for (k = 0; k < arb && n; k++, n--)
+    {
+        src = pg_addr(e->src_end - (n - 1) * sinc);
+        // S-G primary: every task lands on the same 4 alternate words
+        dst = pg_addr(e->dst_end - (mode == 6 ? (n - 1) & 3 : n - 1) * dinc);
+        if (!src || !dst)
+            return 0;
+        v = size == 4 ? *(uint32_t *)src : *src;
+
+        if (dst >= (uint8_t *)GPIO_PORTB_AHB_DATA_BITS_R &&
+            dst < (uint8_t *)&GPIO_PORTB_AHB_DATA_BITS_R[256])
+        {
+            mask = (uint32_t)(dst - (uint8_t *)GPIO_PORTB_AHB_DATA_BITS_R) / 4;
+            pg_out = (pg_out & ~mask) | (v & mask);
+        }
+        else if (size == 4)
+        {
+            *(uint32_t *)dst = v;
+        }
+        else
+        {
+            *dst = (uint8_t)v;
+        }
+    }
+
+    // Remaining count back into the structure, mode 0 when done
+    e->ctl = (ctl & ~(0x3FFu << 4 | 7u)) | ((n ? n - 1 : 0) << 4) | (n ? mode : 0);
+
+    if (mode == 6)
+        pg_alt = 1; // Task copied: run it
+    else if (mode == 7 && n == 0)
+        pg_alt = 0; // Task done: next copy
+    return 1;
+}
+
+/*
+ * pg_run() – build the segments into the task list, then record
+ * the PB0-PB7 level after each of up to `ticks` requests.
+ * Returns the number of requests until the channel stopped.
+ */
+uint32_t pg_run(const uint8_t *const *data, const uint16_t *len,
+                const uint8_t *mask, uint32_t n, int loop,
+                uint8_t *out, uint32_t ticks)
+{
+    pg_segment_t seg[PG_MAX_TASKS] = {{0}};
+    uint32_t i;
+
+    if (n > PG_MAX_TASKS)
+        return 0;
+    for (i = 0; i < n; i++)
+    {
+        seg[i].data = data[i];
+        seg[i].len = len[i];
+        seg[i].mask = mask[i];
+    }
+    if (pg_build(seg, n, loop) == 0)
+        return 0;
+
+    pg_nregions = 0;
+    pg_region(dma_table, sizeof(dma_table));
+    pg_region(pg_tasks, sizeof(pg_tasks));
+    pg_region(&pg_reload, sizeof(pg_reload));
+    pg_region((void *)GPIO_PORTB_AHB_DATA_BITS_R, 256 * 4);
+    for (i = 0; i < n; i++)
+        pg_region((void *)data[i], len[i]);
+
+    pg_alt = 0;
+    pg_out = 0;
+    for (i = 0; i < ticks && pg_tick(); i++)
+        out[i] = (uint8_t)pg_out;
+    return i;
+}
+
+/* pg_test_rate() – TAILR that pg_rate(hz) selects */
+uint32_t pg_test_rate(uint32_t hz)
+{
+    pg_rate(hz);
+    return pg_tailr;
+}
@@ -0,0 +1,148 @@
+/*
+ * Builds 007_03 (logic analyzer capture) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main la_main
+#define PLL_Init80MHz la_PLL_Init80MHz
+#define UART0Tx la_UART0Tx
+#define UART0_SendString la_UART0_SendString
+#define UART0_SendNumber la_UART0_SendNumber
+#define UART0_Init la_UART0_Init
+#define dma_table la_dma_table
+#define TIMER0A_Handler la_TIMER0A_Handler
+#define command la_command
+#define parse_number la_parse_number
+#include "../007_Timers/007_03_Logic_Analyzer_Capture/main.c"
+
+/*
+ * la_feed() – one half as uDMA would deliver it: copy the samples
+ * into the buffer the handler reads next, then run the handler.
+ */
+void la_feed(const uint8_t *s)
+{
+    uint32_t i;
+
+    for (i = 0; i < LA_HALF; i++)
+        la_buf[la_halves & 1][i] = s[i];
+    la_TIMER0A_Handler();
+}
+
+/*
+ * la_drain() – what the UART would have sent: copy the ring from
+ * tail to head into out (at most max bytes) and empty the ring.
+ */
+uint32_t la_drain(uint8_t *out, uint32_t max)
+{
+    uint32_t n = 0;
+
+    while (la_tx_tail != la_tx_head && n < max)
+        out[n++] = la_tx[la_tx_tail++ & (LA_TX_SIZE - 1)];
+    la_tx_tail = la_tx_head;
+    la_tx_chunk = 0;
+    return n;
+}
+
+/* la_finish() – la_stop() without waiting for the UART */
+void la_finish(void)
+{
+    la_running = 0;
+    if (la_lost_pending)
+        la_gap();
+    if (la_run)
+        la_record(la_value, la_run);
+    la_put((uint8_t)la_value);
+    la_put(0);
+    la_put(0);
+}
+
+static uint32_t la_get_varint(const uint8_t *b, uint32_t *i)
+{
+    uint32_t v = 0, shift = 0;
+
+    do
+        v |= (uint32_t)(b[*i] & 0x7F) << shift, shift += 7;
+    while (b[(*i)++] & 0x80);
+    return v;
+}
+
+/*
+ * la_decode() – the stream back into samples, as host/la2vcd.c
+ * reads it; lost samples are written as 0xEE. Returns the number
+ * of samples, or 0 if the header or the end marker is wrong.
+ */
+uint32_t la_decode(const uint8_t *b, uint32_t n, uint8_t *out,
+                   uint32_t max, uint32_t *lost)
+{
+    uint32_t i = 10, count = 0, run, k;
+    uint8_t value;
+
+    *lost = 0;
+    if (n < 10 || b[0] != 'L' || b[3] != 'A' || b[4] != 1 || b[5] != 8)
+        return 0;
+
+    while (i < n)
+    {
+        value = b[i++];
+        run = la_get_varint(b, &i);
+        if (run == 0)
+        {
+            run = la_get_varint(b, &i);
+            if (run == 0)
+                return i == n ? count : 0; // End marker
+            *lost += run;
+            value = 0xEE;
+        }
+        for (k = 0; k < run && count < max; k++)
+            out[count++] = value;
+    }
+    return 0;
+}
+
+/*
+ * la_trace_595() – n samples of the 74HC595 bus from 004_LCD as
+ * the analyzer sees it: PB0 data, PB1 clock, PB2 latch, every
+ * level held for `hold` samples, an idle gap between bytes.
+ */
+void la_trace_595(uint8_t *s, uint32_t n, uint32_t hold)
+{
+    uint32_t i = 0, k, b = 0;
+    uint8_t byte = 0x3C, d;
+
+    while (i < n)
+    {
+        for (b = 0; b < 8 && i < n; b++)
+        {
+            d = (byte >> (7 - b)) & 1;
+            for (k = 0; k < hold && i < n; k++)
+                s[i++] = d;
+            for (k = 0; k < hold && i < n; k++)
+                s[i++] = d | 0x02;
+        }
+        for (k = 0; k < hold && i < n; k++)
+            s[i++] = 0x04;
+        for (k = 0; k < 4 * hold && i < n; k++)
+            s[i++] = 0x00;
+        byte = (uint8_t)(byte * 5 + 1);
+    }
+}
+
+/*
+ * la_bench_half() – compress one worst-case half: the pins change
+ * on every sample (0xAA / 0x55), two stream bytes per sample
+ */
+void la_bench_half(void)
+{
+    static uint8_t s[LA_HALF], ready;
+    uint32_t i;
+
+    if (!ready)
+    {
+        for (i = 0; i < LA_HALF; i++)
+            s[i] = (uint8_t)(i & 1 ? 0x55 : 0xAA);
+        ready = 1;
+    }
+    la_tx_head = la_tx_tail = 0;
+    la_run = 0;
+    la_compress(s, LA_HALF);
+}
@@ -0,0 +1,111 @@
+/*
+ * Builds 007_04 (frequency counter) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main fc_main
+#define PLL_Init80MHz fc_PLL_Init80MHz
+#define UART0Tx fc_UART0Tx
+#define UART0_SendString fc_UART0_SendString
+#define UART0_SendNumber fc_UART0_SendNumber
+#define dma_table fc_dma_table
+#define command fc_command
+#define parse_number fc_parse_number
+#include "../007_Timers/007_04_Frequency_Counter_Edge_Count/main.c"
+
+/*
+ * fc_count_error() – count method on a signal of hz, as uDMA
+ * would stamp it: the edge counter starts at `start` (so it can
+ * wrap), one stamp per gate of gate_us, `gates` gates handled in
+ * FC_HALF blocks. Returns |measured - hz| in millihertz and the
+ * reading's resolution and error; *readings counts the gates.
+ */
+uint32_t fc_count_error(uint32_t hz, uint32_t gate_us, uint32_t gates,
+                        uint32_t start, uint32_t *res, uint32_t *err,
+                        uint32_t *readings)
+{
+    uint32_t k, i;
+    uint64_t edges;
+    fc_reading_t r;
+
+    fc_gate_ticks = gate_us * (SYSCLK / 1000000);
+    fc_acc_edges = fc_acc_ticks = fc_readings = 0;
+    fc_prev = start;
+
+    for (k = 0; k < gates; k += FC_HALF)
+    {
+        for (i = 0; i < FC_HALF; i++)
+        {
+            edges = (uint64_t)hz * gate_us * (k + i + 1) / 1000000;
+            fc_stamp[0][i] = start + (uint32_t)edges;
+        }
+        fc_gate_block(fc_stamp[0], FC_HALF);
+    }
+
+    fc_from_count(fc_acc_edges, fc_acc_ticks, &r);
+    *res = r.res_mhz;
+    *err = r.err_mhz;
+    *readings = fc_readings;
+    return (uint32_t)(r.mhz > hz * 1000ull ? r.mhz - hz * 1000ull
+                                           : hz * 1000ull - r.mhz);
+}
+
+/* fc_period_mhz() – period method for `periods` over `ticks` */
+uint64_t fc_period_mhz(uint32_t periods, uint64_t ticks, uint32_t *res,
+                       uint32_t *err)
+{
+    fc_reading_t r;
+
+    fc_from_period(periods, ticks, &r);
+    *res = r.res_mhz;
+    *err = r.err_mhz;
+    return r.mhz;
+}
+
+/*
+ * fc_test_gate() – per-gate reading `back` gates before the latest
+ * one, as fc_gate_reading() gives it; 0 if not available
+ */
+uint64_t fc_test_gate(uint32_t back, uint32_t *res)
+{
+    fc_reading_t r;
+
+    if (!fc_gate_reading(fc_readings - 1 - back, &r))
+        return 0;
+    *res = r.res_mhz;
+    return r.mhz;
+}
+
+/* fc_test_listed() – how many readings the "d" command prints now */
+uint32_t fc_test_listed(void)
+{
+    uint32_t k = fc_readings, i, n = 0;
+    fc_reading_t r;
+
+    for (i = 16; i > 0; i--)
+        n += fc_gate_reading(k - i, &r);
+    return n;
+}
+
+/*
+ * fc_edges() – two rising edges dt ticks apart, captured in
+ * WTIMER0_TBR_R from t0 on. Returns the summed period ticks,
+ * *n the number of periods.
+ */
+uint32_t fc_edges(uint32_t t0, uint32_t dt, uint32_t *n)
+{
+    fc_have_edge = 0;
+    fc_per_n = fc_per_ticks = 0;
+    WTIMER0_TBR_R = t0;
+    WTIMER0B_Handler();
+    WTIMER0_TBR_R = t0 + dt;
+    WTIMER0B_Handler();
+    *n = fc_per_n;
+    return (uint32_t)fc_per_ticks;
+}
+
+/* fc_bench_block() – one TIMER1A_Handler block of FC_HALF gates */
+void fc_bench_block(void)
+{
+    fc_gate_block(fc_stamp[0], FC_HALF);
+}
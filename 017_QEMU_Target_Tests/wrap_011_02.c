@@ -0,0 +1,8 @@
+/*
+ * Builds 011_02 (analog resistive keypad) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main keypad_main
+#define delayMs keypad_delayMs
+#include "../011_ADC/011_02_Program_to_Interface_Analog_Resistive_Key-Pad/main.c"
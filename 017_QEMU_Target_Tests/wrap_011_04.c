@@ -0,0 +1,38 @@
+/*
+ * Builds 011_04 (oscilloscope capture) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main scope_main
+#define PLL_Init80MHz scope_PLL_Init80MHz
+#define UART0_Init scope_UART0_Init
+#define dma_table scope_dma_table
+#define ADC0SS3_Handler scope_ADC0SS3_Handler
+#define UART0_Handler scope_UART0_Handler
+#define parse_number scope_parse_number
+#include "../011_ADC/011_04_Oscilloscope_Capture/main.c"
+
+/* scope_test_trigger() – trigger settings, edge state cleared */
+void scope_test_trigger(uint8_t type, uint16_t level, uint16_t hyst,
+                        uint16_t lo, uint16_t hi)
+{
+    trig_type = type;
+    trig_level = level;
+    trig_hyst = hyst;
+    trig_lo = lo;
+    trig_hi = hi;
+    trig_primed = 0;
+}
+
+/*
+ * scope_test_pack() – n samples v into the ring from pos (wrapping
+ * at the end), then scope_pack() them into out. Returns the XOR.
+ */
+uint8_t scope_test_pack(const uint16_t *v, uint32_t n, uint32_t pos, uint8_t *out)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+        scope_ring[(pos + i) & (SCOPE_RING - 1)] = v[i];
+    return scope_pack(out, pos, n);
+}
@@ -0,0 +1,41 @@
+/*
+ * Builds 011_05 (adaptive sampling rate) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main adapt_main
+#define UART0Tx adapt_UART0Tx
+#define UART0_SendString adapt_UART0_SendString
+#define UART0_SendNumber adapt_UART0_SendNumber
+#define ADC0SS3_Handler adapt_ADC0SS3_Handler
+#define now_ms adapt_now_ms
+#include "../011_ADC/011_05_Adaptive_Sampling_Rate/main.c"
+
+/* adapt_test_reset() – clock at tick t, idle mode, empty log */
+void adapt_test_reset(uint32_t t)
+{
+    TIMER1_TAR_R = ~t;
+    clk_last = t;
+    clk_frac = clk_ms = 0;
+    mode = MODE_IDLE;
+    rate_hz = RATE_IDLE;
+    hist_n = 0;
+    quiet_since = 0;
+    log_head = log_tail = 0;
+}
+
+/* adapt_test_now() – now_ms() with Timer1 at tick t */
+uint32_t adapt_test_now(uint32_t t)
+{
+    TIMER1_TAR_R = ~t;
+    return now_ms();
+}
+
+/* adapt_test_sample() – sample x taken at tick t; returns the mode */
+uint32_t adapt_test_sample(uint32_t t, uint16_t x)
+{
+    TIMER1_TAR_R = ~t;
+    ADC0_SSFIFO3_R = x;
+    adapt_ADC0SS3_Handler();
+    return mode;
+}
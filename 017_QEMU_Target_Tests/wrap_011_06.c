@@ -0,0 +1,37 @@
+/*
+ * Builds 011_06 (differential ADC calibration) against the test
+ * shim. Symbols shared with other demos are renamed so several
+ * demos can be linked into one test image.
+ */
+#define main cal_main
+#define dma_table cal_dma_table
+#define ADC0SS1_Handler cal_ADC0SS1_Handler
+#define UART0Tx cal_UART0Tx
+#define UART0_SendString cal_UART0_SendString
+#define UART0_SendNumber cal_UART0_SendNumber
+#define command cal_command
+#define parse_signed cal_parse_signed
+#define print_signed cal_print_signed
+#include "../011_ADC/011_06_Differential_ADC_Calibration/main.c"
+
+/*
+ * cal_test_points() – two points of ch (codes in Q8, uV), then
+ * cal_compute(). Returns its result; *gain and *bias the
+ * coefficients afterwards, 0 if the record checksum is off.
+ */
+int cal_test_points(uint32_t ch, int32_t code0, int32_t uv0, int32_t code1,
+                    int32_t uv1, int32_t *gain, int32_t *bias)
+{
+    int r;
+
+    cal_pt_code[ch][0] = code0;
+    cal_pt_uv[ch][0] = uv0;
+    cal_pt_code[ch][1] = code1;
+    cal_pt_uv[ch][1] = uv1;
+    r = cal_compute(ch);
+    *gain = cal.ch[ch].gain;
+    *bias = cal.ch[ch].bias;
+    if (cal.check != cal_checksum(&cal))
+        *gain = *bias = 0;
+    return r;
+}
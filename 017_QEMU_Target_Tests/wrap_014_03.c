@@ -0,0 +1,117 @@
+/*
+ * Builds 014_03 (software UART) against the test shim. Symbols
+ * shared with other demos are renamed so several demos can be
+ * linked into one test image.
+ */
+#define main suart_main
+#define PLL_Init80MHz suart_PLL_Init80MHz
+#define UART0_Init suart_UART0_Init
+#define UART0Tx suart_UART0Tx
+#define UART0_SendString suart_UART0_SendString
+#define WTIMER0A_Handler suart_WTIMER0A_Handler
+#define WTIMER0B_Handler suart_WTIMER0B_Handler
+#define WTIMER1A_Handler suart_WTIMER1A_Handler
+#define WTIMER1B_Handler suart_WTIMER1B_Handler
+#include "../014_UART/014_03_Software_UART_Timer_Capture_Compare/main.c"
+
+/*
+ * Wide Timer 0 as the driver sees it: the simulated time t is
+ * counted up, TBV = ~t. The RX line (PC4) plays one frame of 10
+ * bits, LSB first, starting at sim_rx_start with sim_rx_bit
+ * clocks per bit; it idles HIGH outside the frame.
+ */
+static uint32_t sim_t, sim_rx_start, sim_rx_bit, sim_matches;
+static uint16_t sim_rx_frame;
+
+static void sim_set_time(uint32_t t)
+{
+    sim_t = t;
+    WTIMER0_TBV_R = ~t;
+    if (t - sim_rx_start < 10 * sim_rx_bit)
+        GPIO_PORTC_DATA_BITS_R[0x10] =
+            (sim_rx_frame >> ((t - sim_rx_start) / sim_rx_bit)) & 1 ? 0x10 : 0;
+    else
+        GPIO_PORTC_DATA_BITS_R[0x10] = 0x10;
+}
+
+/* Runs every match interrupt until none is pending */
+static void sim_run_matches(uint32_t *t, uint8_t *level, uint32_t max,
+                            uint32_t *n)
+{
+    uint32_t pin = GPIO_PORTC_DATA_BITS_R[0x20];
+
+    while (WTIMER0_IMR_R & TIMER_IMR_TBMIM)
+    {
+        sim_set_time(~WTIMER0_TBMATCHR_R);
+        sim_matches++;
+        suart_WTIMER0B_Handler();
+        if (n && GPIO_PORTC_DATA_BITS_R[0x20] != pin && *n < max)
+        {
+            pin = GPIO_PORTC_DATA_BITS_R[0x20];
+            t[*n] = sim_t;
+            level[(*n)++] = pin != 0;
+        }
+    }
+}
+
+static void sim_reset(void)
+{
+    suart_t *u = &suart[0];
+
+    u->tx_head = u->tx_tail = u->tx_busy = 0;
+    u->rx_head = u->rx_tail = u->rx_bits = 0;
+    u->rx_framing_errors = u->rx_overruns = 0;
+    WTIMER0_IMR_R = TIMER_IMR_CAEIM;
+    GPIO_PORTC_DATA_BITS_R[0x20] = 0xFF; // TX idle HIGH
+    sim_rx_start = 0;
+    sim_rx_bit = 1;
+    sim_matches = 0;
+    sim_set_time(0x7FFFFF00); // the 32-bit time wraps meanwhile
+}
+
+/*
+ * suart_test_tx() – write n bytes at once and record every TX
+ * level change (time, level) until the port is idle. Returns the
+ * number of changes, *matches the match interrupts taken.
+ */
+uint32_t suart_test_tx(const char *s, uint32_t n, uint32_t *t,
+                       uint8_t *level, uint32_t max, uint32_t *matches)
+{
+    uint32_t edges = 0;
+
+    sim_reset();
+    while (n--)
+        suart_write(&suart[0], *s++);
+    sim_run_matches(t, level, max, &edges);
+    *matches = sim_matches;
+    return edges;
+}
+
+/*
+ * suart_test_rx() – the RX line plays frame (start, 8 data, stop
+ * from bit 0 up) at `bit` clocks per bit; the capture interrupt
+ * runs `latency` clocks after the start edge. Returns the bytes
+ * received (*c the first), *errors the framing errors.
+ */
+uint32_t suart_test_rx(uint16_t frame, uint32_t bit, uint32_t latency,
+                       char *c, uint32_t *errors)
+{
+    suart_t *u = &suart[0];
+    uint32_t got = 0, edge;
+
+    sim_reset();
+    edge = sim_t + 1000;
+    sim_rx_start = edge;
+    sim_rx_bit = bit;
+    sim_rx_frame = frame;
+
+    WTIMER0_TAR_R = ~edge; // captured falling edge
+    sim_set_time(edge + latency);
+    suart_WTIMER0A_Handler();
+    sim_run_matches(0, 0, 0, 0);
+
+    while (suart_read(u, &c[got]))
+        got++;
+    *errors = u->rx_framing_errors;
+    return (WTIMER0_IMR_R & TIMER_IMR_CAEIM) ? got : 0xFF; // start edges re-armed
+}
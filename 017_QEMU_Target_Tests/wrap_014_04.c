@@ -0,0 +1,64 @@
+/*
+ * Builds 014_04 (UART1 auto-baud) against the test shim. Symbols
+ * shared with other demos are renamed so several demos can be
+ * linked into one test image.
+ */
+#define main ab_main
+#define PLL_Init80MHz ab_PLL_Init80MHz
+#define UART0_Init ab_UART0_Init
+#define UART0Tx ab_UART0Tx
+#define UART0_SendString ab_UART0_SendString
+#define UART0_SendNumber ab_UART0_SendNumber
+#define UART1_Handler ab_UART1_Handler
+#define TIMER2A_Handler ab_TIMER2A_Handler
+#define uart1_rx_ring ab_uart1_rx_ring
+#define uart1_rx_head ab_uart1_rx_head
+#define uart1_rx_tail ab_uart1_rx_tail
+#include "../014_UART/014_04_UART1_Auto_Baud/main.c"
+
+/* ab_test_reset() – detection armed, nothing detected, UART1 divisor 0 */
+void ab_test_reset(void)
+{
+    autobaud_start();
+    ab_baud = 0;
+    ab_done = 0;
+    UART1_IBRD_R = UART1_FBRD_R = 0;
+}
+
+/*
+ * ab_test_edge() – one RX edge captured at t (Timer2A counts
+ * down), PB0 reading level after it. Returns the edges stored.
+ */
+uint32_t ab_test_edge(uint32_t t, int level)
+{
+    TIMER2_TAR_R = t & 0x00FFFFFF;
+    GPIO_PORTB_DATA_R = level ? 0x01 : 0x00;
+    ab_TIMER2A_Handler();
+    return ab_edges;
+}
+
+/* ab_test_detected() – rate reported to main, 0 if none */
+uint32_t ab_test_detected(void)
+{
+    return ab_done ? ab_baud : 0;
+}
+
+/*
+ * ab_test_sync() – the ten edges of 'U' at baud, the first one
+ * captured at t0; edge k at t0 - k x SYSCLK / baud, rounded down
+ * as the capture would. Returns the rate detected, 0 if none.
+ */
+uint32_t ab_test_sync(uint32_t baud, uint32_t t0)
+{
+    uint32_t k;
+
+    for (k = 0; k < AB_EDGES; k++)
+        ab_test_edge(t0 - (uint32_t)((uint64_t)k * SYSCLK / baud), k & 1);
+    return ab_test_detected();
+}
+
+/* ab_test_divisor() – UART1 divisor in 1/64 steps: IBRD << 6 | FBRD */
+uint32_t ab_test_divisor(void)
+{
+    return UART1_IBRD_R << 6 | UART1_FBRD_R;
+}
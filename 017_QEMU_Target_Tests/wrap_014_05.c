@@ -0,0 +1,147 @@
+/*
+ * Builds 014_05 (uDMA RX with receive timeout) against the test
+ * shim. Symbols shared with other demos are renamed so several
+ * demos can be linked into one test image.
+ *
+ * The handler drains the RX FIFO with "while (FR.RXFE == 0) read
+ * DR", which plain shim registers cannot model. Here UART0_FR_R
+ * is a function: each read moves the next FIFO byte into DR and
+ * reports RXFE once the FIFO is empty.
+ */
+#include "tm4c123gh6pm.h"
+
+static volatile uint32_t sim_dr, sim_fr;
+static volatile uint32_t *sim_uart0_fr(void);
+#define UART0_DR_R sim_dr
+#define UART0_FR_R (*sim_uart0_fr())
+
+#define main dmarx_main
+#define UART0Tx dmarx_UART0Tx
+#define UART0_SendString dmarx_UART0_SendString
+#define UART0_SendNumber dmarx_UART0_SendNumber
+#define dma_table dmarx_dma_table
+#define rx_ring dmarx_rx_ring
+#define rx_overruns dmarx_rx_overruns
+#define UART0_Handler dmarx_UART0_Handler
+#include "../014_UART/014_05_UART_DMA_RX_Receive_Timeout/main.c"
+
+static uint8_t sim_fifo[16];
+static uint32_t sim_fifo_n, sim_fifo_rd;
+static uint32_t sim_chis_late; // completion flag raised after the RT path
+
+static volatile uint32_t *sim_uart0_fr(void)
+{
+    if (sim_fifo_n)
+    {
+        sim_dr = sim_fifo[sim_fifo_rd++ & 15];
+        sim_fifo_n--;
+        sim_fr = 0;
+    }
+    else
+    {
+        sim_fr = 0x10; // RXFE
+    }
+    return &sim_fr;
+}
+
+/* One uDMA item into the ring; at the end of the arm the channel
+ * stops and raises its completion flag. */
+static void sim_dma_item(uint8_t b)
+{
+    volatile uint32_t *ctl = &dma_table[DMA_CH_UART0RX].ctl;
+    uint32_t left = ((*ctl >> 4) & 0x3FF) + 1;
+
+    rx_ring[RX_RING_SIZE - left] = b;
+    if (left > 1)
+    {
+        *ctl -= 1u << 4;
+        return;
+    }
+
+    *ctl &= ~0x3FF7u; // XFERSIZE 0, mode stop
+    if (sim_chis_late)
+    {
+        sim_chis_late = 2;
+        return;
+    }
+    UDMA_CHIS_R = 1 << DMA_CH_UART0RX;
+    UART0_MIS_R = 0;
+    dmarx_UART0_Handler();
+    UDMA_CHIS_R = 0;
+}
+
+/* dmarx_test_reset() – empty ring and queue, channel armed */
+void dmarx_test_reset(void)
+{
+    frame_head = frame_tail = 0;
+    rx_rd = 0;
+    rx_irqs = rx_frames = rx_overruns = rx_dropped = 0;
+    rx_overwritten = 0;
+    sim_fifo_n = sim_fifo_rd = 0;
+    sim_chis_late = 0;
+    UDMA_CHIS_R = 0;
+    uart_rx_dma_init();
+}
+
+/*
+ * dmarx_test_frame() – n bytes on the line, then the receive
+ * timeout. uDMA moves bursts of 4 whenever the FIFO holds 8, as
+ * with IFLS = 1/2. late = 1: a ring-end completion in this frame
+ * is only flagged after the RT path ran (the CHIS race).
+ */
+void dmarx_test_frame(const uint8_t *s, uint32_t n, int late)
+{
+    uint32_t k;
+
+    sim_chis_late = late;
+    while (n--)
+    {
+        sim_fifo[(sim_fifo_rd + sim_fifo_n++) & 15] = *s++;
+        if (sim_fifo_n >= 8 && (dma_table[DMA_CH_UART0RX].ctl & 0x7))
+            for (k = 0; k < 4 && (dma_table[DMA_CH_UART0RX].ctl & 0x7); k++, sim_fifo_n--)
+                sim_dma_item(sim_fifo[sim_fifo_rd++ & 15]);
+    }
+
+    UART0_MIS_R = 0x40;
+    dmarx_UART0_Handler();
+    UART0_MIS_R = 0;
+    UDMA_CHIS_R = 0; // write 1 to clear
+
+    if (sim_chis_late == 2) // flag raised during the RT path
+    {
+        UDMA_CHIS_R = 1 << DMA_CH_UART0RX;
+        dmarx_UART0_Handler();
+        UDMA_CHIS_R = 0;
+    }
+    sim_chis_late = 0;
+}
+
+/*
+ * dmarx_test_get() – oldest frame copied to out; returns its
+ * length or -1 if none, *spans how many spans it came in.
+ */
+int dmarx_test_get(uint8_t *out, uint32_t *spans)
+{
+    uart_frame_t f;
+    uint32_t s, i, n = 0;
+
+    if (!uart_frame_get(&f))
+        return -1;
+    for (s = 0; s < 2; s++)
+        for (i = 0; i < f.len[s]; i++)
+            out[n++] = f.data[s][i];
+    *spans = f.len[1] ? 2 : 1;
+    return (int)n;
+}
+
+int dmarx_test_release(void)
+{
+    return uart_frame_release();
+}
+
+/* field: 0 rx_wr, 1 rx_dropped, 2 rx_overwritten, 3 live position */
+uint32_t dmarx_test_count(int field)
+{
+    return field == 0 ? rx_wr : field == 1 ? rx_dropped
+                            : field == 2 ? rx_overwritten : uart_rx_position();
+}
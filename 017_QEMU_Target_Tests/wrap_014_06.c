@@ -0,0 +1,32 @@
+/*
+ * Builds 014_06 (Modbus RTU slave) against the test shim. Symbols
+ * shared with other demos are renamed so several demos can be
+ * linked into one test image.
+ */
+#define main mb_main
+#define dma_table mb_dma_table
+#define io_init mb_io_init
+#define ADC0SS3_Handler mb_ADC0SS3_Handler
+#define UART1_Handler mb_UART1_Handler
+#define TIMER0A_Handler mb_TIMER0A_Handler
+#include "../014_UART/014_06_Modbus_RTU_Slave/main.c"
+
+/*
+ * mb_test_request() – run one request PDU (address + function +
+ * data, no CRC) with the PWM compare and PF1 at the given values.
+ * Returns the response length, rsp the response.
+ */
+uint32_t mb_test_request(const uint8_t *req, uint32_t len, uint8_t *rsp,
+                         uint32_t cmpb, uint32_t pf1)
+{
+    PWM1_3_CMPB_R = cmpb;
+    GPIO_PORTF_DATA_BITS_R[0x02] = pf1 ? 0x02 : 0;
+    adc_raw = 0x0ABC;
+    return mb_execute(req, len, rsp);
+}
+
+/* mb_test_outputs() – CMPB in the low half, PF1 bit above */
+uint32_t mb_test_outputs(void)
+{
+    return PWM1_3_CMPB_R | (GPIO_PORTF_DATA_BITS_R[0x02] ? 0x10000 : 0);
+}
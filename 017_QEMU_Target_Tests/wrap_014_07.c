@@ -0,0 +1,119 @@
+/*
+ * Builds 014_07 (RS-485 9-bit multidrop, master role) against the
+ * test shim. Symbols shared with other demos are renamed so several
+ * demos can be linked into one test image.
+ *
+ * UART1 runs with the FIFO off, so the handler sees one received
+ * character per interrupt and drains it with "while (FR.RXFE == 0)
+ * read DR". Here UART1_FR_R is a function: each read moves the
+ * pending character into DR and reports RXFE once it is taken.
+ */
+#include "tm4c123gh6pm.h"
+
+static volatile uint32_t sim_dr, sim_fr;
+static volatile uint32_t *sim_uart1_fr(void);
+#define UART1_DR_R sim_dr
+#define UART1_FR_R (*sim_uart1_fr())
+
+#define main bus_main
+#define UART1_Handler bus_UART1_Handler
+#define TIMER0A_Handler bus_TIMER0A_Handler
+#include "../014_UART/014_07_RS485_9Bit_Multidrop/main.c"
+
+static uint32_t sim_rx, sim_rx_full;
+static int sim_selected; // last address character was ours
+
+static volatile uint32_t *sim_uart1_fr(void)
+{
+    if (sim_rx_full)
+    {
+        sim_dr = sim_rx;
+        sim_rx_full = 0;
+        sim_fr = 0x80; // TXFE, RX not empty
+    }
+    else
+    {
+        sim_fr = 0x90; // TXFE, RXFE
+    }
+    return &sim_fr;
+}
+
+/* mdrop_test_reset() – n slaves (addresses 1..n), no token out */
+void mdrop_test_reset(uint32_t n)
+{
+    uint32_t i;
+
+    bus_slave_count = bus_cursor = bus_rounds = 0;
+    bus_chars_total = bus_chars_payload = 0;
+    bus_backoff = 1;
+    for (i = 1; i <= n; i++)
+        bus_add_slave((uint8_t)i);
+    bus_current = -1;
+    rx_state = RX_IDLE;
+    sim_rx_full = 0;
+    sim_selected = 0;
+    UART1_9BITADDR_R = 0x8000 | BUS_MASTER_ADDR;
+}
+
+/* mdrop_test_start() – the first poll, as main() sends it */
+void mdrop_test_start(void)
+{
+    bus_poll(bus_next_slave());
+}
+
+/*
+ * mdrop_test_rx() – one character on the bus, bit 8 = 9th bit. As
+ * in hardware, an address other than ours deselects the node and
+ * its data never interrupts the CPU.
+ */
+void mdrop_test_rx(uint32_t c)
+{
+    if (c & 0x100)
+        sim_selected = (c & 0xFF) == (UART1_9BITADDR_R & 0xFF);
+    if (!sim_selected)
+        return;
+
+    sim_rx = c & 0xFF;
+    sim_rx_full = 1;
+    UART1_MIS_R = (c & 0x100) ? 0x1010 : 0x10;
+    bus_UART1_Handler();
+    UART1_MIS_R = 0;
+}
+
+/*
+ * mdrop_test_reply() – a whole reply frame [ADDR dst] [SRC] [LEN]
+ * [s] [CRC8]; bad_crc flips the CRC.
+ */
+void mdrop_test_reply(uint8_t dst, uint8_t src, const char *s, int bad_crc)
+{
+    uint32_t n = 0;
+
+    while (s[n])
+        n++;
+    mdrop_test_rx(0x100 | dst);
+    mdrop_test_rx(src);
+    mdrop_test_rx(n);
+    for (n = 0; s[n]; n++)
+        mdrop_test_rx((uint8_t)s[n]);
+    mdrop_test_rx(crc8((const uint8_t *)s, n) ^ (bad_crc ? 0xFF : 0));
+}
+
+/* mdrop_test_timeout() – the reply timer expires */
+void mdrop_test_timeout(void)
+{
+    bus_TIMER0A_Handler();
+}
+
+int mdrop_test_current(void)
+{
+    return bus_current;
+}
+
+/* field: 0 polls, 1 replies, 2 timeouts, 3 bytes */
+uint32_t mdrop_test_slave(int i, int field)
+{
+    const bus_slave_t *s = &bus_slaves[i];
+
+    return field == 0 ? s->polls : field == 1 ? s->replies
+                                : field == 2 ? s->timeouts : s->bytes;
+}
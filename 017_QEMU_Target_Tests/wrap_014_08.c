@@ -0,0 +1,68 @@
+/*
+ * Builds 014_08 (zero-copy NMEA parser) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main nmea_main
+#define UART0Tx nmea_UART0Tx
+#define UART0_SendString nmea_UART0_SendString
+#define UART0_SendNumber nmea_UART0_SendNumber
+#define UART1_Handler nmea_UART1_Handler
+#include "../014_UART/014_08_NMEA_Zero_Copy_Parser/main.c"
+
+/*
+ * nmea_replay() – feed a recorded log to the parser the way
+ * UART1_Handler would: chunk bytes at a time into a ring of
+ * ring_size bytes (0 = parse the log in place).
+ * out[] receives the last GGA time, latitude, longitude,
+ * satellites, altitude (x10) and the last RMC speed (x100).
+ * Returns the number of valid sentences, *bad the rejected ones.
+ */
+uint32_t nmea_replay(const char *log, uint32_t n, uint32_t ring_size,
+                     uint32_t chunk, int32_t out[6], uint32_t *bad)
+{
+    static uint8_t ring[256];
+    const volatile uint8_t *buf = (const uint8_t *)log;
+    uint32_t mask = 0xFFFFFFFF, head = n, fed = 0, tail = 0, i;
+    nmea_parser_t p;
+    nmea_sentence_t *s = &p.s;
+
+    nmea_init(&p, 0);
+    if (ring_size)
+    {
+        buf = ring;
+        mask = ring_size - 1;
+        head = 0;
+    }
+
+    while (1)
+    {
+        while (nmea_feed(&p, buf, mask, head))
+        {
+            if (nmea_is(s, "GGA"))
+            {
+                out[0] = nmea_time_ms(s, 1);
+                out[1] = nmea_coord(s, 2);
+                out[2] = nmea_coord(s, 4);
+                out[3] = nmea_int(s, 7);
+                out[4] = nmea_fixed(s, 9, 1);
+            }
+            else if (nmea_is(s, "RMC"))
+            {
+                out[5] = nmea_fixed(s, 7, 2);
+            }
+            tail = p.keep;
+        }
+        tail = p.keep;
+
+        if (!ring_size || fed == n)
+            break;
+
+        // Next chunk, never overwriting bytes the parser still needs
+        for (i = 0; i < chunk && fed < n && head - tail < ring_size; i++)
+            ring[head++ & mask] = (uint8_t)log[fed++];
+    }
+
+    *bad = p.bad;
+    return p.good;
+}
@@ -0,0 +1,99 @@
+/*
+ * Builds 015_03 (three-phase SVPWM / FOC core) against the test
+ * shim. Symbols shared with other demos are renamed so several
+ * demos can be linked into one test image.
+ */
+#define main foc_main
+#define UART0Tx foc_UART0Tx
+#define UART0_SendString foc_UART0_SendString
+#define UART0_SendNumber foc_UART0_SendNumber
+#include "../015_PWM/015_03_Three_Phase_SVPWM_FOC/main.c"
+
+/*
+ * foc_closed_loop() – run foc_step() against a first-order R-L
+ * motor model with the rotor locked at angle theta (no back EMF):
+ *      i(dq) += (v(dq) - i(dq)) / 16   per period
+ * The model currents are turned back into the two ADC codes the
+ * shunt amplifiers would give. Returns the final id and iq.
+ */
+void foc_closed_loop(uint16_t theta, int32_t id_ref, int32_t iq_ref,
+                     uint32_t steps, int32_t out[2])
+{
+    int32_t id = 0, iq = 0, s, c, alpha, beta, ib;
+    foc_t f;
+
+    foc_init(&f);
+    f.phase = (uint32_t)theta << 16;
+    f.id_ref = id_ref;
+    f.iq_ref = iq_ref;
+    s = foc_sin(theta);
+    c = foc_sin((uint16_t)(theta + 0x4000));
+
+    while (steps--)
+    {
+        alpha = ((id * c) >> 15) - ((iq * s) >> 15);
+        beta = ((id * s) >> 15) + ((iq * c) >> 15);
+        ib = (-alpha + ((beta * SQRT3_Q14) >> 14)) >> 1;
+
+        foc_step(&f, (uint32_t)(f.off_a + (alpha >> 4)),
+                 (uint32_t)(f.off_b + (ib >> 4)));
+
+        id += (f.vd - id) >> 4;
+        iq += (f.vq - iq) >> 4;
+    }
+
+    out[0] = f.id;
+    out[1] = f.iq;
+}
+
+/*
+ * foc_park_max_error() – balanced currents of amplitude amp
+ * aligned with theta, for 256 angles: largest |id - amp| or |iq|.
+ */
+int32_t foc_park_max_error(int32_t amp)
+{
+    int32_t err = 0, e;
+    uint32_t k;
+    uint16_t a;
+    foc_t f;
+
+    foc_init(&f);
+    for (k = 0; k < 256; k++)
+    {
+        a = (uint16_t)(k << 8);
+        foc_currents(&f, (amp * foc_sin((uint16_t)(a + 0x4000))) >> 15,
+                     (amp * foc_sin((uint16_t)(a - 0x5555 + 0x4000))) >> 15,
+                     foc_sin(a), foc_sin((uint16_t)(a + 0x4000)));
+        e = f.id > amp ? f.id - amp : amp - f.id;
+        err = e > err ? e : err;
+        e = f.iq < 0 ? -f.iq : f.iq;
+        err = e > err ? e : err;
+    }
+    return err;
+}
+
+/* foc_svpwm_at() – compare values for a voltage vector (mag, theta) */
+void foc_svpwm_at(int32_t mag, uint16_t theta, uint16_t cmp[3])
+{
+    foc_t f;
+
+    foc_svpwm(&f, (mag * foc_sin((uint16_t)(theta + 0x4000))) >> 15,
+              (mag * foc_sin(theta)) >> 15);
+    cmp[0] = f.cmp[0];
+    cmp[1] = f.cmp[1];
+    cmp[2] = f.cmp[2];
+}
+
+/* foc_bench_init() / foc_bench_step() – the demo's controller
+ * running at 8000 iq and 50 Hz, one control period per call */
+void foc_bench_init(void)
+{
+    foc_init(&foc);
+    foc.iq_ref = 8000;
+    foc.speed = 50 * SPEED_PER_HZ;
+}
+
+void foc_bench_step(void)
+{
+    foc_step(&foc, 2100, 1990);
+}
@@ -0,0 +1,134 @@
+/*
+ * Builds 015_04 (PWM audio, IMA-ADPCM) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main audio_main
+#define PLL_Init80MHz audio_PLL_Init80MHz
+#define UART0Tx audio_UART0Tx
+#define UART0_SendString audio_UART0_SendString
+#define UART0_SendNumber audio_UART0_SendNumber
+#define dma_table audio_dma_table
+#define TIMER0A_Handler audio_TIMER0A_Handler
+#include "../015_PWM/015_04_PWM_Audio_ADPCM/main.c"
+
+/*
+ * adpcm_encode() – reference IMA-ADPCM encoder (test side only),
+ * low nibble first, predictor and index starting at 0.
+ */
+static void adpcm_encode(const int16_t *in, uint8_t *out, uint32_t n)
+{
+    voice_t v = {0};
+    uint32_t i, code;
+    int32_t diff, step;
+
+    for (i = 0; i < n; i++)
+    {
+        step = ima_step[v.index];
+        diff = in[i] - v.pred;
+        code = 0;
+        if (diff < 0)
+        {
+            code = 8;
+            diff = -diff;
+        }
+        if (diff >= step)
+        {
+            code |= 4;
+            diff -= step;
+        }
+        if (diff >= step >> 1)
+        {
+            code |= 2;
+            diff -= step >> 1;
+        }
+        if (diff >= step >> 2)
+            code |= 1;
+
+        adpcm_decode(&v, code); // track the decoder
+        if (i & 1)
+            out[i >> 1] |= (uint8_t)(code << 4);
+        else
+            out[i >> 1] = (uint8_t)code;
+    }
+}
+
+/*
+ * audio_roundtrip_error() – encode 1024 samples of a 1 kHz sine
+ * (amplitude amp), play them on voice 0 at full volume and return
+ * the largest difference after the first 32 samples (step size
+ * adaptation).
+ */
+int32_t audio_roundtrip_error(int32_t amp)
+{
+    static int16_t pcm[1024];
+    static uint8_t adpcm[512];
+    static int32_t acc[1024];
+    adpcm_clip_t clip = {adpcm, 1024};
+    int32_t err = 0, e;
+    uint32_t i;
+
+    for (i = 0; i < 1024; i++)
+    {
+        // 8 samples per period: sin(k x 45°)
+        static const int32_t sin8[8] = {0, 23170, 32767, 23170, 0, -23170, -32767, -23170};
+        pcm[i] = (int16_t)(amp * sin8[i & 7] >> 15);
+        acc[i] = 0;
+    }
+    adpcm_encode(pcm, adpcm, 1024);
+
+    voice_play(&voice[0], &clip, 256);
+    voice_render(&voice[0], acc, 1024);
+
+    for (i = 32; i < 1024; i++)
+    {
+        e = (acc[i] >> 8) - pcm[i];
+        e = e < 0 ? -e : e;
+        err = e > err ? e : err;
+    }
+    return voice[0].clip == 0 ? err : 0x7FFFFFFF;
+}
+
+/*
+ * audio_mix_range() – fill halves until both voices (the chime at
+ * full volume, master volume vol) have ended; returns the duty
+ * range seen in lo/hi and the number of halves needed.
+ */
+uint32_t audio_mix_range(int32_t vol, uint32_t *lo, uint32_t *hi)
+{
+    uint32_t n = 0, i;
+
+    master_vol = vol;
+    voice_play(&voice[0], &chime, 256);
+    voice_play(&voice[1], &chime, 256);
+    *lo = 0xFFFFFFFF;
+    *hi = 0;
+    while (voice[0].clip || voice[1].clip)
+    {
+        audio_fill(pwm_ring[0], HALF);
+        for (i = 0; i < HALF; i++)
+        {
+            *lo = pwm_ring[0][i] < *lo ? pwm_ring[0][i] : *lo;
+            *hi = pwm_ring[0][i] > *hi ? pwm_ring[0][i] : *hi;
+        }
+        n++;
+    }
+    master_vol = 256;
+    return n;
+}
+
+/* audio_silence() – duty of the first sample with no voice active */
+uint32_t audio_silence(void)
+{
+    voice[0].clip = voice[1].clip = 0;
+    audio_fill(pwm_ring[0], HALF);
+    return pwm_ring[0][0];
+}
+
+/* audio_bench_half() – one refill with both voices playing */
+void audio_bench_half(void)
+{
+    voice_play(&voice[0], &chime, 256);
+    voice_play(&voice[1], &chime, 160);
+    audio_fill(pwm_ring[0], HALF);
+}
@@ -0,0 +1,46 @@
+/*
+ * Builds 015_05 (sigma-delta dithered PWM) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main dither_main
+#define PLL_Init80MHz dither_PLL_Init80MHz
+#define UART0Tx dither_UART0Tx
+#define UART0_SendString dither_UART0_SendString
+#define UART0_SendNumber dither_UART0_SendNumber
+#define dma_table dither_dma_table
+#define halves dither_halves
+#define TIMER0A_Handler dither_TIMER0A_Handler
+#include "../015_PWM/015_05_Sigma_Delta_Dithered_PWM/main.c"
+
+/*
+ * sd_period_sum() – run the modulator for 2^SD_FRAC periods at
+ * duty d. Returns the sum of the compare values (the on-time in
+ * ticks), *pulses the number of periods with the LED on.
+ * Returns 0xFFFFFFFF if a value is not d >> SD_FRAC or one more.
+ */
+uint32_t sd_period_sum(uint32_t d, uint32_t *pulses)
+{
+    uint32_t q = d >> SD_FRAC, sum = 0, i, k;
+
+    sd_acc = 0;
+    *pulses = 0;
+    for (k = 0; k < (1u << SD_FRAC) / HALF; k++)
+    {
+        sd_fill(cmp_ring[0], HALF, d);
+        for (i = 0; i < HALF; i++)
+        {
+            if (cmp_ring[0][i] != q && cmp_ring[0][i] != q + 1)
+                return 0xFFFFFFFF;
+            sum += cmp_ring[0][i];
+            *pulses += (cmp_ring[0][i] != 0);
+        }
+    }
+    return sum;
+}
+
+/* sd_bench_half() – one ring refill, as in TIMER0A_Handler */
+void sd_bench_half(void)
+{
+    sd_fill(cmp_ring[0], HALF, 0x123456);
+}
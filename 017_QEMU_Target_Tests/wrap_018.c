@@ -0,0 +1,81 @@
+/*
+ * Builds 018 (RAM functions and VTOR) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main vtor_main
+#define PLL_Init80MHz vtor_PLL_Init80MHz
+#define UART0_Init vtor_UART0_Init
+#define UART0Tx vtor_UART0Tx
+#define UART0_SendString vtor_UART0_SendString
+#define UART0_SendNumber vtor_UART0_SendNumber
+#define GPIOA_Handler vtor_GPIOA_Handler
+#define report vtor_report
+#include "../018_RAM_Functions_and_VTOR/main.c"
+
+/*
+ * vtor_shift_same() – shift byte out with the flash and the SRAM
+ * copy. Returns 1 if both leave the same pins, *pins the PF data
+ * (low byte) and PE data (next byte) they left.
+ */
+int vtor_shift_same(unsigned char byte, uint32_t *pins)
+{
+    uint32_t flash;
+
+    GPIO_PORTE_DATA_R = GPIO_PORTF_DATA_R = 0;
+    shift_out_flash(byte);
+    flash = GPIO_PORTF_DATA_R | GPIO_PORTE_DATA_R << 8;
+    GPIO_PORTE_DATA_R = GPIO_PORTF_DATA_R = 0;
+    shift_out_ram(byte);
+    *pins = GPIO_PORTF_DATA_R | GPIO_PORTE_DATA_R << 8;
+    return *pins == flash;
+}
+
+/* vtor_control() – duty for adc; 0xFFFFFFFF if the copies differ */
+uint32_t vtor_control(uint16_t adc)
+{
+    uint32_t flash;
+
+    adc_value = adc;
+    control_step_flash();
+    flash = PWM1_3_CMPA_R;
+    PWM1_3_CMPA_R = 0;
+    control_step_ram();
+    return PWM1_3_CMPA_R == flash ? flash : 0xFFFFFFFF;
+}
+
+/*
+ * vtor_relocate_check() – relocate a fake flash table whose entry
+ * i is i, then install handler for irq. Returns 1 if VTOR points
+ * at the 1 KB aligned copy, the copy matches and only entry
+ * irq + 16 changed. The table addresses must fit in VTOR, so a
+ * 64-bit host above 4 GB only checks vtable_set_handler().
+ */
+int vtor_relocate_check(uint32_t irq, void (*handler)(void))
+{
+    static void (*flash_table[VECTOR_COUNT])(void);
+    uint32_t i;
+    int ok = ((uintptr_t)ram_vectors & 1023) == 0;
+
+    if ((uintptr_t)flash_table > 0xFFFFFFFFu ||
+        (uintptr_t)ram_vectors > 0xFFFFFFFFu)
+    {
+        for (i = 0; i < VECTOR_COUNT; i++)
+            ram_vectors[i] = 0;
+        vtable_set_handler(irq, handler);
+        for (i = 0; i < VECTOR_COUNT; i++)
+            ok &= ram_vectors[i] == (i == irq + 16 ? handler : 0);
+        return ok;
+    }
+
+    for (i = 0; i < VECTOR_COUNT; i++)
+        flash_table[i] = (void (*)(void))(uintptr_t)i;
+    NVIC_VTABLE_R = (uint32_t)(uintptr_t)flash_table;
+    vtable_relocate();
+    ok &= NVIC_VTABLE_R == (uint32_t)(uintptr_t)ram_vectors;
+
+    vtable_set_handler(irq, handler);
+    for (i = 0; i < VECTOR_COUNT; i++)
+        ok &= ram_vectors[i] == (i == irq + 16 ? handler : flash_table[i]);
+    return ok;
+}
@@ -0,0 +1,49 @@
+/*
+ * Builds 019 (C++ template HAL) against the test shim. The helpers
+ * have C linkage so main.c can call them.
+ */
+#define main hal_main
+#include "../019_Cpp_Template_HAL/main.cpp"
+
+/* hal_test_write() – TAMR after write<> over old: mode 2, count down */
+extern "C" uint32_t hal_test_write(uint32_t old)
+{
+    TIMER1_TAMR_R = old;
+    write<TaMode::Value<2>, TaCountUp::Value<0>>();
+    return TIMER1_TAMR_R;
+}
+
+/* hal_test_modify() – CTL after modify<> over old: enable bit set */
+extern "C" uint32_t hal_test_modify(uint32_t old)
+{
+    TIMER1_CTL_R = old;
+    modify<TaEnable::Value<1>>();
+    return TIMER1_CTL_R;
+}
+
+/* hal_test_field() – TaTimeout::read() with RIS = ris */
+extern "C" uint32_t hal_test_field(uint32_t ris)
+{
+    TIMER1_RIS_R = ris;
+    return TaTimeout::read();
+}
+
+/*
+ * hal_test_leds() – Leds::write(value) and Green::high(); returns
+ * the masked data word each one stored, Leds in the low half.
+ */
+extern "C" uint32_t hal_test_leds(uint32_t value)
+{
+    Leds::make_output();
+    Leds::write(value);
+    Green::high();
+    return GPIO_PORTF_DATA_BITS_R[Leds::mask] |
+           GPIO_PORTF_DATA_BITS_R[Green::mask] << 16;
+}
+
+/* hal_test_delay() – delayMs(ms) with the timeout flag always set */
+extern "C" void hal_test_delay(int ms)
+{
+    TIMER1_RIS_R = 1;
+    delayMs(ms);
+}
@@ -0,0 +1,39 @@
+/*
+ * Builds 020 (WS2812 LED strip) against the test shim. Symbols
+ * shared with other demos are renamed so several demos can be
+ * linked into one test image.
+ */
+#define main ws_main
+#define dma_table ws_dma_table
+#define SysTick_Handler ws_SysTick_Handler
+#define ms_ticks ws_ms_ticks
+#include "../020_WS2812_LED_Strip/main.c"
+
+/* ws_test_lut() – the 24 SSI bits for one colour byte */
+uint32_t ws_test_lut(uint8_t v)
+{
+    return ws_lut[v];
+}
+
+/*
+ * ws_test_encode() – every pixel set to (r, g, b), then encoded;
+ * copies the first pixel's 9 SSI bytes to out. Returns 1 if the
+ * rest of the strip repeats them and the reset tail is all zero.
+ */
+int ws_test_encode(uint8_t r, uint8_t g, uint8_t b, uint8_t out[9])
+{
+    uint32_t i;
+    int ok = 1;
+
+    for (i = 0; i < WS_PIXELS; i++)
+        pixels[i].r = r, pixels[i].g = g, pixels[i].b = b;
+    ws_encode(ws_encoded[0], pixels);
+
+    for (i = 0; i < 9; i++)
+        out[i] = ws_encoded[0][i];
+    for (i = 9; i < WS_PIXELS * WS_BYTES_PER_PIXEL; i++)
+        ok &= ws_encoded[0][i] == out[i % 9];
+    for (; i < WS_FRAME_BYTES; i++)
+        ok &= ws_encoded[0][i] == 0;
+    return ok;
+}
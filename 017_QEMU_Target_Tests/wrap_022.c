@@ -0,0 +1,48 @@
+/*
+ * Builds 022 (74HC165 / 74HC595 expander) against the test shim.
+ * Symbols shared with other demos are renamed so several demos
+ * can be linked into one test image.
+ */
+#define main iox_main
+#define UART0Tx iox_UART0Tx
+#define UART0_SendString iox_UART0_SendString
+#define UART0_SendNumber iox_UART0_SendNumber
+#define TIMER1A_Handler iox_TIMER1A_Handler
+#include "../022_IO_Expander_74HC165_74HC595/main.c"
+
+/* iox_test_reset() – nothing pressed, counters idle, queue empty */
+void iox_test_reset(void)
+{
+    iox_out = iox_in = iox_pressed = 0;
+    deb_ct0 = deb_ct1 = 0xFFFF;
+    input_head = input_tail = input_dropped = 0;
+    ms_ticks = 0;
+}
+
+/*
+ * iox_test_refresh() – n Timer1A refreshes while the 165 pins
+ * read `pins` (0 = pressed). Returns the events queued; the SSI
+ * frame of the last refresh is left in SSI2_DR_R.
+ */
+uint32_t iox_test_refresh(uint16_t pins, uint32_t n)
+{
+    uint32_t head = input_head;
+
+    while (n--)
+    {
+        SSI2_SR_R = 0x04; // RNE: the frame shifted in
+        SSI2_DR_R = pins;
+        iox_TIMER1A_Handler();
+    }
+    return input_head - head;
+}
+
+/* iox_test_event() – next event as code | type << 8 | time << 16 */
+uint32_t iox_test_event(void)
+{
+    input_event_t ev;
+
+    if (!input_get(&ev))
+        return 0xFFFFFFFF;
+    return ev.code | (uint32_t)ev.type << 8 | ev.time << 16;
+}
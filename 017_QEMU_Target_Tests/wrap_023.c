@@ -0,0 +1,75 @@
+/*
+ * Builds 023 (4x4 matrix keypad) against the test shim. Symbols
+ * shared with other demos are renamed so several demos can be
+ * linked into one test image.
+ */
+#define main kp_main
+#define UART0Tx kp_UART0Tx
+#define UART0_SendString kp_UART0_SendString
+#define UART0_SendNumber kp_UART0_SendNumber
+#define input_queue kp_input_queue
+#define input_head kp_input_head
+#define input_tail kp_input_tail
+#define input_dropped kp_input_dropped
+#define input_post kp_input_post
+#define input_get kp_input_get
+#define deb_ct0 kp_deb_ct0
+#define deb_ct1 kp_deb_ct1
+#include "../023_Matrix_Keypad_4x4/main.c"
+
+/* kp_test_reset() – keypad_init() with nothing pressed */
+void kp_test_reset(void)
+{
+    tm4c_shim_reset();
+    GPIO_PORTC_DATA_R = 0xF0; // columns pulled up
+    key_down = 0;
+    deb_ct0 = deb_ct1 = 0xFFFF;
+    input_head = input_tail = input_dropped = 0;
+    wakeups = scans = 0;
+    keypad_init();
+}
+
+/*
+ * kp_test_run() – `ms` milliseconds with the keys in `held`
+ * (bit = key code) pressed: the columns of the rows driven LOW
+ * read LOW, a column edge while idle runs GPIOC_Handler and each
+ * tick of a running Timer2A runs TIMER2A_Handler. Returns the
+ * events queued.
+ */
+uint32_t kp_test_run(uint16_t held, uint32_t ms)
+{
+    uint32_t head = input_head, row, cols;
+
+    while (ms--)
+    {
+        cols = 0;
+        for (row = 0; row < KEY_ROWS; row++)
+            if ((GPIO_PORTE_DATA_R & (1u << row)) == 0)
+                cols |= (held >> (row * 4)) & 0x0F;
+        GPIO_PORTC_DATA_R = 0xF0 & ~(cols << 4);
+
+        if ((GPIO_PORTC_IM_R & 0xF0) && cols)
+            GPIOC_Handler();
+        else if (TIMER2_CTL_R & 0x01)
+            TIMER2A_Handler();
+    }
+    return input_head - head;
+}
+
+/* kp_test_event() – next event as label | type << 8, 0 if none */
+uint32_t kp_test_event(void)
+{
+    input_event_t ev;
+
+    if (!input_get(&ev))
+        return 0;
+    return (uint32_t)key_label[ev.code] | (uint32_t)ev.type << 8 |
+           (uint32_t)(ev.source == INPUT_SRC_KEYPAD) << 16;
+}
+
+/* kp_test_idle() – 1 if back to IDLE: rows LOW, IRQs on, timer off */
+int kp_test_idle(void)
+{
+    return (GPIO_PORTE_DATA_R & 0x0F) == 0 && (GPIO_PORTC_IM_R & 0xF0) == 0xF0 &&
+           (TIMER2_CTL_R & 0x01) == 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Builds 024 (event bus) against the test shim. Symbols shared
+ * with other demos are renamed so several demos can be linked
+ * into one test image.
+ */
+#define main evbus_main
+#define bus_init evbus_init
+#define ADC0SS1_Handler evbus_ADC0SS1_Handler
+#define UART0Tx evbus_UART0Tx
+#define UART0_SendString evbus_UART0_SendString
+#define UART0_SendNumber evbus_UART0_SendNumber
+#define key_scan evbus_key_scan
+#include "../024_Event_Bus/main.c"
+
+/* bus_test_reset() – empty pools and queues, counters cleared */
+void bus_test_reset(void)
+{
+    int i;
+
+    bus_init();
+    for (i = 0; i < PERF_COUNT; i++)
+        perf_counter[i] = perf_baseline[i] = perf_snapshot[i] = 0;
+    adc_latest = 0;
+    last_key = 'G';
+    rx_line = 0;
+}
+
+/* bus_test_adc() – publish like ADC0SS1_Handler; 0 = pool empty */
+int bus_test_adc(uint16_t ladder, uint16_t pot)
+{
+    adc_msg_t *m = bus_alloc_ADC();
+
+    if (!m)
+        return 0;
+    m->ladder = ladder;
+    m->pot = pot;
+    bus_publish_ADC(m);
+    return 1;
+}
+
+/* bus_test_button() – publish like GPIOF_Handler */
+int bus_test_button(uint8_t pressed)
+{
+    button_msg_t *m = bus_alloc_BUTTON();
+
+    if (!m)
+        return 0;
+    m->pressed = pressed;
+    bus_publish_BUTTON(m);
+    return 1;
+}
+
+/*
+ * bus_test_line() – s and CR through the demo's receive path,
+ * shell_rx_char(); 1 if the line was published.
+ */
+int bus_test_line(const char *s)
+{
+    uint32_t pub = perf_counter[PERF_BUS(BUS_SHELL, BUS_PUB)];
+
+    while (*s)
+        shell_rx_char(*s++);
+    shell_rx_char('\r');
+    return perf_counter[PERF_BUS(BUS_SHELL, BUS_PUB)] != pub;
+}
+
+/*
+ * bus_test_queued() – 1 if the oldest queued shell line reads s;
+ * s = 0: 1 if no line is queued.
+ */
+int bus_test_queued(const char *s)
+{
+    const bus_topic_t *b = &bus_topic[BUS_SHELL];
+    uint32_t i;
+
+    if (b->q_tail == b->q_head)
+        return s == 0;
+    i = b->queue[b->q_tail & (b->size - 1)];
+    return s && str_equal(((const shell_msg_t *)(b->pool + i * b->stride +
+                                                 sizeof(bus_hdr_t)))->line, s);
+}
+
+/* bus_test_topic() – topic number by name, -1 if unknown */
+int bus_test_topic(const char *name)
+{
+    int t;
+
+    for (t = 0; t < BUS_TOPIC_COUNT; t++)
+        if (str_equal(bus_name[t], name))
+            return t;
+    return -1;
+}
+
+uint32_t bus_test_free(int topic)
+{
+    return bus_topic[topic].free_head - bus_topic[topic].free_tail;
+}
+
+/* field: 0 pub, 1 drop, 2 delivered, 3 lat_max, 4 lat_sum */
+uint32_t bus_test_perf(int topic, int field)
+{
+    return perf_counter[PERF_BUS(topic, field)];
+}
+
+uint16_t bus_test_latest_pot(void)
+{
+    return adc_latest ? adc_latest->pot : 0xFFFF;
+}
+
+/*
+ * bus_test_order() – 1 if every topic's subscribers are in
+ * priority order and "adc" runs keypad, led, trend.
+ */
+int bus_test_order(void)
+{
+    const bus_topic_t *b = &bus_topic[BUS_ADC];
+    uint32_t t, i;
+
+    for (t = 0; t < BUS_TOPIC_COUNT; t++)
+        for (i = 1; i < bus_topic[t].n_subs; i++)
+            if (bus_subs[bus_order[bus_topic[t].first_sub + i - 1]].prio >
+                bus_subs[bus_order[bus_topic[t].first_sub + i]].prio)
+                return 0;
+
+    return b->n_subs == 3 &&
+           bus_subs[bus_order[b->first_sub]].fn == (bus_fn_t)keypad_on_adc &&
+           bus_subs[bus_order[b->first_sub + 1]].fn == (bus_fn_t)led_on_adc &&
+           bus_subs[bus_order[b->first_sub + 2]].fn == (bus_fn_t)trend_on_adc;
+}
+
+/* bus_bench_round() – one "adc" message: publish, three subscribers */
+void bus_bench_round(void)
+{
+    bus_test_adc(0xFFF, 1000);
+    bus_dispatch();
+}
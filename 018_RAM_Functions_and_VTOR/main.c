@@ -0,0 +1,344 @@
+/***************************************************************
+ * PROJECT NAME : Vector Table in SRAM and Fast ISRs Run from RAM
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad) @ 80 MHz (PLL)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * At 80 MHz the flash needs wait states. The prefetch buffer
+ * hides most of them for straight-line code, but every taken
+ * branch and every interrupt entry (vector fetch + first
+ * instructions of the handler) can stall. This program shows
+ * the two classic fixes and measures them:
+ *
+ *   1. VECTOR TABLE RELOCATION
+ *      vtable_relocate() copies the 155-entry vector table into
+ *      SRAM and points VTOR (NVIC_VTABLE_R) at the copy. Handlers
+ *      can then be changed at run time with vtable_set_handler().
+ *
+ *   2. RAM FUNCTIONS
+ *      Functions marked RAMFUNC are linked into the ".ramfunc"
+ *      section. The GCC linker script (000_Startup) places that
+ *      section in SRAM with a load address in flash, and
+ *      Reset_Handler copies it together with .data.
+ *      Here: the 74HC595 shift routine, the ADC→PWM control step
+ *      and an interrupt handler.
+ *
+ * BENCHMARK (printed on UART0, 115200 8N1):
+ *   The DWT cycle counter measures each function once from
+ *   flash and once from SRAM, and the interrupt latency
+ *   (software trigger → first instruction of the handler) for
+ *   "vector table + handler in flash" vs "both in SRAM".
+ *   Compare the two columns on your board; results depend on
+ *   branch density, so straight-line code may show no gain.
+ *
+ * HARDWARE : 74HC595 on PF2 (SDATA), PF3 (SCLK), PE5 (STK) as in
+ *            004_LCD. Nothing needs to be connected to run the
+ *            benchmark.
+ *
+ * KEIL NOTE : with the Keil toolchain add to the scatter file
+ *      RW_IRAM1 0x20000000 0x00008000 { *(.ramfunc) .ANY (+RW +ZI) }
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+/* Place a function in SRAM. long_call: SRAM (0x2000_0000) is out
+ * of range of a BL instruction from flash. */
+#ifdef TM4C_SHIM
+#define RAMFUNC /* host-sim build: ordinary function */
+#else
+#define RAMFUNC __attribute__((section(".ramfunc"), noinline, long_call))
+#endif
+
+/* The flash copies must not be inlined into main() either */
+#define FLASHFUNC __attribute__((noinline))
+
+/* Cortex-M4 DWT cycle counter (not in tm4c123gh6pm.h) */
+#define DWT_CTRL_R (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R (*((volatile uint32_t *)0xE0001004))
+#define CORE_DEMCR_R (*((volatile uint32_t *)0xE000EDFC))
+
+#define VECTOR_COUNT 155 // 16 core exceptions + 139 interrupts
+#define BENCH_IRQ 0      // GPIO Port A interrupt, used as a software IRQ
+
+/* VTOR needs the table aligned to the next power of two (1 KB) */
+__attribute__((aligned(1024))) void (*ram_vectors[VECTOR_COUNT])(void);
+
+volatile uint32_t isr_entry; // CYCCNT captured in the handler
+volatile uint16_t adc_value = 2048;
+
+// Function prototypes
+void PLL_Init80MHz(void);
+void UART0_Init(void);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+void vtable_relocate(void);
+void vtable_set_handler(uint32_t irq, void (*handler)(void));
+FLASHFUNC void shift_out_flash(unsigned char byte);
+RAMFUNC void shift_out_ram(unsigned char byte);
+FLASHFUNC void control_step_flash(void);
+RAMFUNC void control_step_ram(void);
+RAMFUNC void bench_isr_ram(void);
+uint32_t measure_irq_latency(void);
+void report(const char *name, uint32_t flash, uint32_t ram);
+
+int main(void)
+{
+    uint32_t t0, flash, ram;
+
+    PLL_Init80MHz();
+    UART0_Init();
+
+    // 74HC595 pins
+    SYSCTL_RCGCGPIO_R |= 0x30;
+    while ((SYSCTL_PRGPIO_R & 0x30) != 0x30)
+        ;
+    GPIO_PORTE_DIR_R |= 0x20;
+    GPIO_PORTE_DEN_R |= 0x20;
+    GPIO_PORTF_DIR_R |= 0x0C;
+    GPIO_PORTF_DEN_R |= 0x0C;
+
+    // PWM is not needed for timing; control_step writes CMPA of PWM1 Gen 3
+    SYSCTL_RCGCPWM_R |= 0x02;
+
+    // Start the cycle counter
+    CORE_DEMCR_R |= 0x01000000; // TRCENA
+    DWT_CYCCNT_R = 0;
+    DWT_CTRL_R |= 0x01; // CYCCNTENA
+
+    UART0_SendString("\r\ncycles        flash   sram\r\n");
+
+    /***********************************************************
+     * Function execution time
+     ***********************************************************/
+    t0 = DWT_CYCCNT_R;
+    shift_out_flash(0xA5);
+    flash = DWT_CYCCNT_R - t0;
+    t0 = DWT_CYCCNT_R;
+    shift_out_ram(0xA5);
+    ram = DWT_CYCCNT_R - t0;
+    report("shift_out  ", flash, ram);
+
+    t0 = DWT_CYCCNT_R;
+    control_step_flash();
+    flash = DWT_CYCCNT_R - t0;
+    t0 = DWT_CYCCNT_R;
+    control_step_ram();
+    ram = DWT_CYCCNT_R - t0;
+    report("control    ", flash, ram);
+
+    /***********************************************************
+     * Interrupt latency
+     * Flash: VTOR = 0 (table in flash), handler in flash.
+     * SRAM : VTOR = ram_vectors, handler in SRAM.
+     ***********************************************************/
+    NVIC_EN0_R = 1 << BENCH_IRQ;
+    __enable_irq();
+
+    flash = measure_irq_latency(); // GPIOA_Handler via the flash table
+
+    vtable_relocate();
+    vtable_set_handler(BENCH_IRQ, bench_isr_ram);
+    ram = measure_irq_latency();
+    report("irq latency", flash, ram);
+
+    while (1)
+        ;
+}
+
+/***********************************************************
+ * vtable_relocate() – copy the active vector table to SRAM
+ * and switch VTOR to it.
+ ***********************************************************/
+void vtable_relocate(void)
+{
+    void (**src)(void) = (void (**)(void))(uintptr_t)NVIC_VTABLE_R;
+    int i;
+
+    for (i = 0; i < VECTOR_COUNT; i++)
+        ram_vectors[i] = src[i];
+
+    __disable_irq();
+    NVIC_VTABLE_R = (uint32_t)(uintptr_t)ram_vectors;
+    __enable_irq();
+}
+
+/***********************************************************
+ * vtable_set_handler() – install a handler for IRQ n
+ * (vector entry n + 16) in the SRAM vector table.
+ ***********************************************************/
+void vtable_set_handler(uint32_t irq, void (*handler)(void))
+{
+    ram_vectors[irq + 16] = handler;
+}
+
+/***********************************************************
+ * shift_out – 8 bits LSB first into the 74HC595 (004_LCD).
+ * Same body twice: once in flash, once in SRAM.
+ ***********************************************************/
+FLASHFUNC void shift_out_flash(unsigned char byte)
+{
+    unsigned char j;
+
+    GPIO_PORTE_DATA_R = 0x00;
+    for (j = 0; j < 8; j++)
+    {
+        GPIO_PORTF_DATA_R = (byte & (1 << j)) ? 0x04 : 0x00;
+        GPIO_PORTF_DATA_R |= 0x08;
+    }
+    GPIO_PORTE_DATA_R = 0x20;
+}
+
+RAMFUNC void shift_out_ram(unsigned char byte)
+{
+    unsigned char j;
+
+    GPIO_PORTE_DATA_R = 0x00;
+    for (j = 0; j < 8; j++)
+    {
+        GPIO_PORTF_DATA_R = (byte & (1 << j)) ? 0x04 : 0x00;
+        GPIO_PORTF_DATA_R |= 0x08;
+    }
+    GPIO_PORTE_DATA_R = 0x20;
+}
+
+/***********************************************************
+ * control_step – one pass of the 015_02 ADC → PWM loop
+ * (duty = 0.75 x ADC in fixed point, clamped to LOAD).
+ ***********************************************************/
+FLASHFUNC void control_step_flash(void)
+{
+    uint32_t duty = ((uint32_t)adc_value * 3) >> 2;
+
+    if (duty > 0x0EFF)
+        duty = 0x0EFF;
+    PWM1_3_CMPA_R = duty;
+}
+
+RAMFUNC void control_step_ram(void)
+{
+    uint32_t duty = ((uint32_t)adc_value * 3) >> 2;
+
+    if (duty > 0x0EFF)
+        duty = 0x0EFF;
+    PWM1_3_CMPA_R = duty;
+}
+
+/***********************************************************
+ * Benchmark interrupt handlers – record entry time only.
+ * GPIOA_Handler is the flash-table entry (Keil device pack
+ * name); bench_isr_ram replaces it in the SRAM table.
+ ***********************************************************/
+void GPIOA_Handler(void)
+{
+    isr_entry = DWT_CYCCNT_R;
+}
+
+RAMFUNC void bench_isr_ram(void)
+{
+    isr_entry = DWT_CYCCNT_R;
+}
+
+/***********************************************************
+ * measure_irq_latency() – software trigger → handler entry
+ * Best of 16 runs, so one-off cache/prefetch misses are ignored.
+ ***********************************************************/
+uint32_t measure_irq_latency(void)
+{
+    uint32_t best = 0xFFFFFFFF, t0, i;
+
+    for (i = 0; i < 16; i++)
+    {
+        isr_entry = 0;
+        t0 = DWT_CYCCNT_R;
+        NVIC_SW_TRIG_R = BENCH_IRQ;
+        while (isr_entry == 0)
+            ;
+        if (isr_entry - t0 < best)
+            best = isr_entry - t0;
+    }
+    return best;
+}
+
+/***********************************************************
+ * PLL_Init80MHz() – 16 MHz crystal → 400 MHz PLL / 5 = 80 MHz
+ ***********************************************************/
+void PLL_Init80MHz(void)
+{
+    SYSCTL_RCC2_R |= 0x80000000;                            // USERCC2
+    SYSCTL_RCC2_R |= 0x00000800;                            // BYPASS2 while changing
+    SYSCTL_RCC_R = (SYSCTL_RCC_R & ~0x000007C0) | 0x00000540; // XTAL = 16 MHz
+    SYSCTL_RCC2_R &= ~0x00000070;                           // OSCSRC2 = main oscillator
+    SYSCTL_RCC2_R &= ~0x00002000;                           // PWRDN2 = 0, PLL on
+    SYSCTL_RCC2_R |= 0x40000000;                            // DIV400
+    SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~0x1FC00000) | (4 << 22); // SYSDIV2 = 4 → /5
+    while ((SYSCTL_RIS_R & 0x00000040) == 0)
+        ;                                                   // Wait for PLL lock
+    SYSCTL_RCC2_R &= ~0x00000800;                           // Use the PLL
+}
+
+/***********************************************************
+ * UART0 at 115200 8N1 from an 80 MHz clock
+ * IBRD = 80 MHz / (16 x 115200) = 43.40 → 43
+ * FBRD = 0.40 x 64 + 0.5 = 26
+ ***********************************************************/
+void UART0_Init(void)
+{
+    SYSCTL_RCGCUART_R |= 0x01;
+    SYSCTL_RCGCGPIO_R |= 0x01;
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 43;
+    UART0_FBRD_R = 26;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+}
+
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ;
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
+
+void report(const char *name, uint32_t flash, uint32_t ram)
+{
+    UART0_SendString(name);
+    UART0_SendString("   ");
+    UART0_SendNumber(flash);
+    UART0_SendString("   ");
+    UART0_SendNumber(ram);
+    UART0_SendString("\r\n");
+}
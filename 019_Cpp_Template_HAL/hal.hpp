@@ -0,0 +1,186 @@
+/***************************************************************
+ * FILE NAME : hal.hpp
+ * MCU       : TM4C123GH6PM (Tiva C LaunchPad)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * Header-only C++17 hardware abstraction built from templates.
+ * Everything is resolved at compile time, so the generated code
+ * is the same plain loads and stores as the C demos:
+ *
+ *   Registers : HAL_REGISTER(Name, MACRO) wraps a register macro
+ *               from tm4c123gh6pm.h in a type.
+ *
+ *   Fields    : Field<Reg, Pos, Width> describes a bit field.
+ *               Field::Value<v> is one field setting. Several
+ *               settings of the same register are merged into
+ *               ONE store (write) or ONE read-modify-write
+ *               (modify), and out-of-range values fail to compile:
+ *
+ *                   write<TaMode::Value<2>, TaCountUp::Value<0>>();
+ *
+ *   Pins      : Pin<PortF, 3> is a type. high() / low() use the
+ *               GPIO masked data address (DATA_BITS[mask]), so a
+ *               pin change is a single store instead of the
+ *               read-modify-write of "GPIO_PORTF_DATA_R |= 0x08".
+ *               PinGroup<...> writes several pins of one port in
+ *               one store.
+ *
+ * Only the ports and registers used by the demos are described;
+ * add more with the same macros.
+ ***************************************************************/
+
+#ifndef HAL_HPP
+#define HAL_HPP
+
+#include <stdint.h>
+#include <type_traits>
+#include "tm4c123gh6pm.h"
+
+namespace hal
+{
+
+/***********************************************************
+ * REGISTERS AND FIELDS
+ ***********************************************************/
+#define HAL_REGISTER(Name, macro)               \
+    struct Name                                 \
+    {                                           \
+        static volatile uint32_t &ref()         \
+        {                                       \
+            return macro;                       \
+        }                                       \
+    }
+
+template <typename Reg, unsigned Pos, unsigned Width>
+struct Field
+{
+    static_assert(Width > 0 && Pos + Width <= 32, "field outside register");
+
+    using reg = Reg;
+    static constexpr uint32_t mask =
+        (Width == 32 ? 0xFFFFFFFFu : ((1u << Width) - 1u)) << Pos;
+
+    template <uint32_t V>
+    struct Value
+    {
+        static_assert(Width == 32 || V < (1u << Width), "value does not fit field");
+
+        using reg = Reg;
+        static constexpr uint32_t mask = Field::mask;
+        static constexpr uint32_t bits = V << Pos;
+    };
+
+    static uint32_t read()
+    {
+        return (Reg::ref() & mask) >> Pos;
+    }
+};
+
+template <typename First, typename... Rest>
+struct SameRegister
+{
+    using reg = typename First::reg;
+    static constexpr bool value = (std::is_same_v<reg, typename Rest::reg> && ...);
+};
+
+/* Replace the whole register: fields not listed become 0 */
+template <typename... Values>
+inline void write()
+{
+    using R = SameRegister<Values...>;
+    static_assert(R::value, "all fields must belong to one register");
+    R::reg::ref() = (Values::bits | ...);
+}
+
+/* Change only the listed fields: one load, one store */
+template <typename... Values>
+inline void modify()
+{
+    using R = SameRegister<Values...>;
+    static_assert(R::value, "all fields must belong to one register");
+    constexpr uint32_t clear = (Values::mask | ...);
+    constexpr uint32_t set = (Values::bits | ...);
+    R::reg::ref() = (R::reg::ref() & ~clear) | set;
+}
+
+/***********************************************************
+ * GPIO PORTS AND PINS
+ ***********************************************************/
+#define HAL_GPIO_PORT(Name, X, clock)                                  \
+    struct Name                                                        \
+    {                                                                  \
+        static constexpr uint32_t clock_bit = clock;                   \
+        static volatile uint32_t &data() { return GPIO_PORT##X##_DATA_R; } \
+        static volatile uint32_t *bits() { return GPIO_PORT##X##_DATA_BITS_R; } \
+        static volatile uint32_t &dir() { return GPIO_PORT##X##_DIR_R; }   \
+        static volatile uint32_t &den() { return GPIO_PORT##X##_DEN_R; }   \
+        static volatile uint32_t &afsel() { return GPIO_PORT##X##_AFSEL_R; } \
+        static volatile uint32_t &pctl() { return GPIO_PORT##X##_PCTL_R; } \
+    }
+
+HAL_GPIO_PORT(PortA, A, 0x01);
+HAL_GPIO_PORT(PortB, B, 0x02);
+HAL_GPIO_PORT(PortC, C, 0x04);
+HAL_GPIO_PORT(PortD, D, 0x08);
+HAL_GPIO_PORT(PortE, E, 0x10);
+HAL_GPIO_PORT(PortF, F, 0x20);
+
+template <typename Port>
+inline void enable_clock()
+{
+    SYSCTL_RCGCGPIO_R |= Port::clock_bit;
+    while ((SYSCTL_PRGPIO_R & Port::clock_bit) == 0)
+        ;
+}
+
+template <typename PortT, unsigned N>
+struct Pin
+{
+    static_assert(N < 8, "GPIO ports have 8 pins");
+
+    using port = PortT;
+    static constexpr uint32_t mask = 1u << N;
+
+    static void make_output()
+    {
+        PortT::dir() |= mask;
+        PortT::den() |= mask;
+    }
+
+    static void make_input()
+    {
+        PortT::dir() &= ~mask;
+        PortT::den() |= mask;
+    }
+
+    static void high() { PortT::bits()[mask] = mask; }
+    static void low() { PortT::bits()[mask] = 0; }
+    static void write(bool on) { PortT::bits()[mask] = on ? mask : 0; }
+    static bool read() { return PortT::bits()[mask] != 0; }
+};
+
+/* Several pins of ONE port handled as a unit */
+template <typename First, typename... Rest>
+struct PinGroup
+{
+    static_assert((std::is_same_v<typename First::port, typename Rest::port> && ...),
+                  "all pins must be on one port");
+
+    using port = typename First::port;
+    static constexpr uint32_t mask = (First::mask | ... | Rest::mask);
+
+    static void make_output()
+    {
+        port::dir() |= mask;
+        port::den() |= mask;
+    }
+
+    /* value uses port bit positions, e.g. 0x08 = PF3 */
+    static void write(uint32_t value) { port::bits()[mask] = value; }
+    static uint32_t read() { return port::bits()[mask]; }
+};
+
+} // namespace hal
+
+#endif
@@ -0,0 +1,101 @@
+/*****************************************************************************************
+ * FILE NAME : main.cpp
+ *
+ * DATE      : 18/10/2026
+ *
+ * TARGET    : TM4C123GH6PM (Tiva C Series)
+ *
+ * DESCRIPTION:
+ * The program of 007_Timers/007_01_GPTM (RGB LED blink with a Timer1
+ * based 1 ms delay) rewritten with the C++ template HAL in hal.hpp.
+ *
+ * The behaviour is identical:
+ *   - PF1 → Red, PF2 → Blue, PF3 → Green
+ *   - Red → Green → Blue, 1 second each
+ *   - Timer1A, 16-bit, periodic, down-counting, 16000 ticks = 1 ms
+ *
+ * What changes is how the registers are written:
+ *   - the LEDs are a PinGroup, written with ONE store to the masked
+ *     GPIO data address (no read-modify-write of GPIO_PORTF_DATA_R),
+ *   - Timer1 is configured through named, range-checked fields,
+ *     merged at compile time into one store per register.
+ *
+ * "make hal-compare" builds this file and 007_01 with the same flags
+ * and prints the instruction count of each object.
+ *****************************************************************************************/
+
+#include <stdint.h>
+#include "hal.hpp"
+
+using namespace hal;
+
+/* LEDs */
+using Red = Pin<PortF, 1>;
+using Blue = Pin<PortF, 2>;
+using Green = Pin<PortF, 3>;
+using Leds = PinGroup<Red, Blue, Green>;
+
+/* Timer1 registers and the fields this program uses */
+HAL_REGISTER(Timer1Cfg, TIMER1_CFG_R);
+HAL_REGISTER(Timer1Tamr, TIMER1_TAMR_R);
+HAL_REGISTER(Timer1Ctl, TIMER1_CTL_R);
+HAL_REGISTER(Timer1Tailr, TIMER1_TAILR_R);
+HAL_REGISTER(Timer1Ris, TIMER1_RIS_R);
+HAL_REGISTER(Timer1Icr, TIMER1_ICR_R);
+
+using TimerWidth = Field<Timer1Cfg, 0, 3>;    // 4 = 16-bit timers
+using TaMode = Field<Timer1Tamr, 0, 2>;       // 2 = periodic
+using TaCountUp = Field<Timer1Tamr, 4, 1>;    // 0 = down
+using TaEnable = Field<Timer1Ctl, 0, 1>;
+using TaLoad = Field<Timer1Tailr, 0, 16>;
+using TaTimeout = Field<Timer1Ris, 0, 1>;
+using TaTimeoutClear = Field<Timer1Icr, 0, 1>;
+
+void delayMs(int time);
+
+int main(void)
+{
+    /* Enable clock for GPIO Port F, LEDs as outputs */
+    SYSCTL_RCGCGPIO_R |= PortF::clock_bit;
+    Leds::make_output();
+
+    while (1)
+    {
+        Leds::write(Red::mask);
+        delayMs(1000);
+
+        Leds::write(Green::mask);
+        delayMs(1000);
+
+        Leds::write(Blue::mask);
+        delayMs(1000);
+    }
+}
+
+/*****************************************************************************************
+ * FUNCTION NAME : delayMs
+ *
+ * DESCRIPTION:
+ * Same Timer1 configuration as 007_01, expressed with fields.
+ *****************************************************************************************/
+void delayMs(int time)
+{
+    int i;
+
+    SYSCTL_RCGCTIMER_R |= 0x02;
+
+    write<TaEnable::Value<0>>();
+    write<TimerWidth::Value<4>>();
+    write<TaMode::Value<2>, TaCountUp::Value<0>>();
+    write<TaLoad::Value<16000 - 1>>();
+    write<TaTimeoutClear::Value<1>>();
+    modify<TaEnable::Value<1>>();
+
+    for (i = 0; i < time; i++)
+    {
+        while (TaTimeout::read() == 0)
+            ;
+
+        write<TaTimeoutClear::Value<1>>();
+    }
+}
@@ -0,0 +1,370 @@
+/***************************************************************
+ * PROJECT NAME : WS2812 LED Strip Driver (SSI + uDMA)
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - SSI0 TX (PA5) → DIN of the first WS2812 pixel
+ *      - uDMA channel 11 (SSI0 TX)
+ *      - SysTick (1 ms time base for the animation)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * WS2812 pixels take one 800 kHz data line. Every bit is a
+ * 1.25 us slot whose HIGH time tells 0 from 1:
+ *
+ *      bit 0 : ~0.35 us HIGH, then LOW
+ *      bit 1 : ~0.70 us HIGH, then LOW
+ *
+ * Bit-banging this the way shift_out1() drives the 74HC595
+ * would keep the CPU busy for the whole frame with interrupts
+ * off. Here the SSI does the timing instead:
+ *
+ *   - SSI0 runs at 16 MHz / 6 = 2.667 MHz, so 3 SSI bits are
+ *     1.125 us (inside the WS2812 tolerance of 1.25 ± 0.6 us).
+ *   - Each pixel bit becomes a 3-bit SSI symbol:
+ *          0 → 100        1 → 110
+ *   - One colour byte becomes 24 SSI bits = 3 SSI bytes. All 256
+ *     expansions are precomputed in ws_lut[] (flash), so encoding
+ *     a pixel is 3 table lookups and 9 byte stores.
+ *   - uDMA copies the encoded frame into the SSI TX FIFO. The
+ *     CPU only re-arms the channel every 1024 bytes.
+ *   - WS_RESET_BYTES of zeros at the end of every frame hold the
+ *     line LOW for > 280 us, the latch (reset) time of the
+ *     newest WS2812B parts.
+ *
+ * Double buffering:
+ *   ws_encoded[0] / ws_encoded[1] hold two encoded frames. While
+ *   uDMA sends one, ws_show() encodes the next frame into the
+ *   other, so the animation renders during the transfer. If a
+ *   frame is still queued, ws_show() waits for it to start.
+ *
+ * Frame time for 150 pixels:
+ *   (150 x 9 + 96) bytes x 3 us = 4.3 ms → up to ~230 frames/s
+ *
+ * NOTE :
+ * The SSI TX pin idles LOW between frames (last symbol bit is
+ * always 0). A 3.3 V → 5 V level shifter (e.g. 74HCT125) is
+ * recommended for the data line.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+/***********************************************************
+ * STRIP AND FRAME SIZE
+ ***********************************************************/
+#define WS_PIXELS 150
+#define WS_BYTES_PER_PIXEL 9  // 3 colours x 3 SSI bytes
+#define WS_RESET_BYTES 96     // 96 x 3 us = 288 us LOW
+#define WS_FRAME_BYTES (WS_PIXELS * WS_BYTES_PER_PIXEL + WS_RESET_BYTES)
+
+#define DMA_CH_SSI0TX 11
+#define DMA_MAX_ITEMS 1024 // XFERSIZE is 10 bits
+
+typedef struct
+{
+    uint8_t r, g, b;
+} rgb_t;
+
+/***********************************************************
+ * EXPANSION LUT – one colour byte → 24 SSI bits (MSB first)
+ * Built by the preprocessor, so it lives in flash.
+ ***********************************************************/
+#define WS_SYM(v, n) ((((v) >> (n)) & 1) ? 0x6u : 0x4u) // 110 or 100
+#define WS_EXPAND(v)                                      \
+    ((WS_SYM(v, 7) << 21) | (WS_SYM(v, 6) << 18) |        \
+     (WS_SYM(v, 5) << 15) | (WS_SYM(v, 4) << 12) |        \
+     (WS_SYM(v, 3) << 9) | (WS_SYM(v, 2) << 6) |          \
+     (WS_SYM(v, 1) << 3) | WS_SYM(v, 0))
+#define WS_L4(v) WS_EXPAND(v), WS_EXPAND((v) + 1), WS_EXPAND((v) + 2), WS_EXPAND((v) + 3)
+#define WS_L16(v) WS_L4(v), WS_L4((v) + 4), WS_L4((v) + 8), WS_L4((v) + 12)
+#define WS_L64(v) WS_L16(v), WS_L16((v) + 16), WS_L16((v) + 32), WS_L16((v) + 48)
+
+static const uint32_t ws_lut[256] = {
+    WS_L64(0), WS_L64(64), WS_L64(128), WS_L64(192),
+};
+
+/***********************************************************
+ * uDMA CONTROL TABLE (must be 1024-byte aligned)
+ * Only the primary entries are used (basic mode).
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end; // address of the LAST source item
+    volatile uint32_t dst_end; // address of the LAST destination item
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[32] __attribute__((aligned(1024)));
+
+/***********************************************************
+ * FRAME BUFFERS
+ ***********************************************************/
+rgb_t pixels[WS_PIXELS];                     // rendered by the animation
+uint8_t ws_encoded[2][WS_FRAME_BYTES];       // encoded frames (double buffer)
+
+volatile const uint8_t *ws_tx_ptr;           // next byte for uDMA
+volatile uint32_t ws_tx_left;                // bytes not yet handed to uDMA
+volatile uint8_t ws_busy;                    // a frame is being sent
+volatile int8_t ws_pending = -1;             // encoded buffer waiting to be sent
+uint8_t ws_fill;                             // buffer ws_show() encodes into
+
+volatile uint32_t ms_ticks;                  // incremented by SysTick
+volatile uint32_t ws_frames_sent;
+
+// Function prototypes
+void ws_init(void);
+void ws_show(void);
+void ws_encode(uint8_t *dst, const rgb_t *src);
+void ws_start(uint8_t buf);
+void ws_dma_next(void);
+rgb_t wheel(uint8_t pos);
+
+int main(void)
+{
+    uint32_t last = 0;
+    uint8_t offset = 0;
+    unsigned int i;
+
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO A (SSI0), SSI0, uDMA
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x01; // Port A
+    SYSCTL_RCGCSSI_R |= 0x01;  // SSI0
+    SYSCTL_RCGCDMA_R |= 0x01;  // uDMA
+    while ((SYSCTL_PRGPIO_R & 0x01) == 0)
+        ;
+
+    /***********************************************************
+     * STEP 2: SSI0 and uDMA
+     ***********************************************************/
+    ws_init();
+
+    /***********************************************************
+     * STEP 3: SysTick 1 ms, then enable interrupts
+     ***********************************************************/
+    NVIC_ST_CTRL_R = 0;
+    NVIC_ST_RELOAD_R = 16000 - 1;
+    NVIC_ST_CURRENT_R = 0;
+    NVIC_ST_CTRL_R = 0x07; // core clock, interrupt, enable
+
+    __enable_irq();
+
+    /***********************************************************
+     * STEP 4: Rainbow chase, one new frame every 20 ms
+     * The next frame is rendered while the last one is still
+     * being clocked out by uDMA.
+     ***********************************************************/
+    while (1)
+    {
+        if ((ms_ticks - last) < 20)
+            continue;
+        last = ms_ticks;
+
+        for (i = 0; i < WS_PIXELS; i++)
+            pixels[i] = wheel((uint8_t)(i * 256 / WS_PIXELS + offset));
+        offset++;
+
+        ws_show();
+    }
+}
+
+/***********************************************************
+ * ws_init() – SSI0 as 8-bit SPI master at 2.667 MHz, TX uDMA
+ ***********************************************************/
+void ws_init(void)
+{
+    // PA5 = SSI0Tx
+    GPIO_PORTA_AFSEL_R |= 0x20;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0x00F00000) | 0x00200000;
+    GPIO_PORTA_DEN_R |= 0x20;
+
+    // SSI clock = SysClk / (CPSDVSR x (1 + SCR)) = 16 MHz / (2 x 3)
+    SSI0_CR1_R = 0x00;          // Disable, master mode
+    SSI0_CC_R = 0x00;           // System clock
+    SSI0_CPSR_R = 2;            // CPSDVSR = 2
+    // SPH = 1 for continuous transfer: with SPH = 0 the SSI pulses
+    // SSI0Fss between bytes, leaving a gap of one SSI bit. Bytes
+    // split symbols (8 is not a multiple of 3), so the gap would
+    // stretch pixel bits out of the WS2812 timing.
+    SSI0_CR0_R = (2 << 8) | 0x80 | 0x07; // SCR = 2, SPH = 1, SPO = 0, Freescale, 8-bit
+    SSI0_DMACTL_R = 0x02;       // TXDMAE
+    SSI0_CR1_R = 0x02;          // SSE
+
+    // uDMA: control table, channel 11 = SSI0 TX (encoding 0)
+    UDMA_CFG_R = 0x01; // MASTEN
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP1_R &= ~0x0000F000;           // CH11 → SSI0 TX
+    UDMA_PRIOCLR_R = 1 << DMA_CH_SSI0TX;
+    UDMA_ALTCLR_R = 1 << DMA_CH_SSI0TX;     // Use primary entry
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_SSI0TX; // Single and burst requests
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_SSI0TX;
+
+    // uDMA completion for a peripheral channel arrives on the
+    // peripheral's own vector: IRQ 7 = SSI0
+    NVIC_EN0_R = 1 << 7;
+}
+
+/***********************************************************
+ * ws_encode() – RGB pixels → SSI bytes (GRB order, MSB first)
+ ***********************************************************/
+void ws_encode(uint8_t *dst, const rgb_t *src)
+{
+    unsigned int i;
+    uint32_t w;
+
+    for (i = 0; i < WS_PIXELS; i++)
+    {
+        w = ws_lut[src[i].g];
+        *dst++ = (uint8_t)(w >> 16);
+        *dst++ = (uint8_t)(w >> 8);
+        *dst++ = (uint8_t)w;
+
+        w = ws_lut[src[i].r];
+        *dst++ = (uint8_t)(w >> 16);
+        *dst++ = (uint8_t)(w >> 8);
+        *dst++ = (uint8_t)w;
+
+        w = ws_lut[src[i].b];
+        *dst++ = (uint8_t)(w >> 16);
+        *dst++ = (uint8_t)(w >> 8);
+        *dst++ = (uint8_t)w;
+    }
+
+    for (i = 0; i < WS_RESET_BYTES; i++) // Latch: line stays LOW
+        *dst++ = 0;
+}
+
+/***********************************************************
+ * ws_show() – encode pixels[] and queue it for transmission
+ * Encodes into the buffer that is NOT being sent. At most one
+ * frame can wait, so a second call blocks until it starts.
+ ***********************************************************/
+void ws_show(void)
+{
+    while (ws_pending >= 0)
+        ; // Previous frame not started yet
+
+    ws_encode(ws_encoded[ws_fill], pixels);
+
+    __disable_irq();
+    if (ws_busy)
+        ws_pending = ws_fill; // SSI0_Handler starts it
+    else
+        ws_start(ws_fill);
+    __enable_irq();
+
+    ws_fill ^= 1;
+}
+
+/***********************************************************
+ * ws_start() – begin sending one encoded buffer
+ ***********************************************************/
+void ws_start(uint8_t buf)
+{
+    ws_tx_ptr = ws_encoded[buf];
+    ws_tx_left = WS_FRAME_BYTES;
+    ws_busy = 1;
+    ws_dma_next();
+}
+
+/***********************************************************
+ * ws_dma_next() – hand the next block (max 1024 bytes) to uDMA
+ * Basic mode: source increments by byte, destination is the
+ * fixed SSI0 data register. ARBSIZE = 4 matches the SSI TX
+ * FIFO half-empty request.
+ ***********************************************************/
+void ws_dma_next(void)
+{
+    uint32_t n = ws_tx_left;
+
+    if (n > DMA_MAX_ITEMS)
+        n = DMA_MAX_ITEMS;
+
+    dma_table[DMA_CH_SSI0TX].src_end = (uint32_t)(uintptr_t)(ws_tx_ptr + n - 1);
+    dma_table[DMA_CH_SSI0TX].dst_end = (uint32_t)(uintptr_t)&SSI0_DR_R;
+    dma_table[DMA_CH_SSI0TX].ctl = (3u << 30)        // DSTINC: none
+                                   | (0u << 28)      // DSTSIZE: byte
+                                   | (0u << 26)      // SRCINC: byte
+                                   | (0u << 24)      // SRCSIZE: byte
+                                   | (2u << 14)      // ARBSIZE: 4 items
+                                   | ((n - 1) << 4)  // XFERSIZE
+                                   | 0x1;            // XFERMODE: basic
+
+    ws_tx_ptr += n;
+    ws_tx_left -= n;
+
+    UDMA_ENASET_R = 1 << DMA_CH_SSI0TX;
+}
+
+/***********************************************************
+ * SSI0_Handler() – uDMA block done
+ * The SSI FIFO still holds up to 8 bytes (24 us) when this
+ * runs, so re-arming here leaves no gap on the data line.
+ ***********************************************************/
+void SSI0_Handler(void)
+{
+    if ((UDMA_CHIS_R & (1 << DMA_CH_SSI0TX)) == 0)
+        return;
+    UDMA_CHIS_R = 1 << DMA_CH_SSI0TX; // Write 1 to clear
+
+    if (ws_tx_left)
+    {
+        ws_dma_next();
+        return;
+    }
+
+    ws_frames_sent++;
+    ws_busy = 0;
+
+    if (ws_pending >= 0)
+    {
+        ws_start((uint8_t)ws_pending);
+        ws_pending = -1;
+    }
+}
+
+/***********************************************************
+ * SysTick_Handler() – 1 ms time base
+ ***********************************************************/
+void SysTick_Handler(void)
+{
+    ms_ticks++;
+}
+
+/***********************************************************
+ * wheel() – colour wheel, 0..255 → red → green → blue → red
+ * Brightness is kept at 1/4 to limit the strip current.
+ ***********************************************************/
+rgb_t wheel(uint8_t pos)
+{
+    rgb_t c;
+
+    if (pos < 85)
+    {
+        c.r = (uint8_t)((255 - pos * 3) >> 2);
+        c.g = (uint8_t)((pos * 3) >> 2);
+        c.b = 0;
+    }
+    else if (pos < 170)
+    {
+        pos -= 85;
+        c.r = 0;
+        c.g = (uint8_t)((255 - pos * 3) >> 2);
+        c.b = (uint8_t)((pos * 3) >> 2);
+    }
+    else
+    {
+        pos -= 170;
+        c.r = (uint8_t)((pos * 3) >> 2);
+        c.g = 0;
+        c.b = (uint8_t)((255 - pos * 3) >> 2);
+    }
+
+    return c;
+}
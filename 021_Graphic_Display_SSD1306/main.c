@@ -0,0 +1,760 @@
+/***************************************************************
+ * PROJECT NAME : SSD1306 Graphic Display with Dirty-Tile Flush
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - SSI0 (PA2 = SCK, PA3 = CS, PA5 = MOSI) at 8 MHz
+ *      - PA6 = D/C, PA7 = RESET of the 128x64 SSD1306 OLED
+ *      - uDMA channel 11 (SSI0 TX)
+ *      - ADC0 SS0 on AIN4 (PD3, potentiometer), Timer0A trigger
+ *      - SysTick (1 ms time base)
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * The 16x2 LCD of 004_LCD can only show text. This program
+ * keeps a full 1 bit-per-pixel framebuffer in SRAM and draws a
+ * live strip chart of the potentiometer on a 128x64 OLED.
+ *
+ * Framebuffer layout = SSD1306 memory layout:
+ *      fb[page][x], page = y / 8, bit (y % 8) of the byte
+ * so any range of bytes can be sent to the display unchanged.
+ *
+ * Dirty tiles:
+ *   The screen is split into 8x8 pixel tiles (16 per page).
+ *   tile_dirty[page] has one bit per tile. fb_put() only marks
+ *   a tile when the byte really changes, so redrawing the same
+ *   text costs no bus time at all.
+ *
+ * Flush (gfx_flush):
+ *   The dirty map is copied and cleared, then every run of
+ *   neighbouring dirty tiles in a page is sent as ONE window:
+ *      commands 0x21 (columns) + 0x22 (page) with D/C = 0
+ *      run bytes by uDMA with D/C = 1
+ *   The next run is started from SSI0_Handler when the uDMA
+ *   block completes. D/C may only change once the SSI is idle,
+ *   so the handler does not poll BSY: the SSI runs in EOT mode,
+ *   where TXRIS means "FIFO empty and last bit sent", and each
+ *   step of a run is one short interrupt:
+ *      uDMA done → TX idle: D/C = 0, 6 window commands
+ *               → TX idle: D/C = 1, start uDMA
+ *   Drawing may continue during a flush; a tile touched
+ *   meanwhile is simply dirty again for the next one.
+ *
+ * Strip chart:
+ *   Timer0A triggers the ADC at 1 kHz and the ISR keeps the
+ *   min / max since the last frame. Every frame draws one new
+ *   column (min..max) and clears a 4-pixel erase bar in front
+ *   of it, like a sweeping oscilloscope. Only 1 - 2 tile
+ *   columns change per frame instead of the whole screen.
+ *
+ *   Row 0 shows the ADC value, frames per second and the bytes
+ *   sent by the last flush.
+ *
+ * NOTE :
+ * Full screen = 1024 bytes = 1 ms at 8 MHz; a strip chart frame
+ * is typically 6 tiles = 48 bytes. The display runs at 50 FPS
+ * here (limited by FRAME_MS, not by the bus).
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+/***********************************************************
+ * DISPLAY GEOMETRY
+ ***********************************************************/
+#define LCD_W 128
+#define LCD_H 64
+#define LCD_PAGES (LCD_H / 8)
+#define TILE_W 8 // tile = 8 columns x 1 page
+#define TILES_X (LCD_W / TILE_W)
+
+#define CHART_TOP 16 // pages 2..7
+#define CHART_BOTTOM (LCD_H - 1)
+#define ERASE_BAR 4
+
+#define FRAME_MS 20
+
+#define DMA_CH_SSI0TX 11
+
+uint8_t fb[LCD_PAGES][LCD_W];   // framebuffer
+uint16_t tile_dirty[LCD_PAGES]; // written by drawing code (main)
+uint16_t tile_flush[LCD_PAGES]; // snapshot being flushed (SSI0_Handler)
+
+volatile uint8_t flush_busy;
+uint8_t flush_page;             // page the flush is in
+volatile uint32_t flush_bytes;  // data bytes in the current flush
+uint8_t flush_cmd[6];           // window of the next run
+uint8_t flush_data;             // 0: commands next, 1: data next
+const uint8_t *flush_src;       // run bytes in fb[][]
+unsigned int flush_n;
+
+/***********************************************************
+ * uDMA CONTROL TABLE (must be 1024-byte aligned)
+ ***********************************************************/
+typedef struct
+{
+    volatile uint32_t src_end;
+    volatile uint32_t dst_end;
+    volatile uint32_t ctl;
+    uint32_t unused;
+} dma_entry_t;
+
+dma_entry_t dma_table[32] __attribute__((aligned(1024)));
+
+/***********************************************************
+ * 5x7 FONT, ASCII 0x20 - 0x7E, one byte per column (bit 0 = top)
+ ***********************************************************/
+static const uint8_t font5x7[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, // ' ' !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14}, // " #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, // $ %
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, // & '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00}, // ( )
+    {0x14, 0x08, 0x3E, 0x08, 0x14}, {0x08, 0x08, 0x3E, 0x08, 0x08}, // * +
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, // , -
+    {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02}, // . /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, // 0 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, // 2 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, // 4 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03}, // 6 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, // 8 9
+    {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00}, // : ;
+    {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14}, // < =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, // > ?
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, {0x7E, 0x11, 0x11, 0x11, 0x7E}, // @ A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22}, // B C
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, // D E
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x49, 0x49, 0x7A}, // F G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, // H I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, // J K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x0C, 0x02, 0x7F}, // L M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E}, // N O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, // P Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31}, // R S
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, // T U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, // V W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x07, 0x08, 0x70, 0x08, 0x07}, // X Y
+    {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00}, // Z [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, // \ ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40}, // ^ _
+    {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78}, // ` a
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, // b c
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18}, // d e
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E}, // f g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, // h i
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00}, // j k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78}, // l m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, // n o
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7C}, // p q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20}, // r s
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, // t u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C}, // v w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C}, // x y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, // z {
+    {0x00, 0x00, 0x7F, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, // | }
+    {0x10, 0x08, 0x08, 0x10, 0x08},                                 // ~
+};
+
+/***********************************************************
+ * ADC MIN / MAX SINCE LAST FRAME (written by ADC0SS0_Handler)
+ ***********************************************************/
+volatile uint16_t adc_min = 0xFFFF, adc_max, adc_last;
+volatile uint32_t ms_ticks; // incremented by SysTick
+
+// Function prototypes
+void ssd1306_init(void);
+void ssd1306_commands(const uint8_t *cmd, unsigned int n);
+void delayMs(int n);
+void fb_put(unsigned int page, unsigned int x, uint8_t mask, uint8_t bits);
+void gfx_clear(void);
+void gfx_pixel(int x, int y, int on);
+void gfx_hline(int x0, int x1, int y, int on);
+void gfx_vline(int x, int y0, int y1, int on);
+void gfx_line(int x0, int y0, int x1, int y1, int on);
+void gfx_rect(int x0, int y0, int x1, int y1, int on);
+void gfx_fill_rect(int x0, int y0, int x1, int y1, int on);
+void gfx_char(int x, int y, char c);
+void gfx_text(int x, int y, const char *s);
+int gfx_flush(void);
+void flush_next_run(void);
+void flush_tx_idle(void);
+char *fmt_number(char *p, uint32_t n, int width);
+int adc_to_y(uint32_t v);
+
+int main(void)
+{
+    uint32_t last_frame = 0, last_second = 0;
+    uint32_t frames = 0, fps = 0, sent = 0;
+    uint16_t lo, hi;
+    int x = 0, y_lo, y_hi, i;
+    char text[22], *p;
+
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO A (SSI0, D/C, RESET), D (ADC), SSI0, uDMA, ADC0, Timer0
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x09;  // Port A, D
+    SYSCTL_RCGCSSI_R |= 0x01;   // SSI0
+    SYSCTL_RCGCDMA_R |= 0x01;   // uDMA
+    SYSCTL_RCGCADC_R |= 0x01;   // ADC0
+    SYSCTL_RCGCTIMER_R |= 0x01; // Timer0
+    while ((SYSCTL_PRGPIO_R & 0x09) != 0x09)
+        ;
+
+    /***********************************************************
+     * STEP 2: SysTick 1 ms
+     ***********************************************************/
+    NVIC_ST_CTRL_R = 0;
+    NVIC_ST_RELOAD_R = 16000 - 1;
+    NVIC_ST_CURRENT_R = 0;
+    NVIC_ST_CTRL_R = 0x07; // core clock, interrupt, enable
+
+    /***********************************************************
+     * STEP 3: SSI0 – SPI mode 0, 8-bit, 16 MHz / 2 = 8 MHz
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x2C; // PA2, PA3, PA5
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0x00F0FF00) | 0x00202200;
+    GPIO_PORTA_DIR_R |= 0xC0;   // PA6 = D/C, PA7 = RESET
+    GPIO_PORTA_DEN_R |= 0xEC;
+
+    SSI0_CR1_R = 0x00;    // Disable, master mode
+    SSI0_CC_R = 0x00;     // System clock
+    SSI0_CPSR_R = 2;      // CPSDVSR = 2
+    SSI0_CR0_R = 0x07;    // SCR = 0, SPO = SPH = 0, Freescale, 8-bit
+    SSI0_DMACTL_R = 0x02; // TXDMAE
+    SSI0_CR1_R = 0x10;    // EOT: TXRIS = transmit finished
+    SSI0_CR1_R = 0x12;    // EOT + SSE
+
+    /***********************************************************
+     * STEP 4: uDMA channel 11 = SSI0 TX, completion on IRQ 7
+     ***********************************************************/
+    UDMA_CFG_R = 0x01; // MASTEN
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)dma_table;
+    UDMA_CHMAP1_R &= ~0x0000F000;
+    UDMA_ALTCLR_R = 1 << DMA_CH_SSI0TX;
+    UDMA_USEBURSTCLR_R = 1 << DMA_CH_SSI0TX;
+    UDMA_REQMASKCLR_R = 1 << DMA_CH_SSI0TX;
+
+    /***********************************************************
+     * STEP 5: ADC0 SS0 on AIN4 (PD3), triggered by Timer0A at 1 kHz
+     ***********************************************************/
+    GPIO_PORTD_AFSEL_R |= 0x08;
+    GPIO_PORTD_DEN_R &= ~0x08;
+    GPIO_PORTD_AMSEL_R |= 0x08;
+
+    ADC0_ACTSS_R &= ~0x01;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0x000F) | 0x0005; // SS0 trigger = timer
+    ADC0_SSMUX0_R = 0x04;
+    ADC0_SSCTL0_R = 0x06; // END0, IE0
+    ADC0_IM_R |= 0x01;
+    ADC0_ACTSS_R |= 0x01;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;        // 32-bit
+    TIMER0_TAMR_R = 0x02;       // Periodic
+    TIMER0_TAILR_R = 16000 - 1; // 1 kHz at 16 MHz
+    TIMER0_CTL_R = 0x21;        // TAOTE (ADC trigger) + TAEN
+
+    // IRQ 7 = SSI0 (uDMA done, TX idle), IRQ 14 = ADC0 SS0
+    NVIC_EN0_R = (1 << 7) | (1 << 14);
+    __enable_irq();
+
+    /***********************************************************
+     * STEP 6: Display init and static screen
+     ***********************************************************/
+    ssd1306_init();
+
+    gfx_clear();
+    gfx_line(0, CHART_TOP - 2, LCD_W - 1, CHART_TOP - 2, 1); // separator
+    gfx_flush();
+
+    /***********************************************************
+     * STEP 7: Main loop – one chart column + status per frame
+     ***********************************************************/
+    while (1)
+    {
+        if ((ms_ticks - last_frame) < FRAME_MS)
+            continue;
+        last_frame = ms_ticks;
+
+        // Take the min / max collected since the last frame
+        __disable_irq();
+        lo = adc_min;
+        hi = adc_max;
+        adc_min = 0xFFFF;
+        adc_max = 0;
+        __enable_irq();
+
+        if (lo > hi) // No sample yet
+            lo = hi = adc_last;
+
+        // Erase bar in front of the cursor, then the new column
+        for (i = 1; i <= ERASE_BAR; i++)
+            gfx_vline((x + i) % LCD_W, CHART_TOP, CHART_BOTTOM, 0);
+
+        y_lo = adc_to_y(lo);
+        y_hi = adc_to_y(hi);
+        gfx_vline(x, CHART_TOP, CHART_BOTTOM, 0);
+        gfx_vline(x, y_hi, y_lo, 1);
+        x = (x + 1) % LCD_W;
+
+        // Status row: "ADC 1234 F 50 B  48"
+        p = text;
+        *p++ = 'A';
+        *p++ = 'D';
+        *p++ = 'C';
+        *p++ = ' ';
+        p = fmt_number(p, adc_last, 4);
+        *p++ = ' ';
+        *p++ = 'F';
+        p = fmt_number(p, fps, 3);
+        *p++ = ' ';
+        *p++ = 'B';
+        p = fmt_number(p, sent, 5);
+        *p = 0;
+        gfx_text(0, 0, text);
+
+        if (flush_busy == 0)
+            sent = flush_bytes;
+        gfx_flush(); // Returns at once if the last flush is running
+        frames++;
+
+        if ((ms_ticks - last_second) >= 1000)
+        {
+            last_second += 1000;
+            fps = frames;
+            frames = 0;
+        }
+    }
+}
+
+/***********************************************************
+ * FRAMEBUFFER PRIMITIVES
+ * fb_put() is the only function that writes fb[][]; it marks
+ * the tile dirty only when the byte actually changes.
+ ***********************************************************/
+void fb_put(unsigned int page, unsigned int x, uint8_t mask, uint8_t bits)
+{
+    uint8_t old = fb[page][x];
+    uint8_t val = (uint8_t)((old & ~mask) | (bits & mask));
+
+    if (val != old)
+    {
+        fb[page][x] = val;
+        tile_dirty[page] |= (uint16_t)(1u << (x / TILE_W));
+    }
+}
+
+void gfx_clear(void)
+{
+    unsigned int page, x;
+
+    for (page = 0; page < LCD_PAGES; page++)
+    {
+        for (x = 0; x < LCD_W; x++)
+            fb[page][x] = 0;
+        tile_dirty[page] = 0xFFFF;
+    }
+}
+
+void gfx_pixel(int x, int y, int on)
+{
+    if (x < 0 || x >= LCD_W || y < 0 || y >= LCD_H)
+        return;
+
+    fb_put(y >> 3, x, (uint8_t)(1u << (y & 7)), on ? 0xFF : 0x00);
+}
+
+/* One byte per column: the whole line is LCD_W stores at most */
+void gfx_hline(int x0, int x1, int y, int on)
+{
+    int t;
+
+    if (x0 > x1)
+    {
+        t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    if (y < 0 || y >= LCD_H || x1 < 0 || x0 >= LCD_W)
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 >= LCD_W)
+        x1 = LCD_W - 1;
+
+    for (t = x0; t <= x1; t++)
+        fb_put(y >> 3, t, (uint8_t)(1u << (y & 7)), on ? 0xFF : 0x00);
+}
+
+/* One byte per page: a full-height line is 8 stores */
+void gfx_vline(int x, int y0, int y1, int on)
+{
+    int t, page, last;
+    uint8_t mask;
+
+    if (y0 > y1)
+    {
+        t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    if (x < 0 || x >= LCD_W || y1 < 0 || y0 >= LCD_H)
+        return;
+    if (y0 < 0)
+        y0 = 0;
+    if (y1 >= LCD_H)
+        y1 = LCD_H - 1;
+
+    last = y1 >> 3;
+    for (page = y0 >> 3; page <= last; page++)
+    {
+        mask = 0xFF;
+        if (page == (y0 >> 3))
+            mask &= (uint8_t)(0xFF << (y0 & 7));
+        if (page == last)
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+        fb_put(page, x, mask, on ? 0xFF : 0x00);
+    }
+}
+
+/* Bresenham; straight lines use the byte-wide paths above */
+void gfx_line(int x0, int y0, int x1, int y1, int on)
+{
+    int dx, dy, sx, sy, err, e2;
+
+    if (y0 == y1)
+    {
+        gfx_hline(x0, x1, y0, on);
+        return;
+    }
+    if (x0 == x1)
+    {
+        gfx_vline(x0, y0, y1, on);
+        return;
+    }
+
+    dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    dy = y1 > y0 ? y0 - y1 : y1 - y0; // negative
+    sx = x0 < x1 ? 1 : -1;
+    sy = y0 < y1 ? 1 : -1;
+    err = dx + dy;
+
+    while (1)
+    {
+        gfx_pixel(x0, y0, on);
+        if (x0 == x1 && y0 == y1)
+            break;
+        e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void gfx_rect(int x0, int y0, int x1, int y1, int on)
+{
+    gfx_hline(x0, x1, y0, on);
+    gfx_hline(x0, x1, y1, on);
+    gfx_vline(x0, y0, y1, on);
+    gfx_vline(x1, y0, y1, on);
+}
+
+void gfx_fill_rect(int x0, int y0, int x1, int y1, int on)
+{
+    int t;
+
+    if (x0 > x1)
+    {
+        t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    for (t = x0; t <= x1; t++)
+        gfx_vline(t, y0, y1, on);
+}
+
+/***********************************************************
+ * gfx_char() – 5x7 glyph plus one blank column, any y
+ * A glyph column covers at most two pages: the part shifted
+ * into the upper page and the rest into the page below.
+ ***********************************************************/
+void gfx_char(int x, int y, char c)
+{
+    int col, page = y >> 3, shift = y & 7;
+    uint8_t bits;
+
+    if (c < 0x20 || c > 0x7E)
+        c = '?';
+
+    for (col = 0; col < 6; col++, x++)
+    {
+        if (x < 0 || x >= LCD_W)
+            continue;
+
+        bits = col < 5 ? font5x7[c - 0x20][col] : 0x00;
+
+        if (page >= 0 && page < LCD_PAGES)
+            fb_put(page, x, (uint8_t)(0xFF << shift), (uint8_t)(bits << shift));
+        if (shift && page + 1 < LCD_PAGES)
+            fb_put(page + 1, x, (uint8_t)(0xFF >> (8 - shift)), (uint8_t)(bits >> (8 - shift)));
+    }
+}
+
+void gfx_text(int x, int y, const char *s)
+{
+    while (*s)
+    {
+        gfx_char(x, y, *s++);
+        x += 6;
+    }
+}
+
+/***********************************************************
+ * gfx_flush() – start sending all dirty tiles
+ * Returns 0 if a flush is still running (try next frame).
+ ***********************************************************/
+int gfx_flush(void)
+{
+    unsigned int page;
+
+    if (flush_busy)
+        return 0;
+
+    for (page = 0; page < LCD_PAGES; page++)
+    {
+        tile_flush[page] = tile_dirty[page];
+        tile_dirty[page] = 0;
+    }
+
+    flush_page = 0;
+    flush_bytes = 0;
+    flush_busy = 1;
+
+    __disable_irq();
+    flush_next_run();
+    __enable_irq();
+    return 1;
+}
+
+/***********************************************************
+ * flush_next_run() – find the next dirty run and wait for the
+ * SSI to go idle (TXIM); flush_tx_idle() sends it.
+ * Runs from gfx_flush() and from SSI0_Handler.
+ ***********************************************************/
+void flush_next_run(void)
+{
+    uint16_t bits;
+    unsigned int first, last;
+
+    while (flush_page < LCD_PAGES && tile_flush[flush_page] == 0)
+        flush_page++;
+
+    if (flush_page == LCD_PAGES)
+    {
+        flush_busy = 0;
+        return;
+    }
+
+    // Lowest run of set bits in this page
+    bits = tile_flush[flush_page];
+    first = 0;
+    while ((bits & (1u << first)) == 0)
+        first++;
+    last = first;
+    while (last + 1 < TILES_X && (bits & (1u << (last + 1))))
+        last++;
+    tile_flush[flush_page] &= (uint16_t)~(((1u << (last + 1)) - 1) & ~((1u << first) - 1));
+
+    flush_cmd[0] = 0x21; // Column address
+    flush_cmd[1] = (uint8_t)(first * TILE_W);
+    flush_cmd[2] = (uint8_t)(last * TILE_W + TILE_W - 1);
+    flush_cmd[3] = 0x22; // Page address
+    flush_cmd[4] = flush_page;
+    flush_cmd[5] = flush_page;
+
+    flush_src = &fb[flush_page][first * TILE_W];
+    flush_n = (last - first + 1) * TILE_W;
+    flush_bytes += flush_n;
+
+    flush_data = 0;
+    SSI0_IM_R |= 0x08; // TXIM: interrupt when the SSI is idle
+}
+
+/***********************************************************
+ * flush_tx_idle() – SSI idle: the window commands, or the run
+ * itself. The 6 commands fit in the 8-byte TX FIFO.
+ ***********************************************************/
+void flush_tx_idle(void)
+{
+    unsigned int i;
+
+    if (flush_data == 0)
+    {
+        GPIO_PORTA_DATA_R &= ~0x40; // D/C = command
+        for (i = 0; i < 6; i++)
+            SSI0_DR_R = flush_cmd[i];
+        flush_data = 1; // TXRIS returns when they are sent
+        return;
+    }
+
+    SSI0_IM_R &= ~0x08;
+    GPIO_PORTA_DATA_R |= 0x40; // D/C = data
+
+    dma_table[DMA_CH_SSI0TX].src_end = (uint32_t)(uintptr_t)(flush_src + flush_n - 1);
+    dma_table[DMA_CH_SSI0TX].dst_end = (uint32_t)(uintptr_t)&SSI0_DR_R;
+    dma_table[DMA_CH_SSI0TX].ctl = (3u << 30)             // DSTINC: none
+                                   | (0u << 28)           // DSTSIZE: byte
+                                   | (0u << 26)           // SRCINC: byte
+                                   | (0u << 24)           // SRCSIZE: byte
+                                   | (2u << 14)           // ARBSIZE: 4
+                                   | ((flush_n - 1) << 4) // XFERSIZE
+                                   | 0x1;                 // Basic mode
+    UDMA_ENASET_R = 1 << DMA_CH_SSI0TX;
+}
+
+/***********************************************************
+ * SSI0_Handler() – uDMA run finished or SSI TX idle
+ * Both arrive on the SSI0 vector.
+ ***********************************************************/
+void SSI0_Handler(void)
+{
+    if (UDMA_CHIS_R & (1 << DMA_CH_SSI0TX))
+    {
+        UDMA_CHIS_R = 1 << DMA_CH_SSI0TX;
+        flush_next_run();
+    }
+
+    // TXRIS stays set while idle; it is masked once the run starts
+    if (SSI0_MIS_R & 0x08)
+        flush_tx_idle();
+}
+
+/***********************************************************
+ * ssd1306_commands() – send bytes with D/C = 0 (init only)
+ * D/C may only change when the SSI has shifted out everything
+ * (SR bit 4 = BSY), otherwise the last data bytes would be
+ * taken as commands. Polls BSY, so never call it from an ISR.
+ ***********************************************************/
+void ssd1306_commands(const uint8_t *cmd, unsigned int n)
+{
+    while (SSI0_SR_R & 0x10)
+        ; // Wait until not busy
+
+    GPIO_PORTA_DATA_R &= ~0x40; // D/C = command
+
+    while (n--)
+    {
+        while ((SSI0_SR_R & 0x02) == 0)
+            ; // Wait until TX FIFO not full
+        SSI0_DR_R = *cmd++;
+    }
+
+    while (SSI0_SR_R & 0x10)
+        ;
+
+    GPIO_PORTA_DATA_R |= 0x40; // D/C = data
+}
+
+/***********************************************************
+ * ssd1306_init() – reset pulse and power-up sequence
+ * Horizontal addressing, so a column/page window is filled
+ * left to right by consecutive data bytes.
+ ***********************************************************/
+void ssd1306_init(void)
+{
+    static const uint8_t init_cmds[] = {
+        0xAE,       // Display off
+        0xD5, 0x80, // Clock divide
+        0xA8, 0x3F, // Multiplex = 64
+        0xD3, 0x00, // Display offset 0
+        0x40,       // Start line 0
+        0x8D, 0x14, // Charge pump on
+        0x20, 0x00, // Horizontal addressing
+        0xA1,       // Segment remap
+        0xC8,       // COM scan descending
+        0xDA, 0x12, // COM pins
+        0x81, 0xCF, // Contrast
+        0xD9, 0xF1, // Pre-charge
+        0xDB, 0x40, // VCOMH
+        0xA4,       // Display from RAM
+        0xA6,       // Normal (not inverted)
+        0xAF,       // Display on
+    };
+
+    GPIO_PORTA_DATA_R &= ~0x80; // RESET low
+    delayMs(10);
+    GPIO_PORTA_DATA_R |= 0x80; // RESET high
+    delayMs(10);
+
+    ssd1306_commands(init_cmds, sizeof(init_cmds));
+}
+
+/***********************************************************
+ * ADC0SS0_Handler() – keep min / max for the chart column
+ ***********************************************************/
+void ADC0SS0_Handler(void)
+{
+    uint16_t value = (uint16_t)ADC0_SSFIFO0_R;
+
+    ADC0_ISC_R = 0x01;
+
+    adc_last = value;
+    if (value < adc_min)
+        adc_min = value;
+    if (value > adc_max)
+        adc_max = value;
+}
+
+/***********************************************************
+ * SysTick_Handler() – 1 ms time base
+ ***********************************************************/
+void SysTick_Handler(void)
+{
+    ms_ticks++;
+}
+
+/***********************************************************
+ * adc_to_y() – 0..4095 → chart row (4095 at the top)
+ ***********************************************************/
+int adc_to_y(uint32_t v)
+{
+    return CHART_BOTTOM - (int)(v * (CHART_BOTTOM - CHART_TOP) / 4095);
+}
+
+/***********************************************************
+ * fmt_number() – right-aligned decimal, returns end pointer
+ ***********************************************************/
+char *fmt_number(char *p, uint32_t n, int width)
+{
+    int i;
+
+    for (i = width - 1; i >= 0; i--)
+    {
+        p[i] = (n || i == width - 1) ? (char)('0' + n % 10) : ' ';
+        n /= 10;
+    }
+
+    return p + width;
+}
+
+/***********************************************************
+ * delayMs() – SysTick based delay
+ ***********************************************************/
+void delayMs(int n)
+{
+    uint32_t start = ms_ticks;
+
+    while ((ms_ticks - start) < (uint32_t)n)
+        ;
+}
@@ -0,0 +1,332 @@
+/***************************************************************
+ * PROJECT NAME : I/O Expander – 74HC165 Inputs + 74HC595 Outputs
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - SSI2 full duplex (PB4 = SCK, PB6 = MISO, PB7 = MOSI)
+ *      - PB5 = LATCH (595 STCP and 165 SH/LD, one pin)
+ *      - Timer1A (1 kHz refresh)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * 003 and 004 bit-bang the 74HC595, which can only drive
+ * outputs. Here two 595s (16 outputs) and two 74HC165s (16
+ * inputs) share ONE SPI bus, and every refresh is a single
+ * 16-bit full-duplex SSI frame:
+ *
+ *      MOSI → 595 DS      (output bits go out)
+ *      MISO ← 165 QH      (input bits come in, same clocks)
+ *      SCK  → 595 SHCP + 165 CLK
+ *      LATCH→ 595 STCP + 165 SH/LD
+ *
+ * One LATCH pulse (LOW → HIGH) does two jobs:
+ *      LOW  : 165 loads its parallel inputs
+ *      HIGH : rising edge copies the shifted bits to the 595
+ *             outputs, and the 165 is back in shift mode
+ *
+ * Timer1A_Handler (1 kHz) pipeline, no busy waiting:
+ *      1. read SSI RX → inputs loaded by the LAST latch pulse
+ *      2. LATCH pulse  → outputs of the LAST frame appear,
+ *                        inputs are sampled for the next frame
+ *      3. write SSI TX → start the next 16-bit frame
+ * Outputs and inputs are therefore at most 1 ms old, and the
+ * input snapshot costs nothing extra.
+ *
+ * Debounced button engine:
+ *   Every DEBOUNCE_DIV refreshes (5 ms) the snapshot goes into a
+ *   2-bit vertical counter: all 16 inputs are debounced at once
+ *   with a few logic operations. A change must be stable for 4
+ *   samples (20 ms). Each debounced edge becomes an input event:
+ *
+ *      typedef struct { source, code, type, time } input_event_t
+ *
+ *   in a power-of-two queue read with input_get(). The same
+ *   event format is used by the other input drivers (keypad).
+ *
+ * Demo: each button toggles the LED on the same output bit and
+ * every event is printed on UART0, e.g. "IOX 3 press @1234".
+ *
+ * NOTE :
+ * Buttons connect the 165 inputs to GND (10k pull-ups), so a
+ * pressed button reads 0; the driver inverts the snapshot.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define DEBOUNCE_DIV 5 // debounce sample every 5 ms
+
+/***********************************************************
+ * INPUT EVENTS (shared format for all input devices)
+ ***********************************************************/
+enum
+{
+    INPUT_SRC_IOX,    // 74HC165 expander
+    INPUT_SRC_KEYPAD, // 4x4 matrix keypad
+};
+
+enum
+{
+    INPUT_RELEASE,
+    INPUT_PRESS,
+};
+
+typedef struct
+{
+    uint8_t source; // INPUT_SRC_*
+    uint8_t code;   // input bit / key number
+    uint8_t type;   // INPUT_PRESS or INPUT_RELEASE
+    uint8_t reserved;
+    uint32_t time;  // ms timestamp
+} input_event_t;
+
+#define INPUT_QUEUE_SIZE 16 // power of two
+
+input_event_t input_queue[INPUT_QUEUE_SIZE];
+volatile uint32_t input_head, input_tail;
+volatile uint32_t input_dropped;
+
+/***********************************************************
+ * EXPANDER STATE
+ ***********************************************************/
+volatile uint16_t iox_out;      // shadow of the 595 outputs
+volatile uint16_t iox_in;       // last raw input snapshot (1 = pressed)
+volatile uint16_t iox_pressed;  // debounced state
+uint16_t deb_ct0 = 0xFFFF, deb_ct1 = 0xFFFF; // vertical counter
+
+volatile uint32_t ms_ticks; // incremented by Timer1A
+
+// Function prototypes
+void iox_init(void);
+void iox_debounce(uint16_t raw);
+void input_post(uint8_t source, uint8_t code, uint8_t type);
+int input_get(input_event_t *ev);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    input_event_t ev;
+
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO A (UART0), B (SSI2 + LATCH), SSI2, UART0, Timer1
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x03;  // Port A, B
+    SYSCTL_RCGCSSI_R |= 0x04;   // SSI2
+    SYSCTL_RCGCUART_R |= 0x01;  // UART0
+    SYSCTL_RCGCTIMER_R |= 0x02; // Timer1
+    while ((SYSCTL_PRGPIO_R & 0x03) != 0x03)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 16 MHz (IBRD 8, FBRD 44)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70; // 8-bit, FIFO enable
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301; // UARTEN, TXE, RXE
+
+    /***********************************************************
+     * STEP 3: SSI2 + LATCH, Timer1A refresh
+     ***********************************************************/
+    iox_init();
+
+    UART0_SendString("\r\nI/O expander ready\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – consume input events
+     ***********************************************************/
+    while (1)
+    {
+        if (!input_get(&ev))
+            continue;
+
+        if (ev.type == INPUT_PRESS)
+            iox_out ^= (uint16_t)(1u << ev.code); // Toggle matching LED
+
+        UART0_SendString("IOX ");
+        UART0_SendNumber(ev.code);
+        UART0_SendString(ev.type == INPUT_PRESS ? " press @" : " release @");
+        UART0_SendNumber(ev.time);
+        UART0_SendString("\r\n");
+    }
+}
+
+/***********************************************************
+ * iox_init() – SSI2 master, SPI mode 0, 16-bit frames, 4 MHz
+ * Mode 0 samples MISO on the rising SCK edge; the 165 shifts
+ * on that same edge, so the bit read is the one BEFORE the
+ * shift and QH (input H) is the first bit received.
+ ***********************************************************/
+void iox_init(void)
+{
+    // PB4 = SSI2Clk, PB6 = SSI2Rx, PB7 = SSI2Tx, PB5 = GPIO latch
+    GPIO_PORTB_AFSEL_R |= 0xD0;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~0xFF0F0000) | 0x22020000;
+    GPIO_PORTB_DIR_R |= 0x20;
+    GPIO_PORTB_DATA_R |= 0x20; // LATCH idle HIGH (165 in shift mode)
+    GPIO_PORTB_DEN_R |= 0xF0;
+
+    SSI2_CR1_R = 0x00; // Disable, master mode
+    SSI2_CC_R = 0x00;  // System clock
+    SSI2_CPSR_R = 4;   // 16 MHz / 4 = 4 MHz
+    SSI2_CR0_R = 0x0F; // SCR = 0, SPO = SPH = 0, Freescale, 16-bit
+    SSI2_CR1_R = 0x02; // SSE
+
+    SSI2_DR_R = 0; // First frame: clear the outputs
+
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;        // 32-bit
+    TIMER1_TAMR_R = 0x02;       // Periodic
+    TIMER1_TAILR_R = 16000 - 1; // 1 kHz at 16 MHz
+    TIMER1_ICR_R = 0x01;
+    TIMER1_IMR_R = 0x01; // TATOIM
+    TIMER1_CTL_R = 0x01; // TAEN
+
+    NVIC_EN0_R = 1 << 21; // IRQ 21 = Timer1A
+    __enable_irq();
+}
+
+/***********************************************************
+ * TIMER1A_Handler() – one expander refresh (see header)
+ ***********************************************************/
+void TIMER1A_Handler(void)
+{
+    static uint8_t div;
+    uint16_t raw;
+
+    TIMER1_ICR_R = 0x01;
+    ms_ticks++;
+
+    // 1. Inputs shifted in during the last frame
+    if (SSI2_SR_R & 0x04) // RNE: RX FIFO not empty
+    {
+        raw = (uint16_t)~SSI2_DR_R; // Pressed = 0 on the pins
+        iox_in = raw;
+    }
+
+    // 2. Latch pulse: 595 outputs update, 165 loads inputs
+    GPIO_PORTB_DATA_R &= ~0x20;
+    GPIO_PORTB_DATA_R |= 0x20;
+
+    // 3. Next frame
+    SSI2_DR_R = iox_out;
+
+    if (++div >= DEBOUNCE_DIV)
+    {
+        div = 0;
+        iox_debounce(iox_in);
+    }
+}
+
+/***********************************************************
+ * iox_debounce() – 2-bit vertical counter for 16 inputs
+ * ct1:ct0 counts 3, 2, 1, 0 while an input differs from the
+ * debounced state and is reset to 3 as soon as it agrees.
+ * The state toggles when the counter wraps (4 equal samples).
+ ***********************************************************/
+void iox_debounce(uint16_t raw)
+{
+    uint16_t changed, bit;
+    unsigned int i;
+
+    changed = iox_pressed ^ raw;
+    deb_ct0 = (uint16_t)~(deb_ct0 & changed);
+    deb_ct1 = (uint16_t)(deb_ct0 ^ (deb_ct1 & changed));
+    changed &= deb_ct0 & deb_ct1;
+    iox_pressed ^= changed;
+
+    for (i = 0; changed; i++)
+    {
+        bit = (uint16_t)(1u << i);
+        if (changed & bit)
+        {
+            input_post(INPUT_SRC_IOX, (uint8_t)i,
+                       (iox_pressed & bit) ? INPUT_PRESS : INPUT_RELEASE);
+            changed &= (uint16_t)~bit;
+        }
+    }
+}
+
+/***********************************************************
+ * input_post() – add one event (called from ISRs)
+ ***********************************************************/
+void input_post(uint8_t source, uint8_t code, uint8_t type)
+{
+    input_event_t *ev;
+
+    if ((input_head - input_tail) >= INPUT_QUEUE_SIZE)
+    {
+        input_dropped++; // Queue full
+        return;
+    }
+
+    ev = &input_queue[input_head & (INPUT_QUEUE_SIZE - 1)];
+    ev->source = source;
+    ev->code = code;
+    ev->type = type;
+    ev->reserved = 0;
+    ev->time = ms_ticks;
+    input_head++;
+}
+
+/***********************************************************
+ * input_get() – non-blocking read from the event queue
+ * Returns 1 and copies the event to *ev, or 0 if empty.
+ ***********************************************************/
+int input_get(input_event_t *ev)
+{
+    if (input_tail == input_head)
+        return 0;
+
+    *ev = input_queue[input_tail & (INPUT_QUEUE_SIZE - 1)];
+    input_tail++;
+    return 1;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,401 @@
+/***************************************************************
+ * PROJECT NAME : 4x4 Matrix Keypad – Interrupt Wake + Timer Scan
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - Rows    : PE0 - PE3 (open-drain outputs)
+ *      - Columns : PC4 - PC7 (inputs, pull-up, falling-edge IRQ)
+ *      - Timer2A (1 ms scan tick)
+ *      - Timer1A (free-running time stamp, no interrupt)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * The resistive keypad of 011_02 needs one ADC reading per key
+ * press. A standard 4x4 matrix needs 8 GPIOs but is usually
+ * polled all the time. Here the CPU only works while a key is
+ * down:
+ *
+ *   IDLE : all four rows driven LOW, column interrupts enabled,
+ *          Timer2A stopped, main loop sleeps in __WFI().
+ *          Any key pulls its column LOW → GPIOC_Handler.
+ *
+ *   SCAN : GPIOC_Handler masks the column interrupts and starts
+ *          Timer2A. Every 1 ms tick:
+ *              - read the columns of the row driven last tick
+ *              - drive the next row LOW (the others released)
+ *          so the row lines settle for 1 ms and the ISR never
+ *          waits. A full scan of 16 keys takes 4 ms.
+ *
+ *   After each full scan the 16-bit key map goes through the
+ *   same 2-bit vertical counter debounce as the 74HC165 inputs
+ *   (4 equal scans = 16 ms). Every key is debounced on its own,
+ *   so several keys can be held at once (n-key rollover) and
+ *   each press / release becomes one event.
+ *
+ *   When no key has been down for IDLE_SCANS full scans the
+ *   timer stops and the keypad goes back to IDLE.
+ *
+ * Events use the same input_event_t format and queue as
+ * 022_IO_Expander (source = INPUT_SRC_KEYPAD, code = key 0-15).
+ *
+ * Key layout (code → label):
+ *      0  1  2  3      1 2 3 A
+ *      4  5  6  7      4 5 6 B
+ *      8  9 10 11      7 8 9 C
+ *     12 13 14 15      * 0 # D
+ *
+ * NOTE :
+ * Keypads without diodes show "ghost" keys when three keys on
+ * the corners of a rectangle are held; real n-key rollover needs
+ * one diode per key.
+ * PC0 - PC3 are the JTAG pins and are never written here.
+ * Time stamps come from free-running Timer1 so that no periodic
+ * interrupt wakes the CPU; they wrap after 268 s (2^32 / 16 MHz).
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+#define KEY_ROWS 4
+#define IDLE_SCANS 8 // 8 empty scans (32 ms) → back to sleep
+
+/***********************************************************
+ * INPUT EVENTS (same format as 022_IO_Expander)
+ ***********************************************************/
+enum
+{
+    INPUT_SRC_IOX,    // 74HC165 expander
+    INPUT_SRC_KEYPAD, // 4x4 matrix keypad
+};
+
+enum
+{
+    INPUT_RELEASE,
+    INPUT_PRESS,
+};
+
+typedef struct
+{
+    uint8_t source; // INPUT_SRC_*
+    uint8_t code;   // input bit / key number
+    uint8_t type;   // INPUT_PRESS or INPUT_RELEASE
+    uint8_t reserved;
+    uint32_t time;  // ms timestamp
+} input_event_t;
+
+#define INPUT_QUEUE_SIZE 16 // power of two
+
+input_event_t input_queue[INPUT_QUEUE_SIZE];
+volatile uint32_t input_head, input_tail;
+volatile uint32_t input_dropped;
+
+/***********************************************************
+ * SCANNER STATE
+ ***********************************************************/
+static const char key_label[16] = {
+    '1', '2', '3', 'A',
+    '4', '5', '6', 'B',
+    '7', '8', '9', 'C',
+    '*', '0', '#', 'D',
+};
+
+uint8_t scan_row;                  // row driven LOW now
+uint16_t scan_map;                 // keys seen in this scan
+uint8_t idle_scans;                // empty scans in a row
+volatile uint16_t key_down;        // debounced state, bit = key code
+uint16_t deb_ct0 = 0xFFFF, deb_ct1 = 0xFFFF; // vertical counter
+
+volatile uint32_t wakeups, scans;  // statistics
+
+// Function prototypes
+void keypad_init(void);
+uint32_t now_ms(void);
+void keypad_idle(void);
+void keypad_drive_row(uint8_t row);
+void keypad_debounce(uint16_t raw);
+void input_post(uint8_t source, uint8_t code, uint8_t type);
+int input_get(input_event_t *ev);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+
+int main(void)
+{
+    input_event_t ev;
+
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO A (UART0), C (columns), E (rows), UART0, Timer1, Timer2
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x15;  // Port A, C, E
+    SYSCTL_RCGCUART_R |= 0x01;  // UART0
+    SYSCTL_RCGCTIMER_R |= 0x06; // Timer1, Timer2
+    while ((SYSCTL_PRGPIO_R & 0x15) != 0x15)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1 at 16 MHz (IBRD 8, FBRD 44)
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70; // 8-bit, FIFO enable
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301; // UARTEN, TXE, RXE
+
+    /***********************************************************
+     * STEP 3: Keypad pins, Timer2A, interrupts
+     ***********************************************************/
+    keypad_init();
+
+    UART0_SendString("\r\nkeypad ready\r\n");
+
+    /***********************************************************
+     * STEP 4: Main loop – print events, sleep when idle
+     ***********************************************************/
+    while (1)
+    {
+        while (input_get(&ev))
+        {
+            UART0_SendString("KEY ");
+            UART0Tx(key_label[ev.code]);
+            UART0_SendString(ev.type == INPUT_PRESS ? " press @" : " release @");
+            UART0_SendNumber(ev.time);
+            UART0_SendString("\r\n");
+        }
+
+        __WFI(); // Wake on GPIOC / Timer2A interrupt
+    }
+}
+
+/***********************************************************
+ * keypad_init() – rows open-drain, columns pull-up + IRQ
+ ***********************************************************/
+void keypad_init(void)
+{
+    // Rows PE0 - PE3: open-drain, writing 1 releases the row
+    GPIO_PORTE_DIR_R |= 0x0F;
+    GPIO_PORTE_ODR_R |= 0x0F;
+    GPIO_PORTE_DEN_R |= 0x0F;
+
+    // Columns PC4 - PC7: inputs, pull-up, falling edge
+    GPIO_PORTC_DIR_R &= ~0xF0;
+    GPIO_PORTC_PUR_R |= 0xF0;
+    GPIO_PORTC_DEN_R |= 0xF0;
+    GPIO_PORTC_IS_R &= ~0xF0;  // Edge sensitive
+    GPIO_PORTC_IBE_R &= ~0xF0; // One edge
+    GPIO_PORTC_IEV_R &= ~0xF0; // Falling
+
+    // Timer2A: 1 ms periodic, started on wake-up
+    TIMER2_CTL_R = 0x00;
+    TIMER2_CFG_R = 0x00;        // 32-bit
+    TIMER2_TAMR_R = 0x02;       // Periodic
+    TIMER2_TAILR_R = 16000 - 1; // 1 ms at 16 MHz
+    TIMER2_ICR_R = 0x01;
+    TIMER2_IMR_R = 0x01;        // TATOIM
+
+    // Timer1A: free-running 32-bit down counter for time stamps
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;        // 32-bit
+    TIMER1_TAMR_R = 0x02;       // Periodic, count down
+    TIMER1_TAILR_R = 0xFFFFFFFF;
+    TIMER1_CTL_R = 0x01;        // TAEN
+
+    keypad_idle();
+
+    NVIC_EN0_R = (1 << 2) | (1 << 23); // IRQ 2 = GPIOC, IRQ 23 = Timer2A
+    __enable_irq();
+}
+
+/***********************************************************
+ * now_ms() – milliseconds from the free-running Timer1
+ ***********************************************************/
+uint32_t now_ms(void)
+{
+    return (0xFFFFFFFF - TIMER1_TAR_R) / 16000;
+}
+
+/***********************************************************
+ * keypad_idle() – all rows LOW, wait for a column edge
+ ***********************************************************/
+void keypad_idle(void)
+{
+    TIMER2_CTL_R = 0x00;
+    GPIO_PORTE_DATA_R &= ~0x0F; // All rows LOW
+    GPIO_PORTC_ICR_R = 0xF0;    // Forget edges seen while scanning
+    GPIO_PORTC_IM_R |= 0xF0;
+}
+
+/***********************************************************
+ * keypad_drive_row() – only this row LOW
+ ***********************************************************/
+void keypad_drive_row(uint8_t row)
+{
+    GPIO_PORTE_DATA_R = (GPIO_PORTE_DATA_R & ~0x0F) | (0x0F & ~(1u << row));
+}
+
+/***********************************************************
+ * GPIOC_Handler() – key pressed while idle → start scanning
+ ***********************************************************/
+void GPIOC_Handler(void)
+{
+    GPIO_PORTC_IM_R &= ~0xF0; // Scanner takes over
+    GPIO_PORTC_ICR_R = 0xF0;
+    wakeups++;
+
+    scan_row = 0;
+    scan_map = 0;
+    idle_scans = 0;
+    keypad_drive_row(0);
+
+    TIMER2_ICR_R = 0x01;
+    TIMER2_CTL_R = 0x01; // TAEN
+}
+
+/***********************************************************
+ * TIMER2A_Handler() – read one row, drive the next
+ * Column bits PC4 - PC7 are LOW for pressed keys; they become
+ * key codes row * 4 + column.
+ ***********************************************************/
+void TIMER2A_Handler(void)
+{
+    uint32_t cols;
+
+    TIMER2_ICR_R = 0x01;
+
+    cols = (~GPIO_PORTC_DATA_R >> 4) & 0x0F; // 1 = pressed
+    scan_map |= (uint16_t)(cols << (scan_row * 4));
+
+    if (++scan_row < KEY_ROWS)
+    {
+        keypad_drive_row(scan_row);
+        return;
+    }
+
+    // Full scan done
+    scans++;
+    keypad_debounce(scan_map);
+
+    if (scan_map == 0 && key_down == 0)
+    {
+        if (++idle_scans >= IDLE_SCANS)
+        {
+            keypad_idle();
+            return;
+        }
+    }
+    else
+    {
+        idle_scans = 0;
+    }
+
+    scan_row = 0;
+    scan_map = 0;
+    keypad_drive_row(0);
+}
+
+/***********************************************************
+ * keypad_debounce() – 2-bit vertical counter for 16 keys
+ * Same algorithm as iox_debounce() in 022_IO_Expander.
+ ***********************************************************/
+void keypad_debounce(uint16_t raw)
+{
+    uint16_t changed, bit;
+    unsigned int i;
+
+    changed = key_down ^ raw;
+    deb_ct0 = (uint16_t)~(deb_ct0 & changed);
+    deb_ct1 = (uint16_t)(deb_ct0 ^ (deb_ct1 & changed));
+    changed &= deb_ct0 & deb_ct1;
+    key_down ^= changed;
+
+    for (i = 0; changed; i++)
+    {
+        bit = (uint16_t)(1u << i);
+        if (changed & bit)
+        {
+            input_post(INPUT_SRC_KEYPAD, (uint8_t)i,
+                       (key_down & bit) ? INPUT_PRESS : INPUT_RELEASE);
+            changed &= (uint16_t)~bit;
+        }
+    }
+}
+
+/***********************************************************
+ * input_post() – add one event (called from ISRs)
+ ***********************************************************/
+void input_post(uint8_t source, uint8_t code, uint8_t type)
+{
+    input_event_t *ev;
+
+    if ((input_head - input_tail) >= INPUT_QUEUE_SIZE)
+    {
+        input_dropped++; // Queue full
+        return;
+    }
+
+    ev = &input_queue[input_head & (INPUT_QUEUE_SIZE - 1)];
+    ev->source = source;
+    ev->code = code;
+    ev->type = type;
+    ev->reserved = 0;
+    ev->time = now_ms();
+    input_head++;
+}
+
+/***********************************************************
+ * input_get() – non-blocking read from the event queue
+ * Returns 1 and copies the event to *ev, or 0 if empty.
+ ***********************************************************/
+int input_get(input_event_t *ev)
+{
+    if (input_tail == input_head)
+        return 0;
+
+    *ev = input_queue[input_tail & (INPUT_QUEUE_SIZE - 1)];
+    input_tail++;
+    return 1;
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
@@ -0,0 +1,879 @@
+/***************************************************************
+ * PROJECT NAME : Typed Publish / Subscribe Event Bus
+ * MCU          : TM4C123GH6PM (Tiva C LaunchPad)
+ * MODULES USED :
+ *      - ADC0 Sample Sequencer 1 (SS1), Timer0A trigger at 100 Hz
+ *          step 0: PD2 (AIN5) analog HEX keypad (011_02)
+ *          step 1: PD3 (AIN4) potentiometer (011_01)
+ *      - SW1 on PF4 (both edges, GPIOF interrupt)
+ *      - RGB LED on PF1 - PF3
+ *      - Timer1 (free-running time stamp, no interrupt)
+ *      - UART0 (PA0/PA1, ICDI virtual COM port), 115200 8N1
+ *
+ * DESCRIPTION :
+ * ------------------------------------------------------------
+ * The single-purpose demos hand data around in globals such as
+ * Dig_val, result and ADCValue. With ADC, keypad, button, shell
+ * and display in one program every producer would have to know
+ * every consumer. Here they only know topics:
+ *
+ *   Topics (declared once, in BUS_TOPICS):
+ *      adc     adc_msg_t     ADC0SS1_Handler, 100 Hz
+ *      key     key_msg_t     keypad subscriber of "adc"
+ *      button  button_msg_t  GPIOF_Handler, SW1
+ *      shell   shell_msg_t   main loop, one command line
+ *   Each topic gets a typed API from the list, e.g.
+ *      adc_msg_t *m = bus_alloc_ADC();   (0 = pool empty)
+ *      m->pot = ...;
+ *      bus_publish_ADC(m);
+ *   Publishing the wrong type or subscribing a handler with
+ *   the wrong argument type is a compiler warning.
+ *
+ *   Zero copy: a message lives in a block of its topic's pool
+ *   from alloc until the last reference is released. The bus
+ *   queues the block index; every subscriber gets the same
+ *   pointer. A subscriber that wants to keep the message calls
+ *   bus_ref() and later bus_release() (see trend_on_adc).
+ *   The shell even receives its line straight into the block.
+ *
+ *   Dispatch (main loop): one message per pass, always from the
+ *   first non-empty topic in BUS_TOPICS order; its subscribers
+ *   run in priority order (bus_subs[], lower number first).
+ *
+ *   Concurrency: like the counters of 016, every topic has ONE
+ *   publishing context (one ISR or the main loop). The pool's
+ *   free ring and the topic queue are then single-producer /
+ *   single-consumer rings and need no interrupt masking.
+ *
+ * Perf surface (same counters and shell as 016):
+ *   bus_<topic>_pub        messages published
+ *   bus_<topic>_drop       publishes lost, pool empty
+ *   bus_<topic>_delivered  messages dispatched
+ *   bus_<topic>_lat_max    worst publish → dispatch time (us)
+ *   bus_<topic>_lat_sum    sum of those times (us)
+ *
+ *   perf          → print all counters (since the last reset)
+ *   perf diff     → print change since the last "perf diff"
+ *   perf reset    → restart the counters from a baseline, as in
+ *                   016: the live counters keep their one writer.
+ *                   Only lat_max, a maximum that main itself
+ *                   keeps in bus_dispatch(), is cleared.
+ *   perf bus      → per topic: pub, drop, avg / max latency
+ *   adc           → last ADC message (held by trend_on_adc)
+ *
+ * Display: keys and SW1 are echoed on the terminal; red LED =
+ * pot above half scale, blue = SW1 held, green toggles per key.
+ *
+ * AUTHOR :
+ * DATE   : 18/10/2026
+ * DAY    : Sunday
+ ***************************************************************/
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+/***********************************************************
+ * MESSAGE TYPES
+ ***********************************************************/
+typedef struct
+{
+    uint16_t ladder; // keypad resistor ladder, raw
+    uint16_t pot;    // potentiometer, raw
+} adc_msg_t;
+
+typedef struct
+{
+    char key; // '0' - 'F'
+} key_msg_t;
+
+typedef struct
+{
+    uint8_t pressed; // SW1
+} button_msg_t;
+
+typedef struct
+{
+    char line[32];
+    uint8_t len;
+} shell_msg_t;
+
+/***********************************************************
+ * TOPICS: X(ID, "name", message type, pool blocks (2^n))
+ * Order = dispatch priority between topics.
+ ***********************************************************/
+#define BUS_TOPICS(X)                           \
+    X(ADC, "adc", adc_msg_t, 8)                 \
+    X(KEY, "key", key_msg_t, 4)                 \
+    X(BUTTON, "button", button_msg_t, 4)        \
+    X(SHELL, "shell", shell_msg_t, 2)
+
+enum
+{
+#define X(id, name, type, n) BUS_##id,
+    BUS_TOPICS(X)
+#undef X
+    BUS_TOPIC_COUNT
+};
+
+/***********************************************************
+ * PERFORMANCE COUNTER REGISTRY (bus counters first, 5 per topic)
+ ***********************************************************/
+enum
+{
+    BUS_PUB,
+    BUS_DROP,
+    BUS_DELIVERED,
+    BUS_LAT_MAX,
+    BUS_LAT_SUM,
+    BUS_PERF_FIELDS
+};
+
+enum
+{
+#define X(id, name, type, n)                                    \
+    PERF_BUS_##id##_PUB, PERF_BUS_##id##_DROP,                  \
+        PERF_BUS_##id##_DELIVERED, PERF_BUS_##id##_LAT_MAX,     \
+        PERF_BUS_##id##_LAT_SUM,
+    BUS_TOPICS(X)
+#undef X
+    PERF_ISR_ADC0SS1, // ADC0 SS1 interrupts
+    PERF_ISR_GPIOF,   // GPIO Port F interrupts
+    PERF_IDLE_LOOPS,  // main loop passes with nothing to do
+    PERF_COUNT
+};
+
+static const char *const perf_name[PERF_COUNT] = {
+#define X(id, name, type, n)                                    \
+    "bus_" name "_pub", "bus_" name "_drop",                    \
+        "bus_" name "_delivered", "bus_" name "_lat_max",       \
+        "bus_" name "_lat_sum",
+    BUS_TOPICS(X)
+#undef X
+    "isr_adc0ss1",
+    "isr_gpiof",
+    "idle_loops",
+};
+
+volatile uint32_t perf_counter[PERF_COUNT]; // live counters
+uint32_t perf_baseline[PERF_COUNT];         // values at last "perf reset"
+uint32_t perf_snapshot[PERF_COUNT];         // values at last "perf diff"
+
+#define PERF_INC(id) (perf_counter[(id)]++)
+#define PERF_BUS(topic, field) ((topic) * BUS_PERF_FIELDS + (field))
+
+/***********************************************************
+ * POOLS, FREE RINGS AND QUEUES (one set per topic)
+ * A block is a header followed by the message; the message
+ * starts sizeof(bus_hdr_t) bytes in for any type aligned to
+ * 8 bytes or less.
+ ***********************************************************/
+typedef struct
+{
+    uint32_t time;  // Timer1 at publish (16 MHz, counts down)
+    uint8_t topic;
+    uint8_t index;  // block number in the pool
+    uint8_t refs;   // references held (main loop only)
+    uint8_t reserved;
+} bus_hdr_t;
+
+#define X(id, name, type, n)                                    \
+    struct                                                      \
+    {                                                           \
+        bus_hdr_t hdr;                                          \
+        type msg;                                               \
+    } bus_pool_##id[n];                                         \
+    uint8_t bus_free_##id[n], bus_queue_##id[n];                \
+    typedef char bus_pow2_##id[((n) & ((n) - 1)) == 0 ? 1 : -1];
+BUS_TOPICS(X)
+#undef X
+
+typedef struct
+{
+    uint8_t *pool;      // first block
+    uint8_t *free_ring; // free block numbers
+    uint8_t *queue;     // published block numbers
+    uint16_t stride;    // bytes per block
+    uint8_t size;       // blocks, power of two
+    uint8_t first_sub;  // subscribers: bus_order[first_sub ...]
+    uint8_t n_subs;
+    volatile uint32_t free_head, free_tail; // head: main, tail: publisher
+    volatile uint32_t q_head, q_tail;       // head: publisher, tail: main
+} bus_topic_t;
+
+bus_topic_t bus_topic[BUS_TOPIC_COUNT] = {
+#define X(id, name, type, n)                                    \
+    {(uint8_t *)bus_pool_##id, bus_free_##id, bus_queue_##id,   \
+     sizeof(bus_pool_##id[0]), n, 0, 0, 0, 0, 0, 0},
+    BUS_TOPICS(X)
+#undef X
+};
+
+static const char *const bus_name[BUS_TOPIC_COUNT] = {
+#define X(id, name, type, n) name,
+    BUS_TOPICS(X)
+#undef X
+};
+
+void *bus_alloc(uint8_t topic);
+void bus_publish(uint8_t topic, void *msg);
+
+/***********************************************************
+ * TYPED API, generated per topic:
+ *      type *bus_alloc_ID(void);
+ *      void bus_publish_ID(type *msg);
+ *      bus_ID_fn – subscriber type, void fn(const type *)
+ ***********************************************************/
+#define X(id, name, type, n)                                    \
+    static inline type *bus_alloc_##id(void)                    \
+    {                                                           \
+        return (type *)bus_alloc(BUS_##id);                     \
+    }                                                           \
+    static inline void bus_publish_##id(type *msg)              \
+    {                                                           \
+        bus_publish(BUS_##id, msg);                             \
+    }                                                           \
+    typedef void (*bus_##id##_fn)(const type *);
+BUS_TOPICS(X)
+#undef X
+
+/***********************************************************
+ * SUBSCRIBERS: BUS_SUB(topic, priority, handler)
+ * The conditional makes the compiler check the handler's
+ * argument type against the topic.
+ ***********************************************************/
+typedef void (*bus_fn_t)(const void *msg);
+
+typedef struct
+{
+    uint8_t topic;
+    uint8_t prio; // lower runs first
+    bus_fn_t fn;
+} bus_sub_t;
+
+#define BUS_SUB(id, prio, fn) \
+    {BUS_##id, prio, (bus_fn_t)(1 ? (fn) : (bus_##id##_fn)0)}
+
+void keypad_on_adc(const adc_msg_t *m);
+void led_on_adc(const adc_msg_t *m);
+void trend_on_adc(const adc_msg_t *m);
+void term_on_key(const key_msg_t *m);
+void led_on_key(const key_msg_t *m);
+void led_on_button(const button_msg_t *m);
+void term_on_button(const button_msg_t *m);
+void shell_on_line(const shell_msg_t *m);
+
+const bus_sub_t bus_subs[] = {
+    BUS_SUB(ADC, 2, trend_on_adc),
+    BUS_SUB(ADC, 0, keypad_on_adc),
+    BUS_SUB(ADC, 1, led_on_adc),
+    BUS_SUB(KEY, 0, led_on_key),
+    BUS_SUB(KEY, 1, term_on_key),
+    BUS_SUB(BUTTON, 0, led_on_button),
+    BUS_SUB(BUTTON, 1, term_on_button),
+    BUS_SUB(SHELL, 0, shell_on_line),
+};
+
+#define BUS_SUB_COUNT (sizeof(bus_subs) / sizeof(bus_subs[0]))
+
+uint8_t bus_order[BUS_SUB_COUNT]; // bus_subs[] by topic, then priority
+
+/***********************************************************
+ * APPLICATION STATE
+ ***********************************************************/
+char last_key = 'G';         // 'G' = no key (key_scan)
+const adc_msg_t *adc_latest; // held with bus_ref()
+shell_msg_t *rx_line;        // line being received, 0 = none
+
+// Function prototypes
+void bus_init(void);
+int bus_dispatch(void);
+void bus_ref(const void *msg);
+void bus_release(const void *msg);
+bus_hdr_t *bus_hdr(const void *msg);
+uint32_t now_ticks(void);
+unsigned char key_scan(unsigned int volatile rec_val);
+void UART0Tx(char c);
+void UART0_SendString(const char *s);
+void UART0_SendNumber(uint32_t n);
+void perf_print(int diff);
+void perf_bus(void);
+int str_equal(const char *a, const char *b);
+void shell_rx_char(char c);
+
+int main(void)
+{
+    int busy;
+
+    /***********************************************************
+     * STEP 1: Enable clocks
+     * GPIO A (UART0), D (ADC), F (SW1, LEDs)
+     ***********************************************************/
+    SYSCTL_RCGCGPIO_R |= 0x29;  // Port A, D, F
+    SYSCTL_RCGCUART_R |= 0x01;  // UART0
+    SYSCTL_RCGCADC_R |= 0x01;   // ADC0
+    SYSCTL_RCGCTIMER_R |= 0x03; // Timer0, Timer1
+    while ((SYSCTL_PRGPIO_R & 0x29) != 0x29)
+        ;
+
+    /***********************************************************
+     * STEP 2: UART0 – 115200 8N1
+     * IBRD = 16 MHz / (16 x 115200) = 8.680 → 8
+     * FBRD = 0.680 x 64 + 0.5 = 44
+     ***********************************************************/
+    GPIO_PORTA_AFSEL_R |= 0x03;
+    GPIO_PORTA_DEN_R |= 0x03;
+    GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & ~0xFF) | 0x11;
+
+    UART0_CTL_R = 0x00;
+    UART0_IBRD_R = 8;
+    UART0_FBRD_R = 44;
+    UART0_LCRH_R = 0x70;
+    UART0_CC_R = 0x00;
+    UART0_CTL_R = 0x301;
+
+    /***********************************************************
+     * STEP 3: LEDs PF1 - PF3, SW1 on PF4 (both edges)
+     ***********************************************************/
+    GPIO_PORTF_DIR_R = (GPIO_PORTF_DIR_R & ~0x10) | 0x0E;
+    GPIO_PORTF_DEN_R |= 0x1E;
+    GPIO_PORTF_PUR_R |= 0x10;
+    GPIO_PORTF_IS_R &= ~0x10;  // Edge
+    GPIO_PORTF_IBE_R |= 0x10;  // Both edges
+    GPIO_PORTF_ICR_R = 0x10;
+    GPIO_PORTF_IM_R |= 0x10;
+
+    /***********************************************************
+     * STEP 4: ADC0 SS1 – AIN5 (keypad), AIN4 (pot), Timer0A 100 Hz
+     ***********************************************************/
+    GPIO_PORTD_AFSEL_R |= 0x0C;
+    GPIO_PORTD_DEN_R &= ~0x0C;
+    GPIO_PORTD_AMSEL_R |= 0x0C;
+
+    ADC0_ACTSS_R &= ~0x02;
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~0x00F0) | 0x0050; // SS1 trigger = timer
+    ADC0_SSMUX1_R = 0x45;   // Step 0 = AIN5, step 1 = AIN4
+    ADC0_SSCTL1_R = 0x60;   // END1, IE1
+    ADC0_IM_R |= 0x02;
+    ADC0_ACTSS_R |= 0x02;
+
+    TIMER0_CTL_R = 0x00;
+    TIMER0_CFG_R = 0x00;
+    TIMER0_TAMR_R = 0x02;
+    TIMER0_TAILR_R = 160000 - 1; // 100 Hz at 16 MHz
+    TIMER0_CTL_R = 0x21;         // TAOTE (ADC trigger) + TAEN
+
+    // Timer1: free-running time stamps for the latency counters
+    TIMER1_CTL_R = 0x00;
+    TIMER1_CFG_R = 0x00;
+    TIMER1_TAMR_R = 0x02;
+    TIMER1_TAILR_R = 0xFFFFFFFF;
+    TIMER1_CTL_R = 0x01;
+
+    /***********************************************************
+     * STEP 5: Bus, then interrupts (IRQ 15 = ADC0 SS1, 30 = GPIOF)
+     ***********************************************************/
+    bus_init();
+    NVIC_EN0_R = (1 << 15) | (1 << 30);
+    __enable_irq();
+
+    UART0_SendString("\r\nevent bus ready\r\n> ");
+
+    /***********************************************************
+     * STEP 6: Main loop – dispatch, receive shell lines
+     ***********************************************************/
+    while (1)
+    {
+        busy = bus_dispatch();
+
+        if ((UART0_FR_R & 0x10) == 0) // RX FIFO not empty
+        {
+            busy = 1;
+            shell_rx_char((char)UART0_DR_R);
+        }
+
+        if (!busy)
+            PERF_INC(PERF_IDLE_LOOPS);
+    }
+}
+
+/***********************************************************
+ * bus_init() – fill the free rings, order the subscribers
+ ***********************************************************/
+void bus_init(void)
+{
+    uint32_t t, i, j;
+    bus_hdr_t *h;
+    uint8_t s;
+
+    for (t = 0; t < BUS_TOPIC_COUNT; t++)
+    {
+        for (i = 0; i < bus_topic[t].size; i++)
+        {
+            h = (bus_hdr_t *)(bus_topic[t].pool + i * bus_topic[t].stride);
+            h->topic = (uint8_t)t;
+            h->index = (uint8_t)i;
+            h->refs = 0;
+            bus_topic[t].free_ring[i] = (uint8_t)i;
+        }
+        bus_topic[t].free_head = bus_topic[t].size;
+        bus_topic[t].free_tail = 0;
+        bus_topic[t].q_head = bus_topic[t].q_tail = 0;
+        bus_topic[t].n_subs = 0;
+    }
+
+    // Insertion sort by (topic, priority); equal keys keep table order
+    for (i = 0; i < BUS_SUB_COUNT; i++)
+    {
+        s = (uint8_t)i;
+        for (j = i; j > 0; j--)
+        {
+            const bus_sub_t *a = &bus_subs[bus_order[j - 1]];
+            if (a->topic < bus_subs[s].topic ||
+                (a->topic == bus_subs[s].topic && a->prio <= bus_subs[s].prio))
+                break;
+            bus_order[j] = bus_order[j - 1];
+        }
+        bus_order[j] = s;
+    }
+
+    for (i = BUS_SUB_COUNT; i > 0; i--)
+    {
+        t = bus_subs[bus_order[i - 1]].topic;
+        bus_topic[t].first_sub = (uint8_t)(i - 1);
+        bus_topic[t].n_subs++;
+    }
+}
+
+/***********************************************************
+ * bus_alloc() – take a free block (publishing context only)
+ * Returns the message area, or 0 and counts a drop.
+ ***********************************************************/
+void *bus_alloc(uint8_t topic)
+{
+    bus_topic_t *b = &bus_topic[topic];
+    uint8_t i;
+
+    if (b->free_tail == b->free_head)
+    {
+        PERF_INC(PERF_BUS(topic, BUS_DROP));
+        return 0;
+    }
+
+    i = b->free_ring[b->free_tail & (b->size - 1)];
+    b->free_tail++;
+    return b->pool + i * b->stride + sizeof(bus_hdr_t);
+}
+
+/***********************************************************
+ * bus_publish() – queue the block, no copy
+ * The queue has one slot per block, so it cannot overflow.
+ ***********************************************************/
+void bus_publish(uint8_t topic, void *msg)
+{
+    bus_topic_t *b = &bus_topic[topic];
+    bus_hdr_t *h = bus_hdr(msg);
+
+    h->time = now_ticks();
+    b->queue[b->q_head & (b->size - 1)] = h->index;
+    b->q_head++;
+    PERF_INC(PERF_BUS(topic, BUS_PUB));
+}
+
+/***********************************************************
+ * bus_dispatch() – deliver one message (main loop only)
+ * Returns 1 if a message was delivered, 0 if all queues empty.
+ ***********************************************************/
+int bus_dispatch(void)
+{
+    bus_topic_t *b;
+    bus_hdr_t *h;
+    uint32_t t, i, us;
+    const void *msg;
+
+    for (t = 0; t < BUS_TOPIC_COUNT; t++)
+    {
+        b = &bus_topic[t];
+        if (b->q_tail != b->q_head)
+            break;
+    }
+    if (t == BUS_TOPIC_COUNT)
+        return 0;
+
+    i = b->queue[b->q_tail & (b->size - 1)];
+    b->q_tail++;
+    h = (bus_hdr_t *)(b->pool + i * b->stride);
+    msg = (const uint8_t *)h + sizeof(bus_hdr_t);
+
+    us = (h->time - now_ticks()) / 16; // Down counter, 16 MHz
+    if (us > perf_counter[PERF_BUS(t, BUS_LAT_MAX)])
+        perf_counter[PERF_BUS(t, BUS_LAT_MAX)] = us;
+    perf_counter[PERF_BUS(t, BUS_LAT_SUM)] += us;
+    PERF_INC(PERF_BUS(t, BUS_DELIVERED));
+
+    h->refs = 1; // The dispatcher's own reference
+    for (i = 0; i < b->n_subs; i++)
+        bus_subs[bus_order[b->first_sub + i]].fn(msg);
+    bus_release(msg);
+
+    return 1;
+}
+
+/*** bus_hdr() – block header of a message ***/
+bus_hdr_t *bus_hdr(const void *msg)
+{
+    return (bus_hdr_t *)((uintptr_t)msg - sizeof(bus_hdr_t));
+}
+
+/*** bus_ref() – keep a delivered message after the handler returns ***/
+void bus_ref(const void *msg)
+{
+    bus_hdr(msg)->refs++;
+}
+
+/*** bus_release() – drop a reference; the last one frees the block ***/
+void bus_release(const void *msg)
+{
+    bus_hdr_t *h = bus_hdr(msg);
+    bus_topic_t *b = &bus_topic[h->topic];
+
+    if (--h->refs)
+        return;
+    b->free_ring[b->free_head & (b->size - 1)] = h->index;
+    b->free_head++;
+}
+
+/*** now_ticks() – Timer1, free-running down counter ***/
+uint32_t now_ticks(void)
+{
+    return TIMER1_TAR_R;
+}
+
+/***********************************************************
+ * ADC0SS1_Handler() – keypad ladder + pot, publish "adc"
+ ***********************************************************/
+void ADC0SS1_Handler(void)
+{
+    adc_msg_t *m = bus_alloc_ADC();
+    uint16_t ladder = (uint16_t)ADC0_SSFIFO1_R;
+    uint16_t pot = (uint16_t)ADC0_SSFIFO1_R;
+
+    PERF_INC(PERF_ISR_ADC0SS1);
+    ADC0_ISC_R = 0x02;
+
+    if (m) // else: counted as a drop
+    {
+        m->ladder = ladder;
+        m->pot = pot;
+        bus_publish_ADC(m);
+    }
+}
+
+/***********************************************************
+ * GPIOF_Handler() – SW1 changed, publish "button"
+ ***********************************************************/
+void GPIOF_Handler(void)
+{
+    button_msg_t *m = bus_alloc_BUTTON();
+
+    PERF_INC(PERF_ISR_GPIOF);
+    GPIO_PORTF_ICR_R = 0x10;
+
+    if (m)
+    {
+        m->pressed = (GPIO_PORTF_DATA_R & 0x10) == 0; // Active low
+        bus_publish_BUTTON(m);
+    }
+}
+
+/***********************************************************
+ * SUBSCRIBERS
+ ***********************************************************/
+
+/*** keypad_on_adc() – ladder → key, publish "key" on each new press ***/
+void keypad_on_adc(const adc_msg_t *m)
+{
+    char k = (char)key_scan(m->ladder);
+    key_msg_t *out;
+
+    if (k == last_key)
+        return;
+    last_key = k;
+    if (k == 'G') // Released (or noise)
+        return;
+
+    out = bus_alloc_KEY();
+    if (out)
+    {
+        out->key = k;
+        bus_publish_KEY(out);
+    }
+}
+
+/*** led_on_adc() – red LED while the pot is above half scale ***/
+void led_on_adc(const adc_msg_t *m)
+{
+    if (m->pot >= 2048)
+        GPIO_PORTF_DATA_R |= 0x02;
+    else
+        GPIO_PORTF_DATA_R &= ~0x02;
+}
+
+/*** trend_on_adc() – hold the newest ADC message, let the last one go ***/
+void trend_on_adc(const adc_msg_t *m)
+{
+    bus_ref(m);
+    if (adc_latest)
+        bus_release(adc_latest);
+    adc_latest = m;
+}
+
+void led_on_key(const key_msg_t *m)
+{
+    (void)m;
+    GPIO_PORTF_DATA_R ^= 0x08; // Green
+}
+
+void term_on_key(const key_msg_t *m)
+{
+    UART0_SendString("key ");
+    UART0Tx(m->key);
+    UART0_SendString("\r\n");
+}
+
+void led_on_button(const button_msg_t *m)
+{
+    if (m->pressed)
+        GPIO_PORTF_DATA_R |= 0x04; // Blue
+    else
+        GPIO_PORTF_DATA_R &= ~0x04;
+}
+
+void term_on_button(const button_msg_t *m)
+{
+    UART0_SendString(m->pressed ? "sw1 down\r\n" : "sw1 up\r\n");
+}
+
+/***********************************************************
+ * shell_rx_char() – one received character into the line
+ * The line is received straight into a "shell" block, which
+ * is published on CR / LF (zero copy). A block comes back
+ * from the pool with the length of its last line, so it is
+ * cleared on every alloc.
+ ***********************************************************/
+void shell_rx_char(char c)
+{
+    if (!rx_line)
+    {
+        rx_line = bus_alloc_SHELL();
+        if (!rx_line)
+            return; // Both lines still in use: character lost
+        rx_line->len = 0;
+    }
+
+    if (c == '\r' || c == '\n')
+    {
+        UART0_SendString("\r\n");
+        rx_line->line[rx_line->len] = 0;
+        if (rx_line->len)
+        {
+            bus_publish_SHELL(rx_line); // Zero copy: the block itself
+            rx_line = 0;
+        }
+        else
+        {
+            UART0_SendString("> ");
+        }
+    }
+    else if (rx_line->len < sizeof(rx_line->line) - 1)
+    {
+        rx_line->line[rx_line->len++] = c;
+        UART0Tx(c); // Echo
+    }
+}
+
+/***********************************************************
+ * shell_on_line() – decode one command line
+ ***********************************************************/
+void shell_on_line(const shell_msg_t *m)
+{
+    const char *line = m->line;
+    int i;
+
+    if (str_equal(line, "perf"))
+        perf_print(0);
+    else if (str_equal(line, "perf diff"))
+        perf_print(1);
+    else if (str_equal(line, "perf bus"))
+        perf_bus();
+    else if (str_equal(line, "perf reset"))
+    {
+        // Read-only on the live counters: their ISR stays the only writer
+        for (i = 0; i < PERF_COUNT; i++)
+        {
+            perf_baseline[i] = perf_counter[i];
+            perf_snapshot[i] = perf_baseline[i];
+        }
+        for (i = 0; i < BUS_TOPIC_COUNT; i++)
+        {
+            perf_counter[PERF_BUS(i, BUS_LAT_MAX)] = 0; // Written by main only
+            perf_baseline[PERF_BUS(i, BUS_LAT_MAX)] = 0;
+            perf_snapshot[PERF_BUS(i, BUS_LAT_MAX)] = 0;
+        }
+    }
+    else if (str_equal(line, "adc") && adc_latest)
+    {
+        UART0_SendString("ladder ");
+        UART0_SendNumber(adc_latest->ladder);
+        UART0_SendString(" pot ");
+        UART0_SendNumber(adc_latest->pot);
+        UART0_SendString("\r\n");
+    }
+    else
+        UART0_SendString("usage: perf [diff|reset|bus], adc\r\n");
+
+    UART0_SendString("> ");
+}
+
+/***********************************************************
+ * key_scan() – ADC value of the HEX keypad → '0' - 'F'
+ * Same ladder levels as 011_02; 'G' = no key / noise.
+ ***********************************************************/
+unsigned char key_scan(unsigned int volatile rec_val)
+{
+    rec_val = rec_val >> 4; // Scale down ADC value
+
+    if (rec_val == 0xB7 || rec_val == 0xB6)
+        return '0';
+    else if (rec_val == 0xB3 || rec_val == 0xB2)
+        return '1';
+    else if (rec_val == 0xAE || rec_val == 0xAD)
+        return '2';
+    else if (rec_val == 0xAA || rec_val == 0xA9)
+        return '3';
+    else if (rec_val == 0xA6 || rec_val == 0xA7)
+        return '4';
+    else if (rec_val == 0xA0 || rec_val == 0x9F)
+        return '5';
+    else if (rec_val == 0x98 || rec_val == 0x97)
+        return '6';
+    else if (rec_val == 0x92 || rec_val == 0x91)
+        return '7';
+    else if (rec_val == 0x8C || rec_val == 0x8B)
+        return '8';
+    else if (rec_val == 0x81 || rec_val == 0x80)
+        return '9';
+    else if (rec_val == 0x73 || rec_val == 0x72)
+        return 'A';
+    else if (rec_val == 0x66 || rec_val == 0x65)
+        return 'B';
+    else if (rec_val == 0x5A)
+        return 'C';
+    else if (rec_val == 0x41)
+        return 'D';
+    else if (rec_val == 0x20)
+        return 'E';
+    else if (rec_val == 0x00)
+        return 'F';
+
+    return 'G'; // Undefined / noise
+}
+
+/***********************************************************
+ * perf_print() – print counters, or deltas when diff = 1
+ * Each value is copied once so the printout is consistent
+ * even while ISRs keep counting.
+ ***********************************************************/
+void perf_print(int diff)
+{
+    uint32_t now[PERF_COUNT];
+    int i;
+
+    for (i = 0; i < PERF_COUNT; i++)
+        now[i] = perf_counter[i];
+
+    for (i = 0; i < PERF_COUNT; i++)
+    {
+        UART0_SendString(perf_name[i]);
+        UART0_SendString(diff ? " +" : " ");
+        UART0_SendNumber(now[i] - (diff ? perf_snapshot[i] : perf_baseline[i]));
+        UART0_SendString("\r\n");
+    }
+
+    if (diff)
+    {
+        for (i = 0; i < PERF_COUNT; i++)
+            perf_snapshot[i] = now[i];
+    }
+}
+
+/***********************************************************
+ * perf_bus() – one line per topic
+ *      adc pub 1200 drop 0 avg 14 us max 52 us
+ ***********************************************************/
+void perf_bus(void)
+{
+    uint32_t t, n;
+
+#define PERF_SINCE_RESET(t, f) \
+    (perf_counter[PERF_BUS(t, f)] - perf_baseline[PERF_BUS(t, f)])
+
+    for (t = 0; t < BUS_TOPIC_COUNT; t++)
+    {
+        n = PERF_SINCE_RESET(t, BUS_DELIVERED);
+        UART0_SendString(bus_name[t]);
+        UART0_SendString(" pub ");
+        UART0_SendNumber(PERF_SINCE_RESET(t, BUS_PUB));
+        UART0_SendString(" drop ");
+        UART0_SendNumber(PERF_SINCE_RESET(t, BUS_DROP));
+        UART0_SendString(" avg ");
+        UART0_SendNumber(n ? PERF_SINCE_RESET(t, BUS_LAT_SUM) / n : 0);
+        UART0_SendString(" us max ");
+        UART0_SendNumber(perf_counter[PERF_BUS(t, BUS_LAT_MAX)]);
+        UART0_SendString(" us\r\n");
+    }
+}
+
+/***********************************************************
+ * UART0Tx() – blocking transmit of one character
+ ***********************************************************/
+void UART0Tx(char c)
+{
+    while ((UART0_FR_R & 0x20) != 0)
+        ; // Wait until TX FIFO is not full
+
+    UART0_DR_R = c;
+}
+
+void UART0_SendString(const char *s)
+{
+    while (*s)
+        UART0Tx(*s++);
+}
+
+/***********************************************************
+ * UART0_SendNumber() – unsigned decimal without printf
+ ***********************************************************/
+void UART0_SendNumber(uint32_t n)
+{
+    char buf[10];
+    int i = 0;
+
+    do
+    {
+        buf[i++] = '0' + (n % 10);
+        n /= 10;
+    } while (n);
+
+    while (i)
+        UART0Tx(buf[--i]);
+}
+
+int str_equal(const char *a, const char *b)
+{
+    while (*a && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}